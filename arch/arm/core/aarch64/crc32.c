@@ -0,0 +1,44 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief CRC-32 using the ARMv8 CRC32 instructions - ARM64 implementation
+ */
+
+#include <kernel.h>
+
+static inline uint32_t crc32b(uint32_t crc, uint8_t v)
+{
+	__asm__ ("crc32b %w0, %w0, %w1" : "+r" (crc) : "r" (v));
+
+	return crc;
+}
+
+static inline uint32_t crc32x(uint32_t crc, uint64_t v)
+{
+	__asm__ ("crc32x %w0, %w0, %x1" : "+r" (crc) : "r" (v));
+
+	return crc;
+}
+
+uint32_t arch_crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+
+	/* Bytes up to the first 64-bit boundary */
+	for (; (len > 0) && (((uintptr_t)data & 7) != 0); len--) {
+		crc = crc32b(crc, *data++);
+	}
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = crc32x(crc, *(const uint64_t *)data);
+	}
+
+	for (; len > 0; len--) {
+		crc = crc32b(crc, *data++);
+	}
+
+	return ~crc;
+}
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler support - POSIX architecture implementation
+ *
+ * Only one Zephyr thread runs at a time, and interrupts are only raised
+ * when it hands control over to the HW models, so a kernel timer would
+ * only ever sample the idle loop or k_busy_wait().  Instead a host
+ * ITIMER_PROF timer raises SIGPROF as the process consumes host CPU
+ * time, and the program counter is taken from the context of the thread
+ * the signal interrupted.  SIGPROF is blocked while its handler runs, so
+ * samples are never recorded concurrently.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <kernel.h>
+#include <debug/profiler.h>
+
+static uintptr_t context_pc(const ucontext_t *uc)
+{
+#if defined(__x86_64__)
+	return (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__i386__)
+	return (uintptr_t)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__aarch64__)
+	return (uintptr_t)uc->uc_mcontext.pc;
+#else
+	return 0;
+#endif
+}
+
+static void sigprof_handler(int sig, siginfo_t *info, void *context)
+{
+	ARG_UNUSED(sig);
+	ARG_UNUSED(info);
+
+	z_profiler_sample(context_pc(context));
+}
+
+int arch_profiler_start(uint32_t period_us)
+{
+	struct sigaction act;
+	struct itimerval timer;
+
+	memset(&act, 0, sizeof(act));
+	act.sa_sigaction = sigprof_handler;
+	act.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&act.sa_mask);
+
+	if (sigaction(SIGPROF, &act, NULL) != 0) {
+		return -errno;
+	}
+
+	timer.it_interval.tv_sec = period_us / USEC_PER_SEC;
+	timer.it_interval.tv_usec = period_us % USEC_PER_SEC;
+	timer.it_value = timer.it_interval;
+
+	if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+void arch_profiler_stop(void)
+{
+	struct itimerval timer;
+
+	memset(&timer, 0, sizeof(timer));
+	(void)setitimer(ITIMER_PROF, &timer, NULL);
+}
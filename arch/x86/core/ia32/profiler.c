@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler support - IA-32 implementation
+ *
+ * Samples are taken from a kernel timer, whose expiry function runs in
+ * the system clock interrupt.  _interrupt_enter saves the interrupted
+ * stack pointer at the base of the interrupt stack; the frame it points
+ * to holds EDI, ECX, EDX and EAX followed by the EIP pushed by the CPU.
+ *
+ * When the timer interrupt is nested the sample is the program counter
+ * interrupted by the outermost interrupt.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/profiler.h>
+
+#define ESF_EIP_OFFSET 4
+
+static void profiler_timer_expiry(struct k_timer *timer)
+{
+	uint32_t *esp = ((uint32_t **)_kernel.cpus[0].irq_stack)[-1];
+
+	ARG_UNUSED(timer);
+
+	z_profiler_sample((uintptr_t)esp[ESF_EIP_OFFSET]);
+}
+
+static K_TIMER_DEFINE(profiler_timer, profiler_timer_expiry, NULL);
+
+int arch_profiler_start(uint32_t period_us)
+{
+	k_timer_start(&profiler_timer, K_USEC(period_us), K_USEC(period_us));
+
+	return 0;
+}
+
+void arch_profiler_stop(void)
+{
+	k_timer_stop(&profiler_timer);
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup profiler Sampling profiler
+ * @brief Statistical profiler recording interrupted program counters
+ *
+ * While running, the architecture layer periodically interrupts the CPU
+ * and records the program counter and thread it interrupted.  Samples go
+ * through a lock-free buffer and are aggregated in thread context into
+ * a histogram of (thread, program counter) pairs.  Addresses are not
+ * resolved on target, scripts/profiler/profiler_report.py does that
+ * host side using zephyr.elf.
+ *
+ * @{
+ */
+
+/** @brief Histogram entry. */
+struct profiler_entry {
+	/** Interrupted program counter. */
+	uintptr_t pc;
+	/** Interrupted thread. It may have exited since. */
+	const struct k_thread *thread;
+	/** Number of samples. */
+	uint32_t count;
+};
+
+/** @brief Profiler statistics. */
+struct profiler_stats {
+	/** Samples taken since the last reset. */
+	uint32_t samples;
+	/** Samples lost because the sample buffer was full. */
+	uint32_t dropped;
+	/** Samples not in the histogram because it was full. */
+	uint32_t overflow;
+};
+
+/**
+ * @brief Histogram callback
+ *
+ * @param entry Histogram entry.
+ * @param user_data User data passed to profiler_foreach().
+ */
+typedef void (*profiler_cb)(const struct profiler_entry *entry,
+			    void *user_data);
+
+/**
+ * @brief Start sampling
+ *
+ * @param period_us Sampling period in microseconds. The architecture
+ *	  may round it, e.g. to the system clock tick.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p period_us is 0.
+ * @retval -EALREADY if the profiler is already running.
+ * @retval -errno other error reported by the architecture.
+ */
+int profiler_start(uint32_t period_us);
+
+/**
+ * @brief Stop sampling
+ *
+ * The histogram is kept until profiler_reset() is called.
+ */
+void profiler_stop(void);
+
+/**
+ * @brief Check whether the profiler is running
+ *
+ * @return true if sampling.
+ */
+bool profiler_is_running(void);
+
+/**
+ * @brief Clear the histogram and statistics
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Iterate over the histogram
+ *
+ * Pending samples are aggregated first. Entries are not sorted.
+ *
+ * @param cb Callback called for every entry.
+ * @param user_data User data passed to @p cb.
+ */
+void profiler_foreach(profiler_cb cb, void *user_data);
+
+/**
+ * @brief Get profiler statistics
+ *
+ * @param stats Destination.
+ */
+void profiler_stats_get(struct profiler_stats *stats);
+
+/**
+ * @brief Record a sample
+ *
+ * Called by the architecture layer from the sampling interrupt. Samples
+ * must not be recorded concurrently.
+ *
+ * @param pc Interrupted program counter.
+ */
+void z_profiler_sample(uintptr_t pc);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
@@ -707,8 +707,34 @@ static inline int device_pm_put_sync(const struct device *dev) { return -ENOTSUP
 		.data = (data_ptr),					\
 		Z_DEVICE_DEFINE_PM_INIT(dev_name, pm_control_fn)	\
 	};								\
-	Z_INIT_ENTRY_DEFINE(_CONCAT(__device_, dev_name), init_fn,	\
-			    (&_CONCAT(__device_, dev_name)), level, prio)
+	Z_DEVICE_DEFINE_DEPS(node_id, dev_name)				\
+	Z_INIT_ENTRY_DEFINE_DEPS(_CONCAT(__device_, dev_name), init_fn,	\
+				 (&_CONCAT(__device_, dev_name)), level, prio, \
+				 Z_DEVICE_DEPS_ORD(node_id),		\
+				 Z_DEVICE_DEPS_REQUIRES(node_id, dev_name))
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/* Devices with a devicetree node record the ordinals of the nodes they
+ * depend on, so that independent devices can be initialized concurrently.
+ * Indirect dependencies are included, as the nodes in between may have
+ * no device of their own, e.g. flash partitions.
+ */
+#define Z_DEVICE_DEFINE_DEPS(node_id, dev_name)				\
+	COND_CODE_1(DT_NODE_EXISTS(node_id),				\
+		    (static const uint16_t _CONCAT(__init_deps_, dev_name)[] = { \
+			DT_REQUIRES_ALL_DEP_ORDS(node_id) Z_INIT_ORD_NONE \
+		    };), ())
+#define Z_DEVICE_DEPS_ORD(node_id)					\
+	COND_CODE_1(DT_NODE_EXISTS(node_id), (DT_DEP_ORD(node_id)),	\
+		    (Z_INIT_ORD_NONE))
+#define Z_DEVICE_DEPS_REQUIRES(node_id, dev_name)			\
+	COND_CODE_1(DT_NODE_EXISTS(node_id),				\
+		    (_CONCAT(__init_deps_, dev_name)), (NULL))
+#else
+#define Z_DEVICE_DEFINE_DEPS(node_id, dev_name)
+#define Z_DEVICE_DEPS_ORD(node_id) Z_INIT_ORD_NONE
+#define Z_DEVICE_DEPS_REQUIRES(node_id, dev_name) NULL
+#endif
 
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 #define Z_DEVICE_DEFINE_PM(dev_name)					\
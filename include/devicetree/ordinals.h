@@ -43,6 +43,19 @@
  */
 #define DT_REQUIRES_DEP_ORDS(node_id) DT_CAT(node_id, _REQUIRES_ORDS)
 
+/**
+ * @brief Get a list of dependency ordinals of all of a node's dependencies
+ *
+ * Like DT_REQUIRES_DEP_ORDS(), but also includes the nodes the direct
+ * dependencies depend on, recursively. This is for example needed to
+ * find the flash controller a node depends on through a partition.
+ *
+ * @param node_id Node identifier
+ * @return a list of dependency ordinals, with each ordinal followed
+ *         by a comma (<tt>,</tt>), or an empty expansion
+ */
+#define DT_REQUIRES_ALL_DEP_ORDS(node_id) DT_CAT(node_id, _REQUIRES_ALL_ORDS)
+
 /**
  * @brief Get a list of dependency ordinals of what depends directly on a node
  *
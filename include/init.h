@@ -32,6 +32,23 @@ extern "C" {
 
 struct device;
 
+/** Dependency ordinal of an init entry that is not a devicetree device */
+#define Z_INIT_ORD_NONE 0xFFFF
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+/**
+ * @brief When an init entry ran, in hardware cycles
+ *
+ * Both fields are zero if the entry has not run yet.
+ */
+struct init_timing {
+	/** Cycle count just before the init function was called */
+	uint32_t start;
+	/** Cycle count just after the init function returned */
+	uint32_t end;
+};
+#endif
+
 /**
  * @brief Static init entry structure for each device driver or services
  *
@@ -49,10 +66,35 @@ struct init_entry {
 	 * if the init entry is not used for a device driver but a services.
 	 */
 	const struct device *dev;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/** Devicetree dependency ordinal of the device, or Z_INIT_ORD_NONE */
+	uint16_t ord;
+	/** Dependency ordinals of the devicetree nodes the device requires,
+	 * terminated by Z_INIT_ORD_NONE. NULL if the entry is not a
+	 * devicetree device.
+	 */
+	const uint16_t *requires;
+#endif
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	/** When the init function ran */
+	struct init_timing *timing;
+#endif
 };
 
 void z_sys_init_run_level(int32_t _level);
 
+/**
+ * @brief Get access to all init entries
+ *
+ * Init entries are returned in the order they are run by the serial
+ * boot, which is also the order they are started in by the parallel one.
+ *
+ * @param entries Pointer set to the first init entry
+ *
+ * @return the number of init entries
+ */
+size_t z_init_get_all_static(const struct init_entry **entries);
+
 /* A counter is used to avoid issues when two or more system devices
  * are declared in the same C file with the same init function.
  */
@@ -83,13 +125,54 @@ void z_sys_init_run_level(int32_t _level);
  * other objects of the same initialization level. See SYS_INIT().
  */
 #define Z_INIT_ENTRY_DEFINE(_entry_name, _init_fn, _device, _level, _prio)	\
+	Z_INIT_ENTRY_DEFINE_DEPS(_entry_name, _init_fn, _device, _level,	\
+				 _prio, Z_INIT_ORD_NONE, NULL)
+
+/**
+ * @def Z_INIT_ENTRY_DEFINE_DEPS
+ *
+ * @brief Create an init entry object with devicetree dependencies
+ *
+ * @details Like Z_INIT_ENTRY_DEFINE(), but also records the dependency
+ * ordinal of the entry and the ordinals it depends on. These are only
+ * used with CONFIG_DEVICE_INIT_PARALLEL, to decide which entries may
+ * run concurrently.
+ *
+ * @param _ord Dependency ordinal of the device, see DT_DEP_ORD().
+ *
+ * @param _requires Array of required ordinals terminated by
+ * Z_INIT_ORD_NONE, or NULL if the entry is not a devicetree device.
+ */
+#define Z_INIT_ENTRY_DEFINE_DEPS(_entry_name, _init_fn, _device, _level,	\
+				 _prio, _ord, _requires)		\
+	Z_INIT_TIMING_DEFINE(_entry_name)					\
 	static const Z_DECL_ALIGN(struct init_entry)			\
 		_CONCAT(__init_, _entry_name) __used			\
 	__attribute__((__section__(".init_" #_level STRINGIFY(_prio)))) = { \
 		.init = (_init_fn),					\
 		.dev = (_device),					\
+		Z_INIT_DEPS_INIT(_ord, _requires)			\
+		Z_INIT_TIMING_INIT(_entry_name)				\
 	}
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define Z_INIT_DEPS_INIT(_ord, _requires)				\
+	.ord = (_ord),							\
+	.requires = (_requires),
+#else
+#define Z_INIT_DEPS_INIT(_ord, _requires)
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+#define Z_INIT_TIMING_DEFINE(_entry_name)				\
+	static struct init_timing _CONCAT(__init_timing_, _entry_name);
+#define Z_INIT_TIMING_INIT(_entry_name)					\
+	.timing = &_CONCAT(__init_timing_, _entry_name),
+#else
+#define Z_INIT_TIMING_DEFINE(_entry_name)
+#define Z_INIT_TIMING_INIT(_entry_name)
+#endif
+
 /**
  * @def SYS_INIT
  *
@@ -97,7 +97,9 @@ extern "C" {
 
 struct k_thread;
 struct k_mutex;
+struct k_condvar;
 struct k_sem;
+struct k_event;
 struct k_msgq;
 struct k_mbox;
 struct k_pipe;
@@ -276,7 +278,7 @@ struct _thread_userspace_local_data {
 };
 #endif
 
-/* private, used by k_poll and k_work_poll */
+/* private, used by k_poll, k_work_poll and k_poll_set */
 struct k_work_poll;
 typedef int (*_poller_cb_t)(struct k_poll_event *event, uint32_t state);
 struct z_poller {
@@ -2619,6 +2621,94 @@ struct k_lifo {
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_mpsc_queue {
+	sys_mpsc_t queue;
+	_wait_q_t wait_q;
+	/* Set while the consumer is (about to be) pended on wait_q */
+	atomic_t waiting;
+};
+
+#define Z_MPSC_QUEUE_INITIALIZER(obj) \
+	{ \
+	.queue = SYS_MPSC_STATIC_INIT(&obj.queue), \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.waiting = ATOMIC_INIT(0), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup mpsc_queue_apis MPSC Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize an MPSC queue.
+ *
+ * An MPSC queue passes intrusive sys_mpsc_node_t items from any number
+ * of producer threads and ISRs to a single consumer thread.  Adding an
+ * item never takes a lock and only involves the scheduler when the
+ * consumer is actually blocked waiting for one, making it cheaper than
+ * a k_fifo for ISR-to-thread handoff.
+ *
+ * MPSC queues are only usable from supervisor mode.
+ *
+ * @param queue Address of the queue.
+ *
+ * @return N/A
+ */
+void k_mpsc_queue_init(struct k_mpsc_queue *queue);
+
+/**
+ * @brief Add an item to an MPSC queue.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ * @param node Address of the item's node, which must not be in any queue.
+ *
+ * @return N/A
+ */
+void k_mpsc_queue_put(struct k_mpsc_queue *queue, sys_mpsc_node_t *node);
+
+/**
+ * @brief Get the oldest item from an MPSC queue.
+ *
+ * Only one thread may consume from a given queue.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param queue Address of the queue.
+ * @param timeout Waiting period to obtain an item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the item's node if successful; NULL if returned
+ * without waiting, or waiting period timed out.
+ */
+sys_mpsc_node_t *k_mpsc_queue_get(struct k_mpsc_queue *queue,
+				  k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize an MPSC queue.
+ *
+ * The queue can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_mpsc_queue <name>; @endcode
+ *
+ * @param name Name of the queue.
+ */
+#define K_MPSC_QUEUE_DEFINE(name) \
+	struct k_mpsc_queue name = Z_MPSC_QUEUE_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2775,6 +2865,33 @@ struct k_work;
  */
 typedef void (*k_work_handler_t)(struct k_work *work);
 
+/**
+ * @brief Workqueue statistics.
+ *
+ * Latencies are measured in hardware cycles from the moment a work item
+ * is queued until a worker thread starts running its handler.
+ */
+struct k_work_q_stats {
+	/** Work items queued */
+	uint32_t submitted;
+	/** Work item handlers run */
+	uint32_t completed;
+	/** Work items currently queued */
+	uint32_t queued;
+	/** Most work items queued at once */
+	uint32_t queued_max;
+	/** Worker threads currently running a handler */
+	uint32_t busy;
+	/** Most worker threads running a handler at once */
+	uint32_t busy_max;
+	/** Worker threads serving the workqueue */
+	uint32_t workers;
+	/** Longest queueing latency */
+	uint32_t latency_max;
+	/** Sum of the queueing latencies of all completed work items */
+	uint64_t latency_total;
+};
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2782,16 +2899,24 @@ typedef void (*k_work_handler_t)(struct k_work *work);
 struct k_work_q {
 	struct k_queue queue;
 	struct k_thread thread;
+#ifdef CONFIG_WORKQUEUE_STATS
+	struct k_spinlock stats_lock;
+	struct k_work_q_stats stats;
+#endif
 };
 
 enum {
 	K_WORK_STATE_PENDING,	/* Work item pending state */
+	K_WORK_STATE_COUNTED,	/* Work item queued in workqueue stats */
 };
 
 struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORKQUEUE_STATS
+	uint32_t queued_at;		/* Cycle count when last queued */
+#endif
 };
 
 struct k_delayed_work {
@@ -2813,6 +2938,16 @@ struct k_work_poll {
 
 extern struct k_work_q k_sys_work_q;
 
+#ifdef CONFIG_WORKQUEUE_STATS
+extern void z_work_q_stats_queued(struct k_work_q *work_q,
+				  struct k_work *work);
+extern void z_work_q_stats_unqueued(struct k_work_q *work_q,
+				    struct k_work *work);
+extern void z_work_q_stats_started(struct k_work_q *work_q,
+				   struct k_work *work);
+extern void z_work_q_stats_finished(struct k_work_q *work_q);
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2878,6 +3013,9 @@ static inline void k_work_submit_to_queue(struct k_work_q *work_q,
 					  struct k_work *work)
 {
 	if (!atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+#ifdef CONFIG_WORKQUEUE_STATS
+		z_work_q_stats_queued(work_q, work);
+#endif
 		k_queue_append(&work_q->queue, work);
 	}
 }
@@ -3004,6 +3142,63 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+/**
+ * @brief Add a worker thread to a workqueue.
+ *
+ * This routine spawns another thread processing the work items submitted
+ * to workqueue @a work_q, which must already have been started with
+ * k_work_q_start().  All worker threads take items from the same queue in
+ * submission order, so a work item whose handler blocks or runs for a
+ * long time only holds up its own thread, and on SMP systems several
+ * handlers can run in parallel.
+ *
+ * @warning
+ * Handlers of a workqueue with more than one worker may run concurrently
+ * with each other, including a work item resubmitted while its handler
+ * is still running.  They must provide their own locking where needed.
+ *
+ * @param work_q Address of workqueue.
+ * @param thread Address of the thread object for the new worker.
+ * @param stack Pointer to the new worker's stack space, as defined by
+ *		K_THREAD_STACK_DEFINE()
+ * @param stack_size Size of the new worker's stack (in bytes).
+ * @param prio Priority of the new worker.
+ *
+ * @return N/A
+ */
+extern void k_work_q_add_worker(struct k_work_q *work_q,
+				struct k_thread *thread,
+				k_thread_stack_t *stack,
+				size_t stack_size, int prio);
+
+#if defined(CONFIG_WORKQUEUE_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the statistics of a workqueue.
+ *
+ * Statistics are not collected for workqueues started with
+ * k_work_q_user_start().
+ *
+ * @param work_q Address of workqueue.
+ * @param stats Address of area to hold the statistics.
+ *
+ * @return N/A
+ */
+extern void k_work_q_stats_get(struct k_work_q *work_q,
+			       struct k_work_q_stats *stats);
+
+/**
+ * @brief Reset the statistics of a workqueue.
+ *
+ * Clears the counters, maxima and latency totals.  The current number of
+ * queued items, busy workers and workers are kept.
+ *
+ * @param work_q Address of workqueue.
+ *
+ * @return N/A
+ */
+extern void k_work_q_stats_reset(struct k_work_q *work_q);
+#endif
+
 #define Z_DELAYED_WORK_INITIALIZER(work_handler) \
 	{ \
 		.work = Z_WORK_INITIALIZER(work_handler), \
@@ -3463,6 +3658,101 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_condvar {
+	_wait_q_t wait_q;
+
+	_OBJECT_TRACING_NEXT_PTR(k_condvar)
+	_OBJECT_TRACING_LINKED_FLAG
+};
+
+#define Z_CONDVAR_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	_OBJECT_TRACING_INIT \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup condvar_apis Condition Variables APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a condition variable
+ *
+ * @param condvar pointer to a @p k_condvar structure
+ * @retval 0 Condition variable created successfully
+ */
+__syscall int k_condvar_init(struct k_condvar *condvar);
+
+/**
+ * @brief Signals one thread that is pending on the condition variable
+ *
+ * Wakes up the highest priority thread waiting on @a condvar, if any.
+ *
+ * @param condvar pointer to a @p k_condvar structure
+ * @retval 0 On success
+ */
+__syscall int k_condvar_signal(struct k_condvar *condvar);
+
+/**
+ * @brief Unblock all threads that are pending on the condition
+ * variable
+ *
+ * @param condvar pointer to a @p k_condvar structure
+ * @return An integer with number of woken threads on success
+ */
+__syscall int k_condvar_broadcast(struct k_condvar *condvar);
+
+/**
+ * @brief Waits on the condition variable releasing the mutex lock
+ *
+ * Atomically releases the currently owned mutex, blocks the current
+ * thread waiting on the condition variable specified by @a condvar,
+ * and finally acquires the mutex again.
+ *
+ * The waiting thread unblocks only after another thread calls
+ * k_condvar_signal() or k_condvar_broadcast() with the same condition
+ * variable, or when the timeout expires.  The mutex is locked again
+ * in either case before returning.
+ *
+ * @param condvar pointer to a @p k_condvar structure
+ * @param mutex Address of the mutex, which must be locked exactly
+ *              once by the calling thread.
+ * @param timeout Waiting period for the condition variable
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ * @retval 0 On success
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
+			     k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize a condition variable.
+ *
+ * The condition variable can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_condvar <name>; @endcode
+ *
+ * @param name Name of the condition variable.
+ */
+#define K_CONDVAR_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE(k_condvar, name) = \
+		Z_CONDVAR_INITIALIZER(name)
+
 /**
  * @}
  */
@@ -3604,6 +3894,122 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	uint32_t events;
+
+	_OBJECT_TRACING_NEXT_PTR(k_event)
+	_OBJECT_TRACING_LINKED_FLAG
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	_OBJECT_TRACING_INIT \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Wait until all of the requested events are set, not just any one. */
+#define K_EVENT_WAIT_ALL BIT(0)
+
+/** Clear the events that satisfied the wait before returning them. */
+#define K_EVENT_WAIT_CLEAR BIT(1)
+
+/**
+ * @brief Initialize an event object
+ *
+ * This routine initializes an event object, prior to its first use.
+ * All 32 events start out cleared.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Set events in an event object
+ *
+ * This routine sets the events in @a events in the event object,
+ * leaving the other events untouched.  Every thread whose wait
+ * condition is now satisfied is woken up; threads that are still
+ * waiting for other events are left pending.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to set.
+ *
+ * @return The events that were set before this call.
+ */
+__syscall uint32_t k_event_set(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Clear events in an event object
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to clear.
+ *
+ * @return The events that were set before this call.
+ */
+__syscall uint32_t k_event_clear(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Wait for events
+ *
+ * This routine waits until any of the events in @a events are set in
+ * @a event, or until all of them are when @a options includes
+ * K_EVENT_WAIT_ALL.  If the condition already holds the routine
+ * returns at once.  With K_EVENT_WAIT_CLEAR the matching events are
+ * cleared atomically with the wakeup, so that only one waiter
+ * consumes each posting.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for.
+ * @param options K_EVENT_WAIT_ALL and/or K_EVENT_WAIT_CLEAR, or 0.
+ * @param timeout Waiting period for the events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return The requested events that were set when the wait was
+ *         satisfied, or 0 if the waiting period timed out.
+ */
+__syscall uint32_t k_event_wait(struct k_event *event, uint32_t events,
+				uint32_t options, k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE(k_event, name) = \
+		Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3801,6 +4207,69 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send a batch of messages to a message queue.
+ *
+ * This routine sends the @a num_msgs messages stored back to back at
+ * @a data to message queue @a msgq, in order, taking the queue's lock
+ * once rather than once per message.  Messages are handed directly to
+ * waiting receivers first; the rest are added to the queue's ring buffer.
+ *
+ * If the queue does not have room for all of them the caller waits for
+ * up to @a timeout for receivers to make room.  Messages sent before the
+ * timeout expires stay sent.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of the messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Waiting period to send all messages,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, which is less than @a num_msgs only
+ *         if the queue filled up and the waiting period expired or the
+ *         queue was purged.
+ * @retval -ENOMSG Queue purged while waiting, before any message was
+ *         sent.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive a batch of messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a msgq into consecutive message-sized slots at @a data, in "first in,
+ * first out" order, taking the queue's lock once rather than once per
+ * message.
+ *
+ * If fewer than @a min_msgs messages are available the caller waits for
+ * up to @a timeout until senders have supplied at least that many; it
+ * is woken only once, rather than for every message sent.  Messages
+ * received before the timeout expires are kept.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param min_msgs Number of messages to wait for.
+ * @param timeout Waiting period to receive @a min_msgs messages,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, which is less than @a min_msgs
+ *         only if the waiting period expired or the queue was purged.
+ * @retval -EINVAL @a min_msgs is greater than @a max_msgs.
+ * @retval -ENOMSG Queue purged while waiting, before any message was
+ *         received.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t max_msgs, uint32_t min_msgs,
+			      k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4109,6 +4578,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIMED	BIT(1)	/** k_pipe_put_claim() outstanding */
+#define K_PIPE_FLAG_GET_CLAIMED	BIT(2)	/** k_pipe_get_claim() outstanding */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4211,6 +4682,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY A put claim is outstanding; zero data bytes were written.
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4234,6 +4706,7 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY A get claim is outstanding; zero data bytes were read.
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
@@ -4276,6 +4749,159 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim contiguous space in a pipe's ring buffer for writing.
+ *
+ * This routine lets the caller produce data in place in @a pipe's ring
+ * buffer instead of copying it in with k_pipe_put().  It returns the
+ * largest contiguous free region, up to @a size bytes; the data written
+ * there becomes visible to readers once k_pipe_put_finish() is called.
+ * Less space than requested may be returned when the free space wraps
+ * around the end of the buffer, in which case a second claim after
+ * finishing yields the rest.
+ *
+ * Only one put claim may be outstanding.  Until it has been finished,
+ * k_pipe_put() fails with -EBUSY and k_pipe_block_put() must not be
+ * used on the pipe.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; zero if the pipe is full, unbuffered
+ *         or already has a put claim outstanding.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Commit data written to space claimed with k_pipe_put_claim().
+ *
+ * The first @a size bytes of the claimed space are added to the pipe,
+ * and handed to readers waiting on it; any remainder of the claim is
+ * released.  @a size may be zero to abandon the claim.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written to the claimed space.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL No claim is outstanding, or @a size exceeds it.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim contiguous data in a pipe's ring buffer for reading.
+ *
+ * This routine lets the caller consume data in place from @a pipe's
+ * ring buffer instead of copying it out with k_pipe_get().  It returns
+ * the largest contiguous run of buffered data, up to @a size bytes,
+ * which stays in the pipe until k_pipe_get_finish() is called.
+ *
+ * Only one get claim may be outstanding.  Until it has been finished,
+ * k_pipe_get() fails with -EBUSY.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; zero if the pipe is empty, unbuffered
+ *         or already has a get claim outstanding.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Release data claimed with k_pipe_get_claim().
+ *
+ * The first @a size bytes of the claimed data are removed from the
+ * pipe, making room for data from waiting writers; any remainder stays
+ * in the pipe.  @a size may be zero to abandon the claim.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed from the claimed data.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No claim is outstanding, or @a size exceeds it.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
+/** Pipe scatter-gather segment, see k_pipe_put_iov() and k_pipe_get_iov() */
+struct k_pipe_iovec {
+	void *iov_base;		/**< Start of the segment */
+	size_t iov_len;		/**< Size of the segment (in bytes) */
+};
+
+/**
+ * @brief Write data from a set of buffers to a pipe.
+ *
+ * This routine behaves like k_pipe_put() for the concatenation of the
+ * @a iov_cnt segments in @a iov, without the caller having to gather
+ * them into one buffer first.  Segments are written in order;
+ * @a min_xfer applies to their total size.
+ *
+ * The segments are written one after the other, so data from other
+ * writers may be interleaved between them, and when an error is
+ * returned earlier segments may have been written.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to write.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; fewer than @a min_xfer data
+ *              bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ * @retval -EBUSY A put claim is outstanding; fewer than @a min_xfer
+ *                data bytes were written.
+ */
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into a set of buffers.
+ *
+ * This routine behaves like k_pipe_get() for the concatenation of the
+ * @a iov_cnt segments in @a iov.  Segments are filled in order;
+ * @a min_xfer applies to their total size.
+ *
+ * @note This routine is only available to supervisor threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to fill.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; fewer than @a min_xfer data
+ *              bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ * @retval -EBUSY A get claim is outstanding; fewer than @a min_xfer
+ *                data bytes were read.
+ */
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -4284,6 +4910,8 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
 struct k_mem_slab {
 	_wait_q_t wait_q;
+	/* threads blocked in k_mem_slab_alloc_bulk() */
+	_wait_q_t bulk_wait_q;
 	uint32_t num_blocks;
 	size_t block_size;
 	char *buffer;
@@ -4292,6 +4920,9 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_TRACE_FAILURES
+	uint32_t num_failed;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -4301,6 +4932,7 @@ struct k_mem_slab {
 			       slab_num_blocks) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.bulk_wait_q = Z_WAIT_Q_INIT(&obj.bulk_wait_q), \
 	.num_blocks = slab_num_blocks, \
 	.block_size = slab_block_size, \
 	.buffer = slab_buffer, \
@@ -4405,6 +5037,50 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/**
+ * @brief Allocate several blocks from a memory slab at once.
+ *
+ * This routine allocates @a count memory blocks from a memory slab
+ * in a single critical section.  Allocation is all or nothing: if
+ * fewer than @a count blocks are free, none are taken and the caller
+ * waits (up to @a timeout) until all of them can be allocated
+ * together.  Threads waiting in k_mem_slab_alloc() for a single
+ * block are served before bulk waiters.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of at least @a count block address areas.
+ * @param count Number of blocks to allocate.
+ * @param timeout Non-negative waiting period to wait for operation to complete.
+ *        Use K_NO_WAIT to return without waiting,
+ *        or K_FOREVER to wait as long as necessary.
+ *
+ * @retval 0 Memory allocated. The first @a count entries of @a mem are
+ *         set to the starting addresses of the memory blocks.
+ * @retval -ENOMEM Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a count exceeds the number of blocks in the slab.
+ */
+extern int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem,
+				 uint32_t count, k_timeout_t timeout);
+
+/**
+ * @brief Free several blocks to a memory slab at once.
+ *
+ * This routine releases @a count previously allocated memory blocks
+ * back to their memory slab in a single critical section.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count block addresses (as set by
+ *        k_mem_slab_alloc() or k_mem_slab_alloc_bulk()).
+ * @param count Number of blocks to free.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem,
+				 uint32_t count);
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -4455,6 +5131,28 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 	return slab->num_blocks - slab->num_used;
 }
 
+/**
+ * @brief Get the number of failed allocations from a memory slab.
+ *
+ * This routine gets the number of k_mem_slab_alloc() and
+ * k_mem_slab_alloc_bulk() calls on @a slab that returned without
+ * memory, either immediately or after timing out.
+ *
+ * @param slab Address of the memory slab.
+ *
+ * @return Number of failed allocations, or 0 if
+ *         CONFIG_MEM_SLAB_TRACE_FAILURES is disabled.
+ */
+static inline uint32_t k_mem_slab_failures_get(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_FAILURES
+	return slab->num_failed;
+#else
+	ARG_UNUSED(slab);
+	return 0;
+#endif
+}
+
 /** @} */
 
 /**
@@ -4464,10 +5162,45 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+/**
+ * @brief k_heap per-CPU cache statistics
+ *
+ * Counters summed over all CPUs by k_heap_cache_stats_get().
+ */
+struct k_heap_cache_stats {
+	/** Allocations served straight from a CPU cache */
+	uint32_t hits;
+	/** Allocations that had to refill a CPU cache from the heap */
+	uint32_t misses;
+	/** Frees absorbed by a CPU cache */
+	uint32_t frees;
+	/** Frees that spilled a batch of cached blocks back to the heap */
+	uint32_t drains;
+	/** Times all CPU caches were emptied back into the heap */
+	uint32_t flushes;
+};
+
+/* Magazines of free blocks for one CPU, one per size class */
+struct z_heap_cpu_cache {
+	struct k_spinlock lock;
+	uint8_t count[CONFIG_HEAP_CPU_CACHE_CLASSES];
+	void *blocks[CONFIG_HEAP_CPU_CACHE_CLASSES][CONFIG_HEAP_CPU_CACHE_DEPTH];
+	struct k_heap_cache_stats stats;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_CPU_CACHE
+	/* Non-zero while a thread is failing or blocked in
+	 * k_heap_alloc(); frees then bypass the CPU caches
+	 */
+	atomic_t cache_bypass;
+	struct z_heap_cpu_cache cpu_cache[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 /**
@@ -4516,6 +5249,29 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#if defined(CONFIG_HEAP_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Return all blocks held in per-CPU caches to a k_heap
+ *
+ * With CONFIG_HEAP_CPU_CACHE, small blocks freed with k_heap_free()
+ * are kept in per-CPU caches rather than returned to the heap.  This
+ * empties every cache, e.g. before inspecting or validating the
+ * heap.  k_heap_alloc() does the same on its own before failing.
+ *
+ * @param h Heap whose caches are flushed
+ */
+void k_heap_cache_flush(struct k_heap *h);
+
+/**
+ * @brief Read the per-CPU cache statistics of a k_heap
+ *
+ * @param h Heap to query
+ * @param stats Filled with the counters summed over all CPUs
+ */
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats);
+#endif
+
 /**
  * @brief Define a static k_heap
  *
@@ -4729,6 +5485,7 @@ enum _poll_states_bits {
 	       + _POLL_NUM_TYPES \
 	       + _POLL_NUM_STATES \
 	       + 1 /* modes */ \
+	       + 1 /* reported */ \
 	      ))
 
 /* end of polling API - PRIVATE */
@@ -4809,6 +5566,9 @@ struct k_poll_event {
 	/** mode of operation, from enum k_poll_modes */
 	uint32_t mode:1;
 
+	/** PRIVATE - DO NOT TOUCH */
+	uint32_t reported:1;
+
 	/** unused bits in 32-bit word */
 	uint32_t unused:_POLL_EVENT_NUM_UNUSED_BITS;
 
@@ -4972,6 +5732,92 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Poll set
+ *
+ * Persistent set of poll events. Events are registered on their objects
+ * once, when added, and signaled events are linked on a ready list, so
+ * that waiting costs time proportional to the number of ready events
+ * rather than to the size of the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_spinlock lock;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Poll set to initialize.
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() or one of
+ * the initializer macros, and must stay valid until it is removed with
+ * k_poll_set_remove(). The object it refers to must not be destroyed while
+ * the event is in the set. An event can be in only one poll set and must
+ * not be passed to k_poll() at the same time.
+ *
+ * Poll sets have precedence below threads calling k_poll() on the same
+ * object.
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY Event is already in use.
+ */
+extern int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Poll set.
+ * @param event Event previously added with k_poll_set_add().
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not in @a set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Readiness is level triggered: an event is returned as long as the
+ * condition it polls for holds, e.g. a semaphore count is not zero. Its
+ * state field is updated accordingly and does not need to be reset by the
+ * caller. K_POLL_STATE_CANCELLED is reported once per cancellation. Ready
+ * events are returned in turn when there are more than @a max_events.
+ *
+ * Unlike k_poll(), the time spent does not depend on the number of events
+ * in the set but only on the number of ready ones.
+ *
+ * @param set Poll set.
+ * @param events Array filled with pointers to ready events.
+ * @param max_events Size of the @a events array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, or -EAGAIN if the
+ *         waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **events, int max_events,
+			   k_timeout_t timeout);
+
 /**
  * @internal
  */
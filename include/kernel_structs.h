@@ -89,6 +89,8 @@ struct _ready_q {
 	sys_dlist_t runq;
 #elif defined(CONFIG_SCHED_SCALABLE)
 	struct _priq_rb runq;
+#elif defined(CONFIG_SCHED_MULTIQ) && defined(CONFIG_SCHED_CPU_MASK)
+	struct _priq_mq_mask runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
@@ -128,6 +130,11 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	uint8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Threads queued to run on this CPU */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -203,6 +210,18 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+typedef struct {
+	struct _priq_mq waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_MQ_LIST_INIT(i, wait_q) \
+	SYS_DLIST_STATIC_INIT(&(wait_q)->waitq.queues[i]),
+
+#define Z_WAIT_Q_INIT(wait_q) \
+	{ { { UTIL_LISTIFY(32, Z_WAIT_Q_MQ_LIST_INIT, wait_q) } } }
+
 #else
 
 typedef struct {
@@ -219,14 +238,26 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * TIMEOUT_QUEUE_SCALABLE this is the absolute expiry tick
+	 * (zero when inactive) instead of a delta from the previous
+	 * entry.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Breaks ties between timeouts expiring on the same tick */
+	uint32_t order_key;
+#endif
 };
 
 #endif /* _ASMLANGUAGE */
@@ -25,12 +25,17 @@ extern "C" {
 /* Forward declaration of the log_backend type. */
 struct log_backend;
 
+/* Forward declaration of the packaged log message type. */
+struct log_msg2;
+
 /**
  * @brief Logger backend API.
  */
 struct log_backend_api {
 	void (*put)(const struct log_backend *const backend,
 		    struct log_msg *msg);
+	void (*put_msg2)(const struct log_backend *const backend,
+			 const struct log_msg2 *msg);
 	void (*put_sync_string)(const struct log_backend *const backend,
 			 struct log_msg_ids src_level, uint32_t timestamp,
 			 const char *fmt, va_list ap);
@@ -102,6 +107,22 @@ static inline void log_backend_put(const struct log_backend *const backend,
 	backend->api->put(backend, msg);
 }
 
+/**
+ * @brief Put packaged log message to the backend.
+ *
+ * Used when CONFIG_LOG2 is enabled, only for backends which implement it.
+ *
+ * @param[in] backend  Pointer to the backend instance.
+ * @param[in] msg      Pointer to message with log entry.
+ */
+static inline void log_backend_put_msg2(const struct log_backend *const backend,
+					const struct log_msg2 *msg)
+{
+	__ASSERT_NO_MSG(backend != NULL);
+	__ASSERT_NO_MSG(msg != NULL);
+	backend->api->put_msg2(backend, msg);
+}
+
 /**
  * @brief Synchronously process log message.
  *
@@ -48,6 +48,29 @@ log_backend_std_put(const struct log_output *const log_output, uint32_t flags,
 	log_msg_put(msg);
 }
 
+/** @brief Put packaged log message to a standard logger backend.
+ *
+ * @param log_output	Log output instance.
+ * @param flags		Formatting flags.
+ * @param msg		Log message.
+ */
+static inline void
+log_backend_std_put_msg2(const struct log_output *const log_output,
+			 uint32_t flags, const struct log_msg2 *msg)
+{
+	flags |= (LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP);
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_SHOW_COLOR)) {
+		flags |= LOG_OUTPUT_FLAG_COLORS;
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FORMAT_TIMESTAMP)) {
+		flags |= LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP;
+	}
+
+	log_output_msg2_process(log_output, msg, flags);
+}
+
 /** @brief Put a standard logger backend into panic mode.
  *
  * @param log_output	Log output instance.
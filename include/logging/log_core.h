@@ -15,6 +15,10 @@
 #include <sys/util.h>
 #include <sys/printk.h>
 
+#ifdef CONFIG_LOG2
+#include <logging/log_msg2.h>
+#endif
+
 #define LOG_LEVEL_NONE 0U
 #define LOG_LEVEL_ERR  1U
 #define LOG_LEVEL_WRN  2U
@@ -188,12 +192,21 @@ extern "C" {
 			log_from_user(_src_level, __VA_ARGS__);		 \
 		} else if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {		 \
 			log_string_sync(_src_level, __VA_ARGS__);	 \
+		} else if (IS_ENABLED(CONFIG_LOG2)) {			 \
+			Z_LOG_MSG2_INTERNAL(_src_level, __VA_ARGS__);	 \
 		} else {						 \
 			Z_LOG_INTERNAL_X(Z_LOG_NARGS_POSTFIX(__VA_ARGS__), \
 						_src_level, __VA_ARGS__);\
 		}							 \
 	} while (false)
 
+#ifdef CONFIG_LOG2
+#define Z_LOG_MSG2_INTERNAL(_src_level, ...) \
+	Z_LOG_MSG2_CREATE(_src_level, __VA_ARGS__)
+#else
+#define Z_LOG_MSG2_INTERNAL(_src_level, ...) do { } while (false)
+#endif
+
 #define _LOG_INTERNAL_0(_src_level, _str) \
 	log_0(_str, _src_level)
 
@@ -784,7 +797,8 @@ static inline log_arg_t z_log_do_strdup(uint32_t msk, uint32_t idx,
 do {									       \
 	if (is_user_context) {						       \
 		log_generic_from_user(_src_level, _str, _valist);	       \
-	} else if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {			       \
+	} else if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) ||			       \
+		   IS_ENABLED(CONFIG_LOG2)) {				       \
 		log_generic(_src_level, _str, _valist, _strdup_action);        \
 	} else if (_argnum == 0) {					       \
 		_LOG_INTERNAL_0(_src_level, _str);			       \
@@ -0,0 +1,223 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_
+
+#include <logging/log_msg.h>
+#include <sys/mpsc_pbuf.h>
+#include <sys/cbprintf.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Log message v2 API
+ * @defgroup log_msg2 Log message v2 API
+ * @ingroup logger
+ * @{
+ */
+
+/** @brief Packaged log message.
+ *
+ * Message is allocated in place from the log buffer. It consists of a
+ * header, a cbprintf package holding the format string with arguments
+ * and optional hexdump data which follows the package.
+ */
+struct log_msg2 {
+	union mpsc_pbuf_generic buf; /*!< Log buffer packet header. */
+	struct log_msg_ids ids;      /*!< Identification part of the message.*/
+	uint16_t pkg_len;            /*!< Package length in bytes. */
+	uint32_t timestamp;          /*!< Timestamp. */
+	uint16_t data_len;           /*!< Hexdump data length in bytes. */
+};
+
+/** @brief Length of a message, in 32-bit words.
+ *
+ * @param pkg_len Package length.
+ * @param data_len Hexdump data length.
+ */
+#define LOG_MSG2_WLEN(pkg_len, data_len) \
+	(ceiling_fraction(sizeof(struct log_msg2) + (pkg_len) + (data_len), \
+			  sizeof(uint32_t)))
+
+/** @brief Get message package.
+ *
+ * @param msg Message.
+ *
+ * @return Package which can be formatted with cbpprintf().
+ */
+static inline uint8_t *log_msg2_get_package(const struct log_msg2 *msg)
+{
+	return (uint8_t *)msg + sizeof(struct log_msg2);
+}
+
+/** @brief Get message hexdump data.
+ *
+ * @param msg Message.
+ * @param len Location to store data length.
+ *
+ * @return Data.
+ */
+static inline uint8_t *log_msg2_get_data(const struct log_msg2 *msg,
+					 size_t *len)
+{
+	*len = msg->data_len;
+
+	return log_msg2_get_package(msg) + msg->pkg_len;
+}
+
+/** @brief Get severity level of the message.
+ *
+ * @param msg Message.
+ *
+ * @return Severity level.
+ */
+static inline uint32_t log_msg2_get_level(const struct log_msg2 *msg)
+{
+	return msg->ids.level;
+}
+
+/** @brief Get domain ID of the message.
+ *
+ * @param msg Message.
+ *
+ * @return Domain ID.
+ */
+static inline uint32_t log_msg2_get_domain(const struct log_msg2 *msg)
+{
+	return msg->ids.domain_id;
+}
+
+/** @brief Get source ID (module or instance) of the message.
+ *
+ * @param msg Message.
+ *
+ * @return Source ID.
+ */
+static inline uint32_t log_msg2_get_source(const struct log_msg2 *msg)
+{
+	return msg->ids.source_id;
+}
+
+/** @brief Get timestamp of the message.
+ *
+ * @param msg Message.
+ *
+ * @return Timestamp.
+ */
+static inline uint32_t log_msg2_get_timestamp(const struct log_msg2 *msg)
+{
+	return msg->timestamp;
+}
+
+/** @brief Allocate a message from the log buffer.
+ *
+ * @param wlen Message length in 32-bit words, see LOG_MSG2_WLEN().
+ *
+ * @return Message or NULL if there is no room for it. Message drop is
+ *	   accounted for in the latter case.
+ */
+struct log_msg2 *z_log_msg2_alloc(size_t wlen);
+
+/** @brief Commit a message allocated with z_log_msg2_alloc().
+ *
+ * Message package and data must be filled in before calling.
+ *
+ * @param msg Message.
+ * @param src_level Source and severity level.
+ */
+void z_log_msg2_commit(struct log_msg2 *msg, struct log_msg_ids src_level);
+
+/** @brief Create a message from a package.
+ *
+ * Transient strings referenced by the package are copied into the
+ * message.
+ *
+ * @param src_level Source and severity level.
+ * @param package Package built with CBPRINTF_STATIC_PACKAGE() or
+ *		  cbprintf_package().
+ * @param data Hexdump data, may be NULL.
+ * @param dlen Hexdump data length.
+ */
+void z_log_msg2_static_create(struct log_msg_ids src_level,
+			      const void *package,
+			      const void *data, size_t dlen);
+
+/** @brief Create a message from a format string and a va_list.
+ *
+ * Used where argument types are not known at compile time. Arguments
+ * are packaged with cbvprintf_package() if the format string is in read
+ * only memory, otherwise they are formatted into a string of up to
+ * CONFIG_LOG2_RUNTIME_MAX_STRING bytes which is copied into the message.
+ *
+ * @param src_level Source and severity level.
+ * @param data Hexdump data, may be NULL.
+ * @param dlen Hexdump data length.
+ * @param fmt Format string.
+ * @param ap Format string arguments.
+ */
+void z_log_msg2_runtime_vcreate(struct log_msg_ids src_level,
+				const void *data, size_t dlen,
+				const char *fmt, va_list ap);
+
+/** @brief Initialize the log message buffer. */
+void z_log_msg2_init(void);
+
+/** @brief Claim the oldest message for processing.
+ *
+ * @return Message or NULL if there is none ready.
+ */
+const struct log_msg2 *z_log_msg2_claim(void);
+
+/** @brief Free a message returned by z_log_msg2_claim().
+ *
+ * @param msg Message.
+ */
+void z_log_msg2_free(const struct log_msg2 *msg);
+
+/** @brief Check if there are any messages in the buffer.
+ *
+ * @return true if at least one message is pending.
+ */
+bool z_log_msg2_pending(void);
+
+/** @brief Create a message with a format string and its arguments.
+ *
+ * Message is created in place when no argument is a string. Otherwise
+ * the package is built on the stack and copied into the message
+ * together with the strings it references.
+ */
+#define Z_LOG_MSG2_CREATE(_src_level, ...) do { \
+	if (Z_CBPRINTF_PKG_STR_CNT(__VA_ARGS__) == 0) { \
+		struct log_msg2 *_msg2 = z_log_msg2_alloc(LOG_MSG2_WLEN( \
+				CBPRINTF_STATIC_PACKAGE_SIZE(__VA_ARGS__), 0)); \
+		\
+		if (_msg2 != NULL) { \
+			CBPRINTF_STATIC_PACKAGE( \
+				log_msg2_get_package(_msg2), __VA_ARGS__); \
+			_msg2->pkg_len = \
+				CBPRINTF_STATIC_PACKAGE_SIZE(__VA_ARGS__); \
+			_msg2->data_len = 0; \
+			z_log_msg2_commit(_msg2, _src_level); \
+		} \
+	} else { \
+		uint8_t _pkg[CBPRINTF_STATIC_PACKAGE_SIZE(__VA_ARGS__)] \
+			__aligned(sizeof(uint32_t)); \
+		\
+		CBPRINTF_STATIC_PACKAGE(_pkg, __VA_ARGS__); \
+		z_log_msg2_static_create(_src_level, _pkg, NULL, 0); \
+	} \
+} while (false)
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_MSG2_H_ */
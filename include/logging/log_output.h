@@ -15,6 +15,8 @@
 extern "C" {
 #endif
 
+struct log_msg2;
+
 /**
  * @brief Log output API
  * @defgroup log_output Log output API
@@ -109,6 +111,19 @@ void log_output_msg_process(const struct log_output *log_output,
 			    struct log_msg *msg,
 			    uint32_t flags);
 
+/** @brief Process packaged log message.
+ *
+ * Function formats the message package and hexdump data, adding optional
+ * prefixes and postfixes, and outputs the result.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param msg Log message.
+ * @param flags Optional flags.
+ */
+void log_output_msg2_process(const struct log_output *log_output,
+			     const struct log_msg2 *msg,
+			     uint32_t flags);
+
 /** @brief Process log string
  *
  * Function is formatting provided string adding optional prefixes and
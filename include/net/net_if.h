@@ -1930,6 +1930,16 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP super-segments need to be split into segments by
+ * the IP stack when sending them, or if the device does it.
+ *
+ * @param iface Network interface
+ *
+ * @return True if super-segments need to be split, false otherwise.
+ */
+bool net_if_need_tcp_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -163,6 +163,17 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of received segments queued out of order. */
+	net_stats_t ooo;
+
+	/** Number of out-of-order segments dropped as they could not be
+	 * queued.
+	 */
+	net_stats_t ooodrop;
+
+	/** Number of segments retransmitted because of SACK information. */
+	net_stats_t sackrexmit;
 };
 
 /**
@@ -205,6 +216,23 @@ struct net_stats_ipv6_mld {
 	net_stats_t drop;
 };
 
+/**
+ * @brief IPv4 fragmentation statistics
+ */
+struct net_stats_ipv4_frag {
+	/** Number of received IPv4 fragments */
+	net_stats_t recv;
+
+	/** Number of sent IPv4 fragments */
+	net_stats_t sent;
+
+	/** Number of IPv4 datagrams reassembled from fragments */
+	net_stats_t reassembled;
+
+	/** Number of dropped IPv4 fragments */
+	net_stats_t drop;
+};
+
 /**
  * @brief Network packet transfer times for calculating average TX time
  */
@@ -311,6 +339,11 @@ struct net_stats {
 	struct net_stats_ipv6_mld ipv6_mld;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT)
+	/** IPv4 fragmentation statistics */
+	struct net_stats_ipv4_frag ipv4_frag;
+#endif
+
 #if NET_TC_COUNT > 1
 	/** Traffic class statistics */
 	struct net_stats_tc tc;
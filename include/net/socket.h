@@ -23,6 +23,8 @@
 
 #include <sys/types.h>
 #include <zephyr/types.h>
+#include <kernel.h>
+#include <sys/slist.h>
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
@@ -421,6 +423,99 @@ __syscall int zsock_fcntl(int sock, int cmd, int flags);
  */
 __syscall int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
 
+/**
+ * @brief Persistent set of sockets to poll
+ *
+ * Unlike zsock_poll(), which registers with every socket on every call,
+ * sockets are registered once when added to the set, and waiting costs
+ * time proportional to the number of ready sockets only. Similar to
+ * Linux epoll, with level triggered semantics.
+ *
+ * Only native sockets, including TLS ones, are supported. The API is
+ * not available from user mode.
+ */
+struct zsock_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_poll_set set;
+	/** PRIVATE - DO NOT TOUCH */
+	sys_slist_t always_ready;
+};
+
+/**
+ * @brief Poll set entry, provided by the caller for every socket
+ */
+struct zsock_poll_set_entry {
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_poll_event event;
+	/** PRIVATE - DO NOT TOUCH */
+	sys_snode_t node;
+	/** PRIVATE - DO NOT TOUCH */
+	bool has_event;
+	/** PRIVATE - DO NOT TOUCH */
+	bool always_ready;
+	/** Socket */
+	int fd;
+	/** Requested events, ZSOCK_POLLIN and ZSOCK_POLLOUT */
+	short events;
+	/** Returned events, set by zsock_poll_set_wait() */
+	short revents;
+	/** Opaque value for the caller */
+	void *user_data;
+};
+
+/**
+ * @brief Initialize a socket poll set
+ *
+ * @param pset Poll set.
+ */
+void zsock_poll_set_init(struct zsock_poll_set *pset);
+
+/**
+ * @brief Add a socket to a poll set
+ *
+ * The entry must stay valid, and the socket open, until the entry is
+ * removed with zsock_poll_set_remove().
+ *
+ * Sockets polled for ZSOCK_POLLOUT are always writable and thus
+ * returned by every zsock_poll_set_wait() call.
+ *
+ * @param pset Poll set.
+ * @param entry Entry for the socket.
+ * @param fd Socket.
+ * @param events Events to poll for.
+ * @param user_data Stored in @a entry.
+ *
+ * @return 0 on success, -1 with errno set to EBADF or EOPNOTSUPP on error.
+ */
+int zsock_poll_set_add(struct zsock_poll_set *pset,
+		       struct zsock_poll_set_entry *entry,
+		       int fd, short events, void *user_data);
+
+/**
+ * @brief Remove a socket from a poll set
+ *
+ * @param pset Poll set.
+ * @param entry Entry previously added with zsock_poll_set_add().
+ */
+void zsock_poll_set_remove(struct zsock_poll_set *pset,
+			   struct zsock_poll_set_entry *entry);
+
+/**
+ * @brief Wait for sockets of a poll set to be ready
+ *
+ * @param pset Poll set.
+ * @param ready Array filled with pointers to the entries of ready sockets,
+ *	  whose revents field is set as by zsock_poll().
+ * @param max_ready Size of the @a ready array. At most
+ *	  CONFIG_NET_SOCKETS_POLL_MAX entries are returned by one call.
+ * @param timeout Timeout in milliseconds, negative to wait forever.
+ *
+ * @return Number of ready sockets, 0 on timeout.
+ */
+int zsock_poll_set_wait(struct zsock_poll_set *pset,
+			struct zsock_poll_set_entry **ready, int max_ready,
+			int timeout);
+
 /**
  * @brief Get various socket options
  *
@@ -6,11 +6,12 @@
 #ifndef ZEPHYR_INCLUDE_SCHED_PRIQ_H_
 #define ZEPHYR_INCLUDE_SCHED_PRIQ_H_
 
+#include <zephyr/types.h>
 #include <sys/util.h>
 #include <sys/dlist.h>
 #include <sys/rb.h>
 
-/* Two abstractions are defined here for "thread priority queues".
+/* Three abstractions are defined here for "thread priority queues".
  *
  * One is a "dumb" list implementation appropriate for systems with
  * small numbers of threads and sensitive to code size.  It is stored
@@ -19,12 +20,15 @@
  * abstraction worked and is very fast as long as the number of
  * threads is small.
  *
- * The other is a balanced tree "fast" implementation with rather
+ * Another is a balanced tree "fast" implementation with rather
  * larger code size (due to the data structure itself, the code here
  * is just stubs) and higher constant-factor performance overhead, but
  * much better O(logN) scaling in the presence of large number of
  * threads.
  *
+ * A third, the bitmap-indexed multi-queue below, trades RAM for
+ * O(1) operations when the number of priorities is small.
+ *
  * Each can be used for either the wait_q or system ready queue,
  * configurable at build time.
  */
@@ -47,9 +51,9 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
 /* Traditional/textbook "multi-queue" structure.  Separate lists for a
  * small number (max 32 here) of fixed priorities.  This corresponds
  * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represent their requirements.
+ * comparatively high, but performance is very fast.  With deadline
+ * scheduling each list is kept sorted by deadline, so the head of the
+ * lowest non-empty list is always the next thread to run.
  */
 struct _priq_mq {
 	sys_dlist_t queues[32];
@@ -59,5 +63,23 @@ struct _priq_mq {
 void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+/* Multi-queue used as the ready queue when CPU masks are enabled.
+ * Tracks, per CPU, which priority levels hold at least one thread
+ * that CPU may run, so picking a thread never visits a level that
+ * only holds threads pinned elsewhere.
+ */
+struct _priq_mq_mask {
+	struct _priq_mq mq;
+	/* bit 1<<i set in cpu_bitmask[c] if queues[i] holds a thread
+	 * allowed on CPU c
+	 */
+	unsigned int cpu_bitmask[CONFIG_MP_NUM_CPUS];
+	/* number of threads in queues[i] allowed on CPU c */
+	uint16_t cpu_count[32][CONFIG_MP_NUM_CPUS];
+};
+#endif
 
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
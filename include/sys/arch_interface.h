@@ -845,6 +845,52 @@ size_t arch_cache_line_size_get(void);
 #endif
 /** @} */
 
+/**
+ * @defgroup arch-crc Architecture-specific CRC functions
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_CRC32_ARCH
+/**
+ * @brief Update a CRC-32 (IEEE 802.3) using CRC instructions
+ *
+ * @see crc32_ieee_update
+ */
+uint32_t arch_crc32_ieee_update(uint32_t crc, const uint8_t *data,
+				size_t len);
+#endif
+/** @} */
+
+/**
+ * @defgroup arch-profiler Architecture-specific sampling profiler APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_PROFILER
+/**
+ * @brief Start sampling
+ *
+ * Periodically interrupt the CPU and pass the interrupted program
+ * counter to z_profiler_sample(), which must not be called concurrently.
+ *
+ * @see profiler_start
+ *
+ * @param period_us Sampling period in microseconds.
+ * @return 0 on success, or a negative errno value.
+ */
+int arch_profiler_start(uint32_t period_us);
+
+/**
+ * @brief Stop sampling
+ *
+ * @see profiler_stop
+ */
+void arch_profiler_stop(void);
+#endif
+/** @} */
+
 #ifdef CONFIG_TIMING_FUNCTIONS
 #include <timing/types.h>
 
@@ -10,6 +10,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <toolchain.h>
+#include <sys/cbprintf_internal.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -116,6 +117,132 @@ size_t cbprintf_arglen(const char *format);
  */
 int cbvprintf(cbprintf_cb out, void *ctx, const char *format, va_list ap);
 
+/** @brief Determine the size of a statically built package.
+ *
+ * Evaluates to a compile time constant, the number of bytes
+ * CBPRINTF_STATIC_PACKAGE() needs for the same format string and
+ * arguments.  The arguments are not evaluated.
+ *
+ * @param ... format string followed by the arguments to be packaged.
+ */
+#define CBPRINTF_STATIC_PACKAGE_SIZE(...) \
+	Z_CBPRINTF_STATIC_PACKAGE_SIZE(__VA_ARGS__)
+
+/** @brief Capture a format string and its arguments into a package.
+ *
+ * The type of each argument is determined at compile time, so no
+ * parsing of the format string is done and every argument is stored
+ * after the default argument promotions, 64-bit and floating point
+ * values included.  Each argument is evaluated exactly once.
+ *
+ * The format string is stored by reference and must remain valid until
+ * the package is formatted.  Arguments of type @c char pointer which do
+ * not point into read only memory are recorded as transient;
+ * cbprintf_package_copy() appends copies of those strings to the
+ * package.  Until it has been copied the package also refers to them.
+ *
+ * @param packaged buffer of at least CBPRINTF_STATIC_PACKAGE_SIZE()
+ * bytes, aligned to at least 16 bits.
+ *
+ * @param ... format string followed by the arguments to be packaged.
+ */
+#define CBPRINTF_STATIC_PACKAGE(packaged, ...) \
+	Z_CBPRINTF_STATIC_PACKAGE(packaged, __VA_ARGS__)
+
+/** @brief Maximum number of transient strings in a runtime package.
+ *
+ * cbprintf_package() keeps track of the string arguments which have to
+ * be copied on the stack, this is the limit.
+ */
+#define CBPRINTF_PACKAGE_MAX_STR 16
+
+/** @brief Capture a format string and its arguments into a package.
+ *
+ * Equivalent to CBPRINTF_STATIC_PACKAGE() but the format string is
+ * parsed at runtime to determine the type of each argument, so it works
+ * where the arguments are only available as a @c va_list.  All
+ * conversions defined by the C standard are recognized, whether or not
+ * the formatter in use supports them, so that later arguments are found
+ * at the right place.
+ *
+ * @param packaged destination, aligned to at least 16 bits, or NULL to
+ * only calculate the package length.
+ *
+ * @param len size of @p packaged, ignored when it is NULL.
+ *
+ * @param format a standard ISO C format string with characters and
+ * conversion specifications.
+ *
+ * @param ... arguments corresponding to the conversion specifications
+ * found within @p format.
+ *
+ * @retval positive the length of the package in bytes.
+ * @retval -ENOSPC if @p packaged is too small.
+ * @retval -EINVAL if the package would be too long to describe, or has
+ * more than CBPRINTF_PACKAGE_MAX_STR transient strings.
+ */
+__printf_like(3, 4)
+int cbprintf_package(void *packaged, size_t len, const char *format, ...);
+
+/** @brief Capture a format string and its arguments into a package.
+ *
+ * See cbprintf_package().
+ *
+ * @param packaged destination, aligned to at least 16 bits, or NULL to
+ * only calculate the package length.
+ *
+ * @param len size of @p packaged, ignored when it is NULL.
+ *
+ * @param format a standard ISO C format string with characters and
+ * conversion specifications.
+ *
+ * @param ap captured stack arguments corresponding to the conversion
+ * specifications found within @p format.
+ *
+ * @retval positive the length of the package in bytes.
+ * @retval -ENOSPC if @p packaged is too small.
+ * @retval -EINVAL if the package would be too long to describe, or has
+ * more than CBPRINTF_PACKAGE_MAX_STR transient strings.
+ */
+int cbvprintf_package(void *packaged, size_t len, const char *format,
+		      va_list ap);
+
+/** @brief Copy a package, appending copies of its transient strings.
+ *
+ * The result does not reference any transient string and can be kept
+ * after the strings have gone.  It can be relocated with memcpy().
+ *
+ * @param packaged package built with CBPRINTF_STATIC_PACKAGE() or
+ * cbprintf_package().
+ *
+ * @param out destination, aligned to at least 16 bits, or NULL to only
+ * calculate the length.
+ *
+ * @param len size of @p out.
+ *
+ * @retval positive the length of the copy in bytes.
+ * @retval -ENOSPC if @p out is too small.
+ * @retval -EINVAL if the copy would be too long to describe.
+ */
+int cbprintf_package_copy(const void *packaged, void *out, size_t len);
+
+/** @brief Generate the output for a package.
+ *
+ * The output is the same as cbprintf() would have generated when called
+ * with the format string and arguments captured in the package.
+ *
+ * @param out the function used to emit each generated character.
+ *
+ * @param ctx context provided when invoking out
+ *
+ * @param packaged package built with CBPRINTF_STATIC_PACKAGE() or copied
+ * with cbprintf_package_copy().
+ *
+ * @return the number of characters generated, or a negative error value
+ * returned from invoking @p out.
+ */
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged);
+
 /** @brief snprintf using Zephyrs cbprintf infrastructure.
  *
  * @note The functionality of this function is significantly reduced
@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CBPRINTF_INTERNAL_H_
+#define ZEPHYR_INCLUDE_SYS_CBPRINTF_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <toolchain.h>
+#include <sys/util_macro.h>
+
+/*
+ * Package layout, all offsets in bytes from the package start:
+ *
+ *   header     struct z_cbprintf_pkg_hdr
+ *   format     const char *, never copied
+ *   arguments  each argument after default promotion, back to back; as
+ *              every promoted type is a multiple of 4 bytes long each
+ *              argument starts on a 32-bit word offset
+ *   strings    one byte per string argument which is not in read only
+ *              memory: the word offset of that argument
+ *   copies     the strings listed above, NUL terminated, in the same
+ *              order; only present once the package has been copied
+ *              with cbprintf_package_copy()
+ *
+ * Values are stored unaligned with memcpy(), so only the header needs
+ * the package to be 16-bit aligned.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct z_cbprintf_pkg_hdr {
+	/* Package length in bytes, including copied strings */
+	uint16_t len;
+	/* Length of the header, format and arguments in 32-bit words */
+	uint8_t args_wlen;
+	/* Number of strings which need to be copied */
+	uint8_t str_cnt;
+};
+
+/* Offset of the first argument */
+#define Z_CBPRINTF_PKG_ARGS_OFFSET \
+	(sizeof(struct z_cbprintf_pkg_hdr) + sizeof(const char *))
+
+/* State while a package is being built */
+struct z_cbprintf_pkg_ctx {
+	uint8_t *pkg;
+	uint8_t *arg;
+	uint8_t *str;
+};
+
+bool z_cbprintf_is_rodata(const void *addr);
+
+const char *z_cbprintf_pkg_str_get(const uint8_t *pkg, const uint8_t *arg,
+				   const char *str);
+
+/* Fetch the next argument of @p type into @p dst, from the package when
+ * @p pkg_arg is not NULL and from @p ap otherwise.
+ */
+#define Z_CBPRINTF_ARG_PULL(ap, pkg_arg, dst, type) do { \
+	if ((pkg_arg) != NULL) { \
+		type _v; \
+		\
+		memcpy(&_v, (pkg_arg), sizeof(_v)); \
+		(pkg_arg) += sizeof(_v); \
+		(dst) = _v; \
+	} else { \
+		(dst) = va_arg(ap, type); \
+	} \
+} while (false)
+
+static inline void z_cbprintf_pkg_put_int(struct z_cbprintf_pkg_ctx *ctx,
+					  int v)
+{
+	memcpy(ctx->arg, &v, sizeof(v));
+	ctx->arg += sizeof(v);
+}
+
+static inline void z_cbprintf_pkg_put_long(struct z_cbprintf_pkg_ctx *ctx,
+					   long v)
+{
+	memcpy(ctx->arg, &v, sizeof(v));
+	ctx->arg += sizeof(v);
+}
+
+static inline void z_cbprintf_pkg_put_ll(struct z_cbprintf_pkg_ctx *ctx,
+					 long long v)
+{
+	memcpy(ctx->arg, &v, sizeof(v));
+	ctx->arg += sizeof(v);
+}
+
+static inline void z_cbprintf_pkg_put_double(struct z_cbprintf_pkg_ctx *ctx,
+					     double v)
+{
+	memcpy(ctx->arg, &v, sizeof(v));
+	ctx->arg += sizeof(v);
+}
+
+static inline void z_cbprintf_pkg_put_ldouble(struct z_cbprintf_pkg_ctx *ctx,
+					      long double v)
+{
+	memcpy(ctx->arg, &v, sizeof(v));
+	ctx->arg += sizeof(v);
+}
+
+static inline void z_cbprintf_pkg_put_ptr(struct z_cbprintf_pkg_ctx *ctx,
+					  const volatile void *v)
+{
+	const void *p = (const void *)(uintptr_t)v;
+
+	memcpy(ctx->arg, &p, sizeof(p));
+	ctx->arg += sizeof(p);
+}
+
+static inline void z_cbprintf_pkg_put_str(struct z_cbprintf_pkg_ctx *ctx,
+					  const char *v)
+{
+	if ((v != NULL) && !z_cbprintf_is_rodata(v)) {
+		*ctx->str++ = (uint8_t)((ctx->arg - ctx->pkg) /
+					sizeof(uint32_t));
+	}
+
+	z_cbprintf_pkg_put_ptr(ctx, v);
+}
+
+static inline void z_cbprintf_pkg_start(struct z_cbprintf_pkg_ctx *ctx,
+					uint8_t *pkg, size_t args_len,
+					const char *fmt)
+{
+	struct z_cbprintf_pkg_hdr *hdr = (struct z_cbprintf_pkg_hdr *)pkg;
+
+	hdr->args_wlen = (uint8_t)(args_len / sizeof(uint32_t));
+	ctx->pkg = pkg;
+	ctx->arg = pkg + sizeof(*hdr);
+	ctx->str = pkg + args_len;
+	z_cbprintf_pkg_put_ptr(ctx, fmt);
+}
+
+static inline void z_cbprintf_pkg_end(struct z_cbprintf_pkg_ctx *ctx)
+{
+	struct z_cbprintf_pkg_hdr *hdr = (struct z_cbprintf_pkg_hdr *)ctx->pkg;
+
+	hdr->len = (uint16_t)(ctx->str - ctx->pkg);
+	hdr->str_cnt = (uint8_t)(hdr->len - hdr->args_wlen * sizeof(uint32_t));
+}
+
+#ifdef __cplusplus
+}
+
+/* Overload resolution applies the default argument promotions, so one
+ * overload per promoted type gives both the stored size and the store
+ * function.
+ */
+extern "C++" {
+int z_cbprintf_cxx_promote(int v);
+unsigned int z_cbprintf_cxx_promote(unsigned int v);
+long z_cbprintf_cxx_promote(long v);
+unsigned long z_cbprintf_cxx_promote(unsigned long v);
+long long z_cbprintf_cxx_promote(long long v);
+unsigned long long z_cbprintf_cxx_promote(unsigned long long v);
+double z_cbprintf_cxx_promote(double v);
+long double z_cbprintf_cxx_promote(long double v);
+const void *z_cbprintf_cxx_promote(const volatile void *v);
+
+char (&z_cbprintf_cxx_is_str(char *v))[2];
+char (&z_cbprintf_cxx_is_str(const char *v))[2];
+template <typename T> char (&z_cbprintf_cxx_is_str(T v))[1];
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx, int v)
+{
+	z_cbprintf_pkg_put_int(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      unsigned int v)
+{
+	z_cbprintf_pkg_put_int(ctx, (int)v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx, long v)
+{
+	z_cbprintf_pkg_put_long(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      unsigned long v)
+{
+	z_cbprintf_pkg_put_long(ctx, (long)v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      long long v)
+{
+	z_cbprintf_pkg_put_ll(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      unsigned long long v)
+{
+	z_cbprintf_pkg_put_ll(ctx, (long long)v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      double v)
+{
+	z_cbprintf_pkg_put_double(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      long double v)
+{
+	z_cbprintf_pkg_put_ldouble(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      const volatile void *v)
+{
+	z_cbprintf_pkg_put_ptr(ctx, v);
+}
+
+static inline void z_cbprintf_cxx_put(struct z_cbprintf_pkg_ctx *ctx,
+				      const char *v)
+{
+	z_cbprintf_pkg_put_str(ctx, v);
+}
+}
+
+#define Z_CBPRINTF_ARG_SIZE(v) sizeof(z_cbprintf_cxx_promote(v))
+
+#define Z_CBPRINTF_IS_STR(v) (sizeof(z_cbprintf_cxx_is_str(v)) - 1)
+
+#define Z_CBPRINTF_PKG_PUT_ARG(v, ctx) z_cbprintf_cxx_put(ctx, v)
+
+#else /* __cplusplus */
+
+/* Size of an argument after the default argument promotions */
+#define Z_CBPRINTF_ARG_SIZE(v) _Generic((v), \
+	char : sizeof(int), \
+	signed char : sizeof(int), \
+	unsigned char : sizeof(int), \
+	short : sizeof(int), \
+	unsigned short : sizeof(int), \
+	_Bool : sizeof(int), \
+	int : sizeof(int), \
+	unsigned int : sizeof(int), \
+	long : sizeof(long), \
+	unsigned long : sizeof(long), \
+	long long : sizeof(long long), \
+	unsigned long long : sizeof(long long), \
+	float : sizeof(double), \
+	double : sizeof(double), \
+	long double : sizeof(long double), \
+	default : sizeof(void *))
+
+/* 1 for arguments which may need to be copied into the package */
+#define Z_CBPRINTF_IS_STR(v) _Generic((v), \
+	char * : 1, \
+	const char * : 1, \
+	default : 0)
+
+#define Z_CBPRINTF_PKG_PUT_ARG(v, ctx) _Generic((v), \
+	char : z_cbprintf_pkg_put_int, \
+	signed char : z_cbprintf_pkg_put_int, \
+	unsigned char : z_cbprintf_pkg_put_int, \
+	short : z_cbprintf_pkg_put_int, \
+	unsigned short : z_cbprintf_pkg_put_int, \
+	_Bool : z_cbprintf_pkg_put_int, \
+	int : z_cbprintf_pkg_put_int, \
+	unsigned int : z_cbprintf_pkg_put_int, \
+	long : z_cbprintf_pkg_put_long, \
+	unsigned long : z_cbprintf_pkg_put_long, \
+	long long : z_cbprintf_pkg_put_ll, \
+	unsigned long long : z_cbprintf_pkg_put_ll, \
+	float : z_cbprintf_pkg_put_double, \
+	double : z_cbprintf_pkg_put_double, \
+	long double : z_cbprintf_pkg_put_ldouble, \
+	char * : z_cbprintf_pkg_put_str, \
+	const char * : z_cbprintf_pkg_put_str, \
+	default : z_cbprintf_pkg_put_ptr)(ctx, v)
+
+#endif /* __cplusplus */
+
+/* Size of the arguments following the format string */
+#define Z_CBPRINTF_PKG_ARGS_SIZE(...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+		    (0), \
+		    (FOR_EACH(Z_CBPRINTF_ARG_SIZE, (+), \
+			      GET_ARGS_LESS_N(1, __VA_ARGS__))))
+
+/* Upper bound on the number of strings which need to be copied */
+#define Z_CBPRINTF_PKG_STR_CNT(...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+		    (0), \
+		    (FOR_EACH(Z_CBPRINTF_IS_STR, (+), \
+			      GET_ARGS_LESS_N(1, __VA_ARGS__))))
+
+#define Z_CBPRINTF_STATIC_PACKAGE_SIZE(...) \
+	(Z_CBPRINTF_PKG_ARGS_OFFSET + Z_CBPRINTF_PKG_ARGS_SIZE(__VA_ARGS__) + \
+	 Z_CBPRINTF_PKG_STR_CNT(__VA_ARGS__))
+
+#define Z_CBPRINTF_STATIC_PACKAGE(packaged, ...) do { \
+	struct z_cbprintf_pkg_ctx _pctx; \
+	\
+	BUILD_ASSERT((Z_CBPRINTF_PKG_ARGS_OFFSET + \
+		      Z_CBPRINTF_PKG_ARGS_SIZE(__VA_ARGS__)) <= \
+		     (UINT8_MAX * sizeof(uint32_t)), \
+		     "Too many arguments to package"); \
+	z_cbprintf_pkg_start(&_pctx, (uint8_t *)(packaged), \
+			     Z_CBPRINTF_PKG_ARGS_OFFSET + \
+			     Z_CBPRINTF_PKG_ARGS_SIZE(__VA_ARGS__), \
+			     GET_ARG_N(1, __VA_ARGS__)); \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+		    (), \
+		    (FOR_EACH_FIXED_ARG(Z_CBPRINTF_PKG_PUT_ARG, (;), &_pctx, \
+					GET_ARGS_LESS_N(1, __VA_ARGS__));)) \
+	z_cbprintf_pkg_end(&_pctx); \
+} while (false)
+
+#endif /* ZEPHYR_INCLUDE_SYS_CBPRINTF_INTERNAL_H_ */
@@ -67,7 +67,9 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable);
  * @brief Release reserved file descriptor.
  *
  * This function may be called once after z_reserve_fd(), and should
- * not be called in any other case.
+ * not be called in any other case. The descriptor becomes invalid
+ * immediately, but is only reused once operations in progress on it
+ * through read(), write(), etc. have returned.
  *
  * @param fd File descriptor previously returned by z_reserve_fd()
  */
@@ -83,6 +85,9 @@ void z_free_fd(int fd);
  * but vtable param is not NULL and doesn't match object's vtable,
  * NULL is returned and errno set to err param.
  *
+ * The lookup is lock-free and does not take a reference, the caller
+ * must ensure the object is not concurrently closed.
+ *
  * @param fd File descriptor previously returned by z_reserve_fd()
  * @param vtable Expected object vtable or NULL
  * @param err errno value to set if object vtable doesn't match
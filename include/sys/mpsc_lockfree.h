@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free intrusive multi-producer single-consumer queue
+ *
+ * Any number of producers (threads or ISRs, on any CPU) may push nodes
+ * concurrently without taking a lock; a push is one atomic exchange
+ * plus one atomic store.  Only a single consumer may pop at a time.
+ * Nodes come out in the order their pushes took effect.
+ *
+ * This is the classic stub-node queue: producers append at the head,
+ * the consumer removes at the tail.  A producer that is preempted
+ * between its exchange and the store that links its node makes the
+ * queue look empty to the consumer (sys_mpsc_pop() returns NULL) until
+ * it resumes, even if other nodes were pushed after it.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct _mpsc_node {
+	atomic_ptr_t next;
+};
+
+typedef struct _mpsc_node sys_mpsc_node_t;
+
+struct _mpsc {
+	/* Most recently pushed node, written by producers */
+	atomic_ptr_t head;
+	/* Oldest node, only touched by the consumer */
+	sys_mpsc_node_t *tail;
+	/* Placeholder keeping the queue non-empty */
+	sys_mpsc_node_t stub;
+};
+
+typedef struct _mpsc sys_mpsc_t;
+
+/**
+ * @brief Statically initialize an MPSC queue
+ *
+ * @param ptr_to_q A pointer to the sys_mpsc_t being initialized
+ */
+#define SYS_MPSC_STATIC_INIT(ptr_to_q) \
+	{ \
+	.head = &(ptr_to_q)->stub, \
+	.tail = &(ptr_to_q)->stub, \
+	.stub = { .next = NULL }, \
+	}
+
+/**
+ * @brief Initialize an MPSC queue
+ *
+ * Must not be called while producers or the consumer may be using
+ * the queue.
+ *
+ * @param q A pointer to the queue to initialize
+ */
+static inline void sys_mpsc_init(sys_mpsc_t *q)
+{
+	q->stub.next = NULL;
+	q->tail = &q->stub;
+	(void)atomic_ptr_set(&q->head, &q->stub);
+}
+
+/**
+ * @brief Push a node onto an MPSC queue
+ *
+ * Safe to call concurrently from any number of threads and ISRs.
+ *
+ * @param q A pointer to the queue
+ * @param n A pointer to the node to push, not currently in any queue
+ */
+static inline void sys_mpsc_push(sys_mpsc_t *q, sys_mpsc_node_t *n)
+{
+	sys_mpsc_node_t *prev;
+
+	n->next = NULL;
+	prev = atomic_ptr_set(&q->head, n);
+	(void)atomic_ptr_set(&prev->next, n);
+}
+
+/**
+ * @brief Pop the oldest node from an MPSC queue
+ *
+ * Must only be called by one consumer at a time.
+ *
+ * @param q A pointer to the queue
+ *
+ * @return The oldest node, or NULL if the queue is empty or the only
+ *         nodes left are still being linked in by a producer
+ */
+static inline sys_mpsc_node_t *sys_mpsc_pop(sys_mpsc_t *q)
+{
+	sys_mpsc_node_t *tail = q->tail;
+	sys_mpsc_node_t *next = atomic_ptr_get(&tail->next);
+
+	if (tail == &q->stub) {
+		if (next == NULL) {
+			return NULL;
+		}
+		q->tail = next;
+		tail = next;
+		next = atomic_ptr_get(&next->next);
+	}
+
+	if (next != NULL) {
+		q->tail = next;
+		return tail;
+	}
+
+	/* tail is the last linked node.  If it is not also the head a
+	 * producer is half way through a push; come back later.
+	 */
+	if (tail != atomic_ptr_get(&q->head)) {
+		return NULL;
+	}
+
+	/* Put the stub back behind the last node so it can be handed out */
+	sys_mpsc_push(q, &q->stub);
+
+	next = atomic_ptr_get(&tail->next);
+	if (next != NULL) {
+		q->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Test whether an MPSC queue is empty
+ *
+ * Only meaningful when called by the consumer.
+ *
+ * @param q A pointer to the queue
+ *
+ * @return true if no node is waiting to be popped
+ */
+static inline bool sys_mpsc_is_empty(sys_mpsc_t *q)
+{
+	return q->tail == &q->stub && atomic_ptr_get(&q->stub.next) == NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_ */
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Multi-producer, single-consumer packet buffer
+ *
+ * Variable length packets are allocated in place from one contiguous
+ * array of 32-bit words.  Any number of producers (threads or ISRs, on
+ * any CPU) may allocate and commit packets; a single consumer claims
+ * them in allocation order and frees them once processed.
+ *
+ * Producers hold the buffer lock only to reserve space and to mark a
+ * packet as committed; the packet is filled in without any lock held.
+ * A packet which has been allocated but not yet committed stops the
+ * consumer until its producer commits it.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+
+#include <spinlock.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multi-producer, single-consumer packet buffer
+ * @defgroup mpsc_pbuf MPSC packet buffer
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** @brief Drop the oldest packets when there is no room for a new one. */
+#define MPSC_PBUF_MODE_OVERWRITE BIT(0)
+
+/** @brief Packet header, managed by the buffer. */
+struct mpsc_pbuf_hdr {
+	/** Set once the producer has committed the packet. */
+	uint32_t valid : 1;
+	/** Set while the consumer holds the packet. */
+	uint32_t busy : 1;
+	/** Padding inserted before the buffer end, never handed out. */
+	uint32_t skip : 1;
+	/** Packet length in 32-bit words, including this header. */
+	uint32_t len : 29;
+};
+
+/**
+ * @brief Generic packet
+ *
+ * Every packet stored in the buffer starts with this header word.
+ * Users define their own packet type with it as the first member.
+ */
+union mpsc_pbuf_generic {
+	struct mpsc_pbuf_hdr hdr;
+	uint32_t raw;
+};
+
+struct mpsc_pbuf_buffer;
+
+/**
+ * @brief Callback for packets dropped to make room in overwrite mode
+ *
+ * Called with the buffer lock held, so it must be short.
+ *
+ * @param buffer Buffer the packet was dropped from.
+ * @param item Dropped packet.
+ */
+typedef void (*mpsc_pbuf_notify_drop)(const struct mpsc_pbuf_buffer *buffer,
+				      const union mpsc_pbuf_generic *item);
+
+/** @brief Packet buffer configuration. */
+struct mpsc_pbuf_buffer_config {
+	/** Storage, aligned to 32 bits. */
+	uint32_t *buf;
+	/** Storage size in 32-bit words. */
+	uint32_t size;
+	/** Optional callback for packets dropped in overwrite mode. */
+	mpsc_pbuf_notify_drop notify_drop;
+	/** MPSC_PBUF_MODE_* flags. */
+	uint32_t flags;
+};
+
+/** @brief Packet buffer. */
+struct mpsc_pbuf_buffer {
+	/** Index of the next word to allocate. */
+	uint32_t wr_idx;
+	/** Index of the oldest word still in use. */
+	uint32_t rd_idx;
+	/** Highest number of words in use at once. */
+	uint32_t max_usage;
+	uint32_t flags;
+	struct k_spinlock lock;
+	mpsc_pbuf_notify_drop notify_drop;
+	uint32_t *buf;
+	uint32_t size;
+};
+
+/**
+ * @brief Initialize a packet buffer
+ *
+ * @param buffer Buffer to initialize.
+ * @param config Configuration, not referenced after the call.
+ */
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
+		    const struct mpsc_pbuf_buffer_config *config);
+
+/**
+ * @brief Allocate a packet
+ *
+ * Never blocks, so it may be called from an ISR.  In overwrite mode the
+ * oldest committed packets which are not held by the consumer are
+ * dropped until the new packet fits.
+ *
+ * @param buffer Buffer.
+ * @param wlen Packet length in 32-bit words, including the header.
+ *
+ * @return Packet with its header initialized, or NULL if there is no
+ *	   room for it.
+ */
+union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
+					 size_t wlen);
+
+/**
+ * @brief Commit a packet, making it visible to the consumer
+ *
+ * @param buffer Buffer.
+ * @param item Packet returned by mpsc_pbuf_alloc().
+ */
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
+		      union mpsc_pbuf_generic *item);
+
+/**
+ * @brief Claim the oldest packet
+ *
+ * Only one packet may be claimed at a time and it must be freed before
+ * the next claim.
+ *
+ * @param buffer Buffer.
+ *
+ * @return Oldest packet, or NULL if the buffer is empty or the oldest
+ *	   packet has not been committed yet.
+ */
+const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer);
+
+/**
+ * @brief Free a claimed packet
+ *
+ * @param buffer Buffer.
+ * @param item Packet returned by mpsc_pbuf_claim().
+ */
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
+		    const union mpsc_pbuf_generic *item);
+
+/**
+ * @brief Check whether any packet is allocated
+ *
+ * @param buffer Buffer.
+ *
+ * @return true if the buffer holds at least one packet, committed or not.
+ */
+bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer);
+
+/**
+ * @brief Get buffer usage
+ *
+ * @param buffer Buffer.
+ * @param size Set to the storage size in bytes.
+ * @param now Set to the number of bytes currently in use.
+ * @param max Set to the highest number of bytes in use at once.
+ */
+void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
+			       uint32_t *size, uint32_t *now, uint32_t *max);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_ */
@@ -14,6 +14,7 @@
 #include <sys/util.h>
 #include <errno.h>
 #include <string.h>
+#include <sys/atomic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -406,6 +407,212 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size);
  */
 uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup spsc_ring_buffer_apis Single Producer Single Consumer Ring Buffer APIs
+ * @ingroup ring_buffer_apis
+ * @{
+ *
+ * Byte ring buffer which may be used without locking by one producer and
+ * one consumer, each possibly running on a different CPU or in an ISR.
+ * Indexes are published with release semantics and read with acquire
+ * semantics, and the producer and consumer indexes are kept in separate
+ * cache lines. The size must be a power of 2.
+ *
+ * Producer functions (put) must not be called concurrently with each
+ * other, and neither must consumer functions (get).
+ */
+
+#if defined(CONFIG_CACHE_LINE_SIZE) && (CONFIG_CACHE_LINE_SIZE > 0)
+#define SPSC_RING_BUF_ALIGN CONFIG_CACHE_LINE_SIZE
+#else
+#define SPSC_RING_BUF_ALIGN 64
+#endif
+
+/**
+ * @brief A structure to represent a single producer single consumer ring
+ * buffer
+ */
+struct spsc_ring_buf {
+	uint8_t *data;	/**< Memory region for stored bytes */
+	uint32_t mask;	/**< Size of data minus 1 */
+
+	/** Producer state */
+	struct spsc_ring_buf_prod {
+		atomic_t wr_idx;	/**< Published write index */
+		uint32_t tmp_wr_idx;	/**< Write index including claims */
+		uint32_t rd_idx;	/**< Last read index seen */
+	} prod __aligned(SPSC_RING_BUF_ALIGN);
+
+	/** Consumer state */
+	struct spsc_ring_buf_cons {
+		atomic_t rd_idx;	/**< Published read index */
+		uint32_t tmp_rd_idx;	/**< Read index including claims */
+		uint32_t wr_idx;	/**< Last write index seen */
+	} cons __aligned(SPSC_RING_BUF_ALIGN);
+};
+
+/**
+ * @brief Statically define and initialize a single producer single consumer
+ * ring buffer.
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), must be a power of 2.
+ */
+#define SPSC_RING_BUF_DECLARE(name, size8) \
+	BUILD_ASSERT(((size8) & ((size8) - 1)) == 0, \
+		     "Size must be a power of 2"); \
+	BUILD_ASSERT(size8 < RING_BUFFER_MAX_SIZE, \
+		     RING_BUFFER_SIZE_ASSERT_MSG); \
+	static uint8_t _spsc_ring_buf_data_##name[size8]; \
+	struct spsc_ring_buf name = { \
+		.data = _spsc_ring_buf_data_##name, \
+		.mask = (size8) - 1 \
+	}
+
+/**
+ * @brief Initialize a single producer single consumer ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Ring buffer size in bytes, must be a power of 2.
+ * @param data Ring buffer data area.
+ */
+static inline void spsc_ring_buf_init(struct spsc_ring_buf *buf,
+				      uint32_t size, uint8_t *data)
+{
+	__ASSERT(size < RING_BUFFER_MAX_SIZE, RING_BUFFER_SIZE_ASSERT_MSG);
+	__ASSERT(is_power_of_two(size), "Size must be a power of 2");
+
+	memset(buf, 0, sizeof(struct spsc_ring_buf));
+	buf->data = data;
+	buf->mask = size - 1U;
+}
+
+/**
+ * @brief Return ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline uint32_t spsc_ring_buf_capacity_get(struct spsc_ring_buf *buf)
+{
+	return buf->mask + 1U;
+}
+
+/**
+ * @brief Determine free space in a ring buffer.
+ *
+ * Producer side only.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+uint32_t spsc_ring_buf_space_get(struct spsc_ring_buf *buf);
+
+/**
+ * @brief Determine amount of data in a ring buffer.
+ *
+ * Consumer side only.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Number of bytes which can be read.
+ */
+uint32_t spsc_ring_buf_size_get(struct spsc_ring_buf *buf);
+
+/**
+ * @brief Allocate buffer for writing data to a ring buffer.
+ *
+ * Same as ring_buf_put_claim(): the returned area is contiguous, so it
+ * may be shorter than @a size at the end of the buffer. Several claims may
+ * precede a call to spsc_ring_buf_put_finish(). Producer side only.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+uint32_t spsc_ring_buf_put_claim(struct spsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Make written data available to the consumer.
+ *
+ * Claims beyond @a size are released. Producer side only.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Number of valid bytes in the claimed buffers.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds claimed size.
+ */
+int spsc_ring_buf_put_finish(struct spsc_ring_buf *buf, uint32_t size);
+
+/**
+ * @brief Write (copy) data to a ring buffer.
+ *
+ * Producer side only.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t spsc_ring_buf_put(struct spsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Get address of valid data in a ring buffer.
+ *
+ * Same as ring_buf_get_claim(), consumer side only.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough data or buffer wraps.
+ */
+uint32_t spsc_ring_buf_get_claim(struct spsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Release read data to the producer.
+ *
+ * Claims beyond @a size are given back. Consumer side only.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds claimed size.
+ */
+int spsc_ring_buf_get_finish(struct spsc_ring_buf *buf, uint32_t size);
+
+/**
+ * @brief Read data from a ring buffer.
+ *
+ * Consumer side only.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+uint32_t spsc_ring_buf_get(struct spsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size);
+
 /**
  * @}
  */
@@ -118,6 +118,21 @@ void *sys_heap_aligned_alloc(struct sys_heap *h, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *h, void *mem);
 
+/** @brief Return the usable size of an allocated block
+ *
+ * Returns the number of bytes actually available to the caller in a
+ * block returned from sys_heap_alloc() or sys_heap_aligned_alloc(),
+ * which may be larger than the size originally requested.  Only the
+ * header of the block itself is read, so this may be called without
+ * holding the lock protecting the heap as long as the caller owns
+ * @a mem.
+ *
+ * @param h Heap from which the memory was allocated
+ * @param mem A pointer previously returned from sys_heap_alloc()
+ * @return Number of usable bytes at @a mem
+ */
+size_t sys_heap_usable_size(struct sys_heap *h, void *mem);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
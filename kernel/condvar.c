@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel condition variable object.
+ *
+ * Waiters pend directly on the condition variable's wait queue, so a
+ * signal wakes exactly one thread (the highest priority waiter) and
+ * never disturbs the others.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/object_tracing_common.h>
+#include <toolchain.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <init.h>
+#include <syscall_handler.h>
+
+static struct k_spinlock lock;
+
+#ifdef CONFIG_OBJECT_TRACING
+
+struct k_condvar *_trace_list_k_condvar;
+
+/*
+ * Complete initialization of statically defined condition variables.
+ */
+static int init_condvar_module(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	Z_STRUCT_SECTION_FOREACH(k_condvar, condvar) {
+		SYS_TRACING_OBJ_INIT(k_condvar, condvar);
+	}
+	return 0;
+}
+
+SYS_INIT(init_condvar_module, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+#endif /* CONFIG_OBJECT_TRACING */
+
+int z_impl_k_condvar_init(struct k_condvar *condvar)
+{
+	z_waitq_init(&condvar->wait_q);
+	SYS_TRACING_OBJ_INIT(k_condvar, condvar);
+	z_object_init(condvar);
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_condvar_init(struct k_condvar *condvar)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(condvar, K_OBJ_CONDVAR));
+	return z_impl_k_condvar_init(condvar);
+}
+#include <syscalls/k_condvar_init_mrsh.c>
+#endif
+
+int z_impl_k_condvar_signal(struct k_condvar *condvar)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *thread = z_unpend_first_thread(&condvar->wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_condvar_signal(struct k_condvar *condvar)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(condvar, K_OBJ_CONDVAR));
+	return z_impl_k_condvar_signal(condvar);
+}
+#include <syscalls/k_condvar_signal_mrsh.c>
+#endif
+
+int z_impl_k_condvar_broadcast(struct k_condvar *condvar)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int woken = 0;
+
+	while ((thread = z_unpend_first_thread(&condvar->wait_q)) != NULL) {
+		woken++;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	z_reschedule(&lock, key);
+
+	return woken;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_condvar_broadcast(struct k_condvar *condvar)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(condvar, K_OBJ_CONDVAR));
+	return z_impl_k_condvar_broadcast(condvar);
+}
+#include <syscalls/k_condvar_broadcast_mrsh.c>
+#endif
+
+int z_impl_k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
+			  k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	/* The mutex is released with the condition variable lock held,
+	 * so a signal issued by the next owner cannot slip in before we
+	 * are on the wait queue.
+	 */
+	key = k_spin_lock(&lock);
+	k_mutex_unlock(mutex);
+
+	ret = z_pend_curr(&lock, key, &condvar->wait_q, timeout);
+	k_mutex_lock(mutex, K_FOREVER);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
+			  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(condvar, K_OBJ_CONDVAR));
+	Z_OOPS(Z_SYSCALL_OBJ(mutex, K_OBJ_MUTEX));
+	return z_impl_k_condvar_wait(condvar, mutex, timeout);
+}
+#include <syscalls/k_condvar_wait_mrsh.c>
+#endif
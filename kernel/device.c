@@ -25,12 +25,250 @@ extern const struct device __device_end[];
 
 extern uint32_t __device_init_status_start[];
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+/* Slots hold a device index plus one, zero marks an empty slot */
+extern uint16_t __device_name_hash_start[];
+extern uint16_t __device_name_hash_end[];
+#define DEVICE_NAME_HASH_SLOTS \
+	((size_t)(__device_name_hash_end - __device_name_hash_start))
+#endif
+
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 extern uint32_t __device_busy_start[];
 extern uint32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+/* 32-bit FNV-1a */
+static uint32_t device_name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/*
+ * Devices are inserted in link order, so among devices sharing a name
+ * the probe sequence meets them in the order the linear search used to.
+ */
+static void device_name_hash_init(void)
+{
+	size_t slots = DEVICE_NAME_HASH_SLOTS;
+	const struct device *dev;
+
+	for (dev = __device_start; dev != __device_end; dev++) {
+		size_t i = device_name_hash(dev->name) % slots;
+
+		while (__device_name_hash_start[i] != 0U) {
+			i = (i + 1) % slots;
+		}
+		__device_name_hash_start[i] = (dev - __device_start) + 1;
+	}
+}
+
+static const struct device *device_name_hash_find(const char *name)
+{
+	size_t slots = DEVICE_NAME_HASH_SLOTS;
+	size_t i;
+
+	if (slots == 0) {
+		return NULL;
+	}
+
+	/* There are twice as many slots as devices, so the probe always
+	 * ends on an empty slot.
+	 */
+	for (i = device_name_hash(name) % slots;
+	     __device_name_hash_start[i] != 0U; i = (i + 1) % slots) {
+		const struct device *dev =
+			&__device_start[__device_name_hash_start[i] - 1];
+
+		if (z_device_ready(dev) &&
+		    ((dev->name == name) || (strcmp(name, dev->name) == 0))) {
+			return dev;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+static int init_entry_call(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+	int rc;
+
+	if (dev != NULL) {
+		z_object_init(dev);
+	}
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	entry->timing->start = k_cycle_get_32();
+#endif
+
+	rc = entry->init(dev);
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	entry->timing->end = k_cycle_get_32();
+#endif
+
+	return rc;
+}
+
+static void init_entry_status(const struct init_entry *entry, int rc)
+{
+	const struct device *dev = entry->dev;
+
+	if ((rc != 0) && (dev != NULL)) {
+		/* Initialization failed.
+		 * Set the init status bit so device is not declared ready.
+		 */
+		sys_bitfield_set_bit((mem_addr_t) __device_init_status_start,
+				     (dev - __device_start));
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define INIT_RUNNERS (CONFIG_DEVICE_INIT_PARALLEL_THREADS + 1)
+
+static K_KERNEL_STACK_ARRAY_DEFINE(init_stacks,
+				   CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+
+static struct {
+	struct k_mutex lock;
+	struct k_condvar cond;
+	/* Next entry to start, and end of the level */
+	const struct init_entry *next;
+	const struct init_entry *end;
+	/* Entry each runner is working on, or NULL. Runner 0 is the
+	 * thread running the init level, the others are init_threads.
+	 */
+	const struct init_entry *running[INIT_RUNNERS];
+	/* An entry without dependency information is running */
+	bool barrier;
+} init_pool;
+
+static bool init_pool_idle(void)
+{
+	for (int i = 0; i < INIT_RUNNERS; i++) {
+		if (init_pool.running[i] != NULL) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool init_deps_running(const struct init_entry *entry)
+{
+	for (int i = 0; i < INIT_RUNNERS; i++) {
+		const struct init_entry *other = init_pool.running[i];
+
+		if ((other == NULL) || (other == entry)) {
+			continue;
+		}
+
+		for (const uint16_t *ord = entry->requires;
+		     *ord != Z_INIT_ORD_NONE; ord++) {
+			if (*ord == other->ord) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Entries are started in link order, one at a time. Devicetree devices
+ * may then run concurrently with each other: one only waits for the
+ * entries it requires, all of which were started before it if they are
+ * at this level at all. Anything else (SYS_INIT() functions, devices
+ * without a devicetree node) knows nothing of its dependencies, so it
+ * waits for every running entry to finish and runs on its own.
+ */
+static void init_runner(int id)
+{
+	k_mutex_lock(&init_pool.lock, K_FOREVER);
+
+	while (init_pool.next < init_pool.end) {
+		const struct init_entry *entry = init_pool.next;
+		int rc;
+
+		if (init_pool.barrier ||
+		    ((entry->requires == NULL) && !init_pool_idle())) {
+			k_condvar_wait(&init_pool.cond, &init_pool.lock,
+				       K_FOREVER);
+			continue;
+		}
+
+		init_pool.next++;
+		init_pool.running[id] = entry;
+		init_pool.barrier = (entry->requires == NULL);
+
+		while ((entry->requires != NULL) && init_deps_running(entry)) {
+			k_condvar_wait(&init_pool.cond, &init_pool.lock,
+				       K_FOREVER);
+		}
+
+		k_mutex_unlock(&init_pool.lock);
+		rc = init_entry_call(entry);
+		k_mutex_lock(&init_pool.lock, K_FOREVER);
+
+		init_entry_status(entry, rc);
+		init_pool.running[id] = NULL;
+		init_pool.barrier = false;
+		k_condvar_broadcast(&init_pool.cond);
+	}
+
+	k_mutex_unlock(&init_pool.lock);
+}
+
+static void init_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	init_runner(POINTER_TO_INT(p1));
+}
+
+static void init_run_parallel(const struct init_entry *start,
+			      const struct init_entry *end)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_mutex_init(&init_pool.lock);
+	k_condvar_init(&init_pool.cond);
+	init_pool.next = start;
+	init_pool.end = end;
+
+	/* The helper threads only live for the duration of the level and
+	 * run at the priority of the thread doing the initialization.
+	 */
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_KERNEL_STACK_SIZEOF(init_stacks[i]),
+				init_thread_entry, INT_TO_POINTER(i + 1),
+				NULL, NULL, prio, 0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "init");
+	}
+
+	init_runner(0);
+
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -40,6 +278,9 @@ extern uint32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, levels after the kernel is up are
+ * run by a pool of threads instead, see init_runner().
+ *
  * @param level init level to run.
  */
 void z_sys_init_run_level(int32_t level)
@@ -57,26 +298,36 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
-	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (level == _SYS_INIT_LEVEL_PRE_KERNEL_1) {
+		device_name_hash_init();
+	}
+#endif
 
-		if (dev != NULL) {
-			z_object_init(dev);
-		}
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if ((level >= _SYS_INIT_LEVEL_POST_KERNEL) &&
+	    ((levels[level+1] - levels[level]) > 1)) {
+		init_run_parallel(levels[level], levels[level+1]);
+		return;
+	}
+#endif
 
-		if ((entry->init(dev) != 0) && (dev != NULL)) {
-			/* Initialization failed.
-			 * Set the init status bit so device is not declared ready.
-			 */
-			sys_bitfield_set_bit(
-				(mem_addr_t) __device_init_status_start,
-				(dev - __device_start));
-		}
+	for (entry = levels[level]; entry < levels[level+1]; entry++) {
+		init_entry_status(entry, init_entry_call(entry));
 	}
 }
 
+size_t z_init_get_all_static(const struct init_entry **entries)
+{
+	*entries = __init_start;
+	return __init_end - __init_start;
+}
+
 const struct device *z_impl_device_get_binding(const char *name)
 {
+#ifdef CONFIG_DEVICE_NAME_HASH
+	return device_name_hash_find(name);
+#else
 	const struct device *dev;
 
 	/* Split the search into two loops: in the common scenario, where
@@ -97,6 +348,7 @@ const struct device *z_impl_device_get_binding(const char *name)
 	}
 
 	return NULL;
+#endif /* CONFIG_DEVICE_NAME_HASH */
 }
 
 #ifdef CONFIG_USERSPACE
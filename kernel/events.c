@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * An event object holds a set of 32 events.  Threads wait for any or
+ * all of a subset of them; setting events only wakes the waiters whose
+ * condition became true, everybody else stays on the wait queue.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/object_tracing_common.h>
+#include <toolchain.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <init.h>
+#include <syscall_handler.h>
+
+/* Per-waiter state, lives on the waiting thread's stack and is found
+ * through its swap_data while the thread is pended.
+ */
+struct event_waiter {
+	uint32_t events;
+	uint32_t options;
+	uint32_t matched;
+	/* Next waiter being woken by the same k_event_set() */
+	struct k_thread *next;
+};
+
+static struct k_spinlock lock;
+
+#ifdef CONFIG_OBJECT_TRACING
+
+struct k_event *_trace_list_k_event;
+
+/*
+ * Complete initialization of statically defined event objects.
+ */
+static int init_event_module(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	Z_STRUCT_SECTION_FOREACH(k_event, event) {
+		SYS_TRACING_OBJ_INIT(k_event, event);
+	}
+	return 0;
+}
+
+SYS_INIT(init_event_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+#endif /* CONFIG_OBJECT_TRACING */
+
+/* Returns the requested events that satisfy the wait, or 0 */
+static uint32_t events_match(uint32_t current, uint32_t desired,
+			     uint32_t options)
+{
+	uint32_t match = current & desired;
+
+	if ((options & K_EVENT_WAIT_ALL) != 0U) {
+		return (match == desired) ? match : 0U;
+	}
+
+	return match;
+}
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	z_waitq_init(&event->wait_q);
+	SYS_TRACING_OBJ_INIT(k_event, event);
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_init(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init(event);
+}
+#include <syscalls/k_event_init_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_set(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t previous = event->events;
+	uint32_t consumed = 0U;
+	struct k_thread *wake = NULL;
+	struct k_thread *thread;
+
+	event->events |= events;
+
+	/* Waiters are visited in priority order, and events consumed by
+	 * a K_EVENT_WAIT_CLEAR waiter are no longer visible to the ones
+	 * after it.  The satisfied waiters are chained through their
+	 * waiter records since the wait queue cannot be modified while
+	 * it is walked.
+	 */
+	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+		struct event_waiter *w = thread->base.swap_data;
+
+		w->matched = events_match(event->events & ~consumed,
+					  w->events, w->options);
+		if (w->matched != 0U) {
+			w->next = wake;
+			wake = thread;
+			if ((w->options & K_EVENT_WAIT_CLEAR) != 0U) {
+				consumed |= w->matched;
+			}
+		}
+	}
+
+	while (wake != NULL) {
+		struct event_waiter *w = wake->base.swap_data;
+
+		thread = wake;
+		wake = w->next;
+
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	event->events &= ~consumed;
+
+	z_reschedule(&lock, key);
+
+	return previous;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_set(struct k_event *event,
+					  uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_set(event, events);
+}
+#include <syscalls/k_event_set_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_clear(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t previous = event->events;
+
+	event->events &= ~events;
+	k_spin_unlock(&lock, key);
+
+	return previous;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_clear(struct k_event *event,
+					    uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_clear(event, events);
+}
+#include <syscalls/k_event_clear_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_wait(struct k_event *event, uint32_t events,
+			     uint32_t options, k_timeout_t timeout)
+{
+	struct event_waiter waiter = {
+		.events = events,
+		.options = options,
+	};
+	k_spinlock_key_t key;
+	uint32_t matched;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	key = k_spin_lock(&lock);
+
+	matched = events_match(event->events, events, options);
+	if (matched != 0U) {
+		if ((options & K_EVENT_WAIT_CLEAR) != 0U) {
+			event->events &= ~matched;
+		}
+		k_spin_unlock(&lock, key);
+		return matched;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || events == 0U) {
+		k_spin_unlock(&lock, key);
+		return 0U;
+	}
+
+	_current->base.swap_data = &waiter;
+	if (z_pend_curr(&lock, key, &event->wait_q, timeout) != 0) {
+		return 0U;
+	}
+
+	return waiter.matched;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_wait(struct k_event *event,
+					   uint32_t events, uint32_t options,
+					   k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_wait(event, events, options, timeout);
+}
+#include <syscalls/k_event_wait_mrsh.c>
+#endif
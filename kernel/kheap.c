@@ -8,11 +8,16 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <init.h>
+#include <string.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_HEAP_CPU_CACHE
+	atomic_set(&h->cache_bypass, 0);
+	(void)memset(h->cpu_cache, 0, sizeof(h->cpu_cache));
+#endif
 }
 
 static int statics_init(const struct device *unused)
@@ -26,17 +31,230 @@ static int statics_init(const struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+/* Magazine-style front end.  Each CPU keeps, per power-of-two size
+ * class, a small stack of free blocks of exactly that class size.
+ * Allocations and frees that hit the local stack only take the
+ * (uncontended) lock of that CPU's cache; misses refill or drain
+ * half a magazine at a time under the heap lock.  Lock order is
+ * always cache lock, then heap lock.
+ */
+
+#define CACHE_MIN_SHIFT 4 /* smallest class holds 16 bytes */
+#define CACHE_CLASSES CONFIG_HEAP_CPU_CACHE_CLASSES
+#define CACHE_DEPTH CONFIG_HEAP_CPU_CACHE_DEPTH
+#define CACHE_BATCH (CACHE_DEPTH / 2)
+
+static inline size_t class_size(int cls)
+{
+	return (size_t)1 << (cls + CACHE_MIN_SHIFT);
+}
+
+/* Smallest class whose blocks fit @bytes, or -1 if too large */
+static int alloc_class(size_t bytes)
+{
+	if (bytes > class_size(CACHE_CLASSES - 1)) {
+		return -1;
+	}
+	if (bytes <= class_size(0)) {
+		return 0;
+	}
+	return 32 - __builtin_clz((uint32_t)bytes - 1U) - CACHE_MIN_SHIFT;
+}
+
+/* Class a free block of @usable bytes can serve, or -1 if it should
+ * go straight back to the heap
+ */
+static int free_class(size_t usable)
+{
+	if (usable < class_size(0) ||
+	    usable >= 2 * class_size(CACHE_CLASSES - 1)) {
+		return -1;
+	}
+	return 31 - __builtin_clz((uint32_t)usable) - CACHE_MIN_SHIFT;
+}
+
+static struct z_heap_cpu_cache *local_cache(struct k_heap *h)
+{
+	/* Migrating right after reading the CPU id just means we use
+	 * another CPU's cache, which its lock keeps safe
+	 */
+#ifdef CONFIG_SMP
+	return &h->cpu_cache[arch_curr_cpu()->id];
+#else
+	return &h->cpu_cache[0];
+#endif
+}
+
+static void *cache_alloc(struct k_heap *h, size_t bytes)
+{
+	int cls = alloc_class(bytes);
+	struct z_heap_cpu_cache *c;
+	k_spinlock_key_t key;
+	void *ret = NULL;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	c = local_cache(h);
+	key = k_spin_lock(&c->lock);
+
+	if (c->count[cls] == 0U) {
+		k_spinlock_key_t hkey = k_spin_lock(&h->lock);
+
+		while (c->count[cls] < CACHE_BATCH) {
+			void *mem = sys_heap_alloc(&h->heap, class_size(cls));
+
+			if (mem == NULL) {
+				break;
+			}
+			c->blocks[cls][c->count[cls]++] = mem;
+		}
+
+		k_spin_unlock(&h->lock, hkey);
+		c->stats.misses++;
+	} else {
+		c->stats.hits++;
+	}
+
+	if (c->count[cls] != 0U) {
+		ret = c->blocks[cls][--c->count[cls]];
+	}
+
+	k_spin_unlock(&c->lock, key);
+	return ret;
+}
+
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	int cls = free_class(sys_heap_usable_size(&h->heap, mem));
+	struct z_heap_cpu_cache *c;
+	k_spinlock_key_t key;
+
+	if (cls < 0) {
+		return false;
+	}
+
+	c = local_cache(h);
+	key = k_spin_lock(&c->lock);
+
+	/* Checked under the cache lock so that k_heap_alloc(), which
+	 * sets cache_bypass before flushing every cache, can't miss a
+	 * block parked here concurrently
+	 */
+	if (atomic_get(&h->cache_bypass) != 0) {
+		k_spin_unlock(&c->lock, key);
+		return false;
+	}
+
+	if (c->count[cls] == CACHE_DEPTH) {
+		/* Full: give the older half back in one batch */
+		k_spinlock_key_t hkey = k_spin_lock(&h->lock);
+
+		for (int i = 0; i < CACHE_BATCH; i++) {
+			sys_heap_free(&h->heap, c->blocks[cls][i]);
+		}
+
+		k_spin_unlock(&h->lock, hkey);
+
+		for (int i = CACHE_BATCH; i < CACHE_DEPTH; i++) {
+			c->blocks[cls][i - CACHE_BATCH] = c->blocks[cls][i];
+		}
+		c->count[cls] -= CACHE_BATCH;
+		c->stats.drains++;
+	}
+
+	c->blocks[cls][c->count[cls]++] = mem;
+	c->stats.frees++;
+
+	k_spin_unlock(&c->lock, key);
+	return true;
+}
+
+void k_heap_cache_flush(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cpu_cache *c = &h->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+		k_spinlock_key_t hkey = k_spin_lock(&h->lock);
+
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			while (c->count[cls] != 0U) {
+				sys_heap_free(&h->heap,
+					      c->blocks[cls][--c->count[cls]]);
+			}
+		}
+
+		k_spin_unlock(&h->lock, hkey);
+		c->stats.flushes++;
+		k_spin_unlock(&c->lock, key);
+	}
+}
+
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats)
+{
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cpu_cache *c = &h->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		stats->hits += c->stats.hits;
+		stats->misses += c->stats.misses;
+		stats->frees += c->stats.frees;
+		stats->drains += c->stats.drains;
+		k_spin_unlock(&c->lock, key);
+	}
+
+	/* Every flush visits each CPU once */
+	stats->flushes = h->cpu_cache[0].stats.flushes;
+}
+#endif /* CONFIG_HEAP_CPU_CACHE */
+
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 {
 	int64_t now, end = z_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+	if (bytes == 0U) {
+		return NULL;
+	}
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	bool flushed = false;
+
+	ret = cache_alloc(h, bytes);
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+
 	while (ret == NULL) {
 		ret = sys_heap_alloc(&h->heap, bytes);
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+		if (ret == NULL && !flushed) {
+			/* Blocks parked in CPU caches are free memory
+			 * too: hand them all back before failing or
+			 * blocking, and keep frees away from the caches
+			 * until we are done
+			 */
+			atomic_inc(&h->cache_bypass);
+			flushed = true;
+			k_spin_unlock(&h->lock, key);
+			k_heap_cache_flush(h);
+			key = k_spin_lock(&h->lock);
+			continue;
+		}
+#endif
+
 		now = z_tick_get();
 		if ((ret != NULL) || ((end - now) <= 0)) {
 			break;
@@ -48,11 +266,24 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	}
 
 	k_spin_unlock(&h->lock, key);
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (flushed) {
+		atomic_dec(&h->cache_bypass);
+	}
+#endif
+
 	return ret;
 }
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (mem != NULL && cache_free(h, mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
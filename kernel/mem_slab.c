@@ -93,11 +93,16 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_TRACE_FAILURES
+	slab->num_failed = 0U;
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
 	}
 	z_waitq_init(&slab->wait_q);
+	z_waitq_init(&slab->bulk_wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
 
 	z_object_init(slab);
@@ -106,6 +111,24 @@ out:
 	return rc;
 }
 
+static inline void count_alloc(struct k_mem_slab *slab, uint32_t count)
+{
+	slab->num_used += count;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->max_used = MAX(slab->num_used, slab->max_used);
+#endif
+}
+
+static inline void count_failure(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_FAILURES
+	slab->num_failed++;
+#else
+	ARG_UNUSED(slab);
+#endif
+}
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
@@ -115,22 +138,23 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
-
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
-#endif
+		count_alloc(slab, 1U);
 
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a free block to become available */
 		*mem = NULL;
+		count_failure(slab);
 		result = -ENOMEM;
 	} else {
 		/* wait for a free block or timeout */
 		result = z_pend_curr(&lock, key, &slab->wait_q, timeout);
 		if (result == 0) {
 			*mem = _current->base.swap_data;
+		} else if (IS_ENABLED(CONFIG_MEM_SLAB_TRACE_FAILURES)) {
+			key = k_spin_lock(&lock);
+			count_failure(slab);
+			k_spin_unlock(&lock, key);
 		}
 		return result;
 	}
@@ -140,19 +164,126 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+int k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem,
+			  uint32_t count, k_timeout_t timeout)
+{
+	uint64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result = 0;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	CHECKIF(count > slab->num_blocks) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	while (slab->num_blocks - slab->num_used < count) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = -ENOMEM;
+			break;
+		}
+
+		/* Tell k_mem_slab_free() how many blocks we need */
+		_current->base.swap_data = (void *)(uintptr_t)count;
+		result = z_pend_curr(&lock, key, &slab->bulk_wait_q, timeout);
+		key = k_spin_lock(&lock);
+		if (result != 0) {
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			if (remaining <= 0) {
+				result = -EAGAIN;
+				break;
+			}
+			timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+	}
+
+	if (result == 0) {
+		for (uint32_t i = 0U; i < count; i++) {
+			mem[i] = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+		}
+		count_alloc(slab, count);
+	} else {
+		count_failure(slab);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return result;
+}
+
+/* Return a block to the slab, handing it directly to a thread blocked
+ * in k_mem_slab_alloc() if there is one.  Returns true if a thread
+ * was made ready.
+ */
+static bool give_block(struct k_mem_slab *slab, void *block)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
 	if (pending_thread != NULL) {
-		z_thread_return_value_set_with_data(pending_thread, 0, *mem);
+		z_thread_return_value_set_with_data(pending_thread, 0, block);
 		z_ready_thread(pending_thread);
+		return true;
+	}
+
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->num_used--;
+	return false;
+}
+
+/* Wake, in wait order, the bulk allocators whose whole request can now
+ * be satisfied.  They retry their allocation when they run.
+ */
+static bool wake_bulk_waiters(struct k_mem_slab *slab)
+{
+	uint32_t avail = slab->num_blocks - slab->num_used;
+	struct k_thread *thread;
+	bool woken = false;
+
+	while ((thread = z_waitq_head(&slab->bulk_wait_q)) != NULL) {
+		uint32_t need = (uint32_t)(uintptr_t)thread->base.swap_data;
+
+		if (need > avail) {
+			break;
+		}
+		avail -= need;
+
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	k_mem_slab_free_bulk(slab, mem, 1U);
+}
+
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool need_sched = false;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		need_sched = give_block(slab, mem[i]) || need_sched;
+	}
+
+	need_sched = wake_bulk_waiters(slab) || need_sched;
+
+	if (need_sched) {
 		z_reschedule(&lock, key);
 	} else {
-		**(char ***)mem = slab->free_list;
-		slab->free_list = *(char **)mem;
-		slab->num_used--;
 		k_spin_unlock(&lock, key);
 	}
 }
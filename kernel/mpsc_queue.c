@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel MPSC queue object.
+ *
+ * A thin blocking layer over the lock-free sys_mpsc queue.  Producers
+ * only push and test the waiting flag; the spinlock and the scheduler
+ * are involved only when the consumer has declared itself about to
+ * sleep.  The consumer sets the flag before its last check of the
+ * queue and producers test it after their push, so with both being
+ * sequentially consistent atomics either the consumer sees the item
+ * or the producer sees the flag.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <ksched.h>
+
+static struct k_spinlock lock;
+
+void k_mpsc_queue_init(struct k_mpsc_queue *queue)
+{
+	sys_mpsc_init(&queue->queue);
+	z_waitq_init(&queue->wait_q);
+	atomic_clear(&queue->waiting);
+}
+
+void k_mpsc_queue_put(struct k_mpsc_queue *queue, sys_mpsc_node_t *node)
+{
+	k_spinlock_key_t key;
+	struct k_thread *thread;
+
+	sys_mpsc_push(&queue->queue, node);
+
+	if (likely(atomic_get(&queue->waiting) == 0)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	thread = z_unpend_first_thread(&queue->wait_q);
+	if (thread != NULL) {
+		atomic_clear(&queue->waiting);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+sys_mpsc_node_t *k_mpsc_queue_get(struct k_mpsc_queue *queue,
+				  k_timeout_t timeout)
+{
+	sys_mpsc_node_t *node = sys_mpsc_pop(&queue->queue);
+	k_spinlock_key_t key;
+	uint64_t end;
+
+	if (node != NULL || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return node;
+	}
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	end = z_timeout_end_calc(timeout);
+
+	while (true) {
+		key = k_spin_lock(&lock);
+		(void)atomic_set(&queue->waiting, 1);
+
+		node = sys_mpsc_pop(&queue->queue);
+		if (node != NULL) {
+			atomic_clear(&queue->waiting);
+			k_spin_unlock(&lock, key);
+			return node;
+		}
+
+		(void)z_pend_curr(&lock, key, &queue->wait_q, timeout);
+
+		/* Nothing may be visible yet if we were woken behind a
+		 * producer stalled half way through its push; that one
+		 * wakes us again once its node is linked in.
+		 */
+		node = sys_mpsc_pop(&queue->queue);
+		if (node != NULL) {
+			return node;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			if (remaining <= 0) {
+				break;
+			}
+			timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+	}
+
+	atomic_clear(&queue->waiting);
+	return NULL;
+}
@@ -113,36 +113,132 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+/*
+ * Transfer state of a thread pended on a message queue, reached through
+ * its swap_data.  Readers only pend while the ring buffer is empty and
+ * writers only while it is full, so the wait queue never holds both.
+ */
+struct msgq_waiter {
+	char *data;		/* next message to copy to or from */
+	uint32_t remaining;	/* messages left to transfer */
+	uint32_t needed;	/* messages left before it may be woken */
+};
+
+/* Copy num messages into the ring buffer, which must have room for them */
+static void msgq_ring_put(struct k_msgq *msgq, const char *data, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t run = MIN(len, (size_t)(msgq->buffer_end - msgq->write_ptr));
+
+	(void)memcpy(msgq->write_ptr, data, run);
+	(void)memcpy(msgq->buffer_start, data + run, len - run);
+	msgq->write_ptr += run;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start + (len - run);
+	}
+	msgq->used_msgs += num;
+}
+
+/* Copy num messages out of the ring buffer, which must hold them */
+static void msgq_ring_get(struct k_msgq *msgq, char *data, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t run = MIN(len, (size_t)(msgq->buffer_end - msgq->read_ptr));
+
+	(void)memcpy(data, msgq->read_ptr, run);
+	(void)memcpy(data + run, msgq->buffer_start, len - run);
+	msgq->read_ptr += run;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start + (len - run);
+	}
+	msgq->used_msgs -= num;
+}
+
+/*
+ * Hand up to num messages directly to pended readers, waking each one
+ * that has got as many as it asked for.  Must only be called when the
+ * queue is not full.  Returns the number of messages handed over.
+ */
+static uint32_t msgq_feed_readers(struct k_msgq *msgq, const char *data,
+				  uint32_t num, bool *woken)
+{
+	struct k_thread *thread;
+	struct msgq_waiter *waiter;
+	uint32_t done = 0U;
+	uint32_t cnt;
+
+	while ((done < num) &&
+	       ((thread = z_waitq_head(&msgq->wait_q)) != NULL)) {
+		waiter = thread->base.swap_data;
+		cnt = MIN(waiter->remaining, num - done);
+
+		(void)memcpy(waiter->data, data + done * msgq->msg_size,
+			     cnt * msgq->msg_size);
+		waiter->data += cnt * msgq->msg_size;
+		waiter->remaining -= cnt;
+		waiter->needed -= MIN(waiter->needed, cnt);
+		done += cnt;
+
+		if (waiter->needed > 0U) {
+			/* Out of messages, it stays pended for more */
+			break;
+		}
+
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		*woken = true;
+	}
+
+	return done;
+}
+
+/*
+ * Refill the ring buffer from pended writers, waking each one whose
+ * messages have all been queued.
+ */
+static void msgq_drain_writers(struct k_msgq *msgq, bool *woken)
+{
+	struct k_thread *thread;
+	struct msgq_waiter *waiter;
+	uint32_t cnt;
+
+	while ((msgq->used_msgs < msgq->max_msgs) &&
+	       ((thread = z_waitq_head(&msgq->wait_q)) != NULL)) {
+		waiter = thread->base.swap_data;
+		cnt = MIN(waiter->remaining, msgq->max_msgs - msgq->used_msgs);
+
+		msgq_ring_put(msgq, waiter->data, cnt);
+		waiter->data += cnt * msgq->msg_size;
+		waiter->remaining -= cnt;
+
+		if (waiter->remaining > 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		*woken = true;
+	}
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
-	struct k_thread *pending_thread;
 	k_spinlock_key_t key;
+	bool woken = false;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs < msgq->max_msgs) {
-		/* message queue isn't full */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
-			/* give message to waiting thread */
-			(void)memcpy(pending_thread->base.swap_data, data,
-			       msgq->msg_size);
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
-			z_reschedule(&msgq->lock, key);
-			return 0;
-		} else {
-			/* put message in queue */
-			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+		/* message queue isn't full: give message to a waiting
+		 * thread, or put it in the queue
+		 */
+		if (msgq_feed_readers(msgq, data, 1, &woken) == 0U) {
+			msgq_ring_put(msgq, data, 1);
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -150,11 +246,21 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		result = -ENOMSG;
 	} else {
 		/* wait for put message success, failure, or timeout */
-		_current->base.swap_data = (void *) data;
+		struct msgq_waiter waiter = {
+			.data = (char *)data,
+			.remaining = 1,
+			.needed = 1,
+		};
+
+		_current->base.swap_data = &waiter;
 		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
 	}
 
-	k_spin_unlock(&msgq->lock, key);
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
 
 	return result;
 }
@@ -171,6 +277,69 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *q, const void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t done = 0U;
+	uint32_t cnt;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs < msgq->max_msgs) {
+		done = msgq_feed_readers(msgq, src, num_msgs, &woken);
+
+		cnt = MIN(num_msgs - done, msgq->max_msgs - msgq->used_msgs);
+		msgq_ring_put(msgq, src + done * msgq->msg_size, cnt);
+		done += cnt;
+	}
+
+	if ((done < num_msgs) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* wait for readers to make room for the rest */
+		struct msgq_waiter waiter = {
+			.data = (char *)src + done * msgq->msg_size,
+			.remaining = num_msgs - done,
+			.needed = num_msgs - done,
+		};
+		int ret;
+
+		_current->base.swap_data = &waiter;
+		ret = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		/* a purge only fails the call if nothing was sent yet */
+		if ((ret == -ENOMSG) && (waiter.remaining == num_msgs)) {
+			return ret;
+		}
+
+		return num_msgs - waiter.remaining;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return done;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *q, const void *data,
+					 uint32_t num_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_put_many(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -194,49 +363,38 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
+	bool woken = false;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0) {
-		/* take first available message from queue */
-		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
-		msgq->used_msgs--;
-
-		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
-			z_reschedule(&msgq->lock, key);
-			return 0;
-		}
+		/* take first available message from queue, then handle
+		 * the first thread waiting to write (if any)
+		 */
+		msgq_ring_get(msgq, data, 1);
+		msgq_drain_writers(msgq, &woken);
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
 		result = -ENOMSG;
 	} else {
 		/* wait for get message success or timeout */
-		_current->base.swap_data = data;
+		struct msgq_waiter waiter = {
+			.data = data,
+			.remaining = 1,
+			.needed = 1,
+		};
+
+		_current->base.swap_data = &waiter;
 		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
 	}
 
-	k_spin_unlock(&msgq->lock, key);
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
 
 	return result;
 }
@@ -253,6 +411,74 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *q, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t max_msgs, uint32_t min_msgs,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t done = 0U;
+	uint32_t cnt;
+
+	CHECKIF(min_msgs > max_msgs) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* Pended writers may hold more than fits in the ring buffer */
+	while ((done < max_msgs) && (msgq->used_msgs > 0)) {
+		cnt = MIN(max_msgs - done, msgq->used_msgs);
+		msgq_ring_get(msgq, dst + done * msgq->msg_size, cnt);
+		done += cnt;
+		msgq_drain_writers(msgq, &woken);
+	}
+
+	if ((done < min_msgs) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* the queue is empty: wait for writers to supply the rest */
+		struct msgq_waiter waiter = {
+			.data = dst + done * msgq->msg_size,
+			.remaining = max_msgs - done,
+			.needed = min_msgs - done,
+		};
+		int ret;
+
+		_current->base.swap_data = &waiter;
+		ret = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		/* a purge only fails the call if nothing was received yet */
+		if ((ret == -ENOMSG) && (waiter.remaining == max_msgs)) {
+			return ret;
+		}
+
+		return max_msgs - waiter.remaining;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return done;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *q, void *data,
+					 uint32_t max_msgs, uint32_t min_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_many(q, data, max_msgs, min_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
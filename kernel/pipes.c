@@ -446,6 +446,13 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* The claimed space starts at write_index: don't write over it */
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -602,6 +609,13 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* The claimed data starts at read_index: don't consume it */
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -798,12 +812,279 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 	async_desc->thread.is_idle = 0;
 #endif
 
-	(void) z_pipe_put_internal(pipe, async_desc, block->data,
-				    bytes_to_write, &dummy_bytes_written,
-				    bytes_to_write, K_FOREVER);
+	if (z_pipe_put_internal(pipe, async_desc, block->data,
+				bytes_to_write, &dummy_bytes_written,
+				bytes_to_write, K_FOREVER) == -EBUSY) {
+		/* Nothing was queued, and there is no way to report it */
+		__ASSERT(false, "pipe has a put claim outstanding");
+		pipe_async_free(async_desc);
+	}
 }
 #endif
 
+/* Length of the contiguous free space starting at the write index */
+static size_t pipe_put_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+/* Length of the contiguous data starting at the read index */
+static size_t pipe_get_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t run;
+
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return 0;
+	}
+
+	run = MIN(pipe_put_run(pipe), size);
+	if (run > 0) {
+		/*
+		 * Free space in the buffer means no writer is pended, and
+		 * k_pipe_put() fails with -EBUSY until the claim finishes.
+		 */
+		pipe->flags |= K_PIPE_FLAG_PUT_CLAIMED;
+		*data = pipe->buffer + pipe->write_index;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return run;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_pipe_desc *desc;
+	struct k_thread    *thread;
+	sys_dlist_t         xfer_list;
+	size_t              bytes_copied;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) == 0U) ||
+		(size > pipe_put_run(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIMED;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only pend on an empty buffer, so any that are waiting
+	 * can be handed the committed data straight away.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				0, pipe->bytes_used, 0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		z_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t run;
+
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return 0;
+	}
+
+	run = MIN(pipe_get_run(pipe), size);
+	if (run > 0) {
+		/*
+		 * Data in the buffer means no reader is pended, and
+		 * k_pipe_get() fails with -EBUSY until the claim finishes.
+		 */
+		pipe->flags |= K_PIPE_FLAG_GET_CLAIMED;
+		*data = pipe->buffer + pipe->read_index;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return run;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_pipe_desc *desc;
+	struct k_thread    *thread;
+	sys_dlist_t         xfer_list;
+	size_t              bytes_copied;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) == 0U) ||
+		(size > pipe_get_run(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIMED;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/* Refill the space just released from any pended writers */
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				0, pipe->size - pipe->bytes_used, 0,
+				K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Run a pipe transfer over each segment of an iovec in turn
+ *
+ * Each segment is required to transfer as much of @a min_xfer as is still
+ * outstanding; once that has been met the remaining segments are only
+ * transferred as far as possible without waiting.
+ */
+static int pipe_iov_xfer(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			 size_t iov_cnt, size_t *bytes_xferred,
+			 size_t min_xfer, k_timeout_t timeout, bool put)
+{
+	uint64_t end = z_timeout_end_calc(timeout);
+	size_t total = 0;
+	size_t len = 0;
+	size_t seg_min;
+	size_t seg_xferred;
+	int rc = 0;
+
+	CHECKIF(bytes_xferred == NULL) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		len += iov[i].iov_len;
+	}
+
+	CHECKIF(min_xfer > len) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		seg_min = (min_xfer > total) ?
+			  MIN(min_xfer - total, iov[i].iov_len) : 0;
+
+		if (seg_min == 0) {
+			timeout = K_NO_WAIT;
+		} else if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+			   !K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			timeout = Z_TIMEOUT_TICKS(MAX(remaining, 0));
+		}
+
+		if (put) {
+			rc = z_pipe_put_internal(pipe, NULL, iov[i].iov_base,
+						 iov[i].iov_len, &seg_xferred,
+						 seg_min, timeout);
+		} else {
+			rc = z_impl_k_pipe_get(pipe, iov[i].iov_base,
+					       iov[i].iov_len, &seg_xferred,
+					       seg_min, timeout);
+		}
+
+		total += seg_xferred;
+
+		if ((rc != 0) || (seg_xferred < iov[i].iov_len)) {
+			break;
+		}
+	}
+
+	*bytes_xferred = total;
+
+	/* A short segment after min_xfer was met is still a success */
+	return (total >= min_xfer) ? 0 : rc;
+}
+
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	return pipe_iov_xfer(pipe, iov, iov_cnt, bytes_written, min_xfer,
+			     timeout, true);
+}
+
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	return pipe_iov_xfer(pipe, iov, iov_cnt, bytes_read, min_xfer,
+			     timeout, false);
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
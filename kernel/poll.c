@@ -34,10 +34,12 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_poll_set(struct k_poll_set *set,
+			    struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -52,6 +54,7 @@ void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 	event->type = type;
 	event->state = K_POLL_STATE_NOT_READY;
 	event->mode = mode;
+	event->reported = 0U;
 	event->unused = 0U;
 	event->obj = obj;
 }
@@ -93,6 +96,17 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Poll sets have no priority of their own and are signaled after threads */
+static bool is_p1_higher_prio_than_p2(struct z_poller *p1, struct z_poller *p2)
+{
+	if ((p1->mode == MODE_SET) || (p2->mode == MODE_SET)) {
+		return (p1->mode != MODE_SET) && (p2->mode == MODE_SET);
+	}
+
+	return z_is_t1_higher_prio_than_t2(poller_thread(p1),
+					   poller_thread(p2));
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
@@ -100,15 +114,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-	    z_is_t1_higher_prio_than_t2(poller_thread(pending->poller),
-					poller_thread(poller))) {
+	    is_p1_higher_prio_than_p2(pending->poller, poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_is_t1_higher_prio_than_t2(poller_thread(poller),
-					poller_thread(pending->poller))) {
+		if (is_p1_higher_prio_than_p2(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -394,6 +406,13 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller) {
+		if (poller->mode == MODE_SET) {
+			signal_poll_set(CONTAINER_OF(poller, struct k_poll_set,
+						     poller),
+					event, state);
+			return 0;
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
@@ -702,3 +721,197 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/*
+ * Objects signal a set with their own lock held, not the poll lock, so the
+ * ready list and the wait queue of a set are protected by the lock of the
+ * set. It nests inside both the poll lock and the object locks. The set
+ * must come from the poller the caller read, as k_poll_set_remove() may
+ * clear event->poller at any time until the set is locked.
+ */
+static void signal_poll_set(struct k_poll_set *set,
+			    struct k_poll_event *event, uint32_t state)
+{
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+	struct k_thread *thread;
+
+	/* Removed from the set after the caller read event->poller, which
+	 * may be NULL by now: only trust it with the set locked.
+	 */
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&set->lock, key);
+		return;
+	}
+
+	event->state |= state;
+	event->reported = 0U;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	k_spin_unlock(&set->lock, key);
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+	set->lock = (struct k_spinlock) {};
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		signal_poll_set(set, event, state);
+		z_reschedule(&lock, key);
+		return 0;
+	}
+
+	(void)register_event(event, &set->poller);
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	(void)k_spin_lock(&set->lock);
+
+	/* Linked either on its object or on the ready list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_release(&set->lock);
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/* must be called with both the poll lock and the lock of the set held
+ *
+ * Events which are still ready are moved to the tail of the ready list,
+ * so that all of them get returned in turn, others are registered on
+ * their object again. Only the returned events are visited.
+ */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **events, int max_events)
+{
+	struct k_poll_event *first = NULL;
+	struct k_poll_event *event;
+	uint32_t state;
+	int count = 0;
+
+	while (count < max_events) {
+		event = (struct k_poll_event *)sys_dlist_peek_head(&set->ready);
+		if ((event == NULL) || (event == first)) {
+			break;
+		}
+
+		sys_dlist_remove(&event->_node);
+
+		if (!is_condition_met(event, &state)) {
+			state = K_POLL_STATE_NOT_READY;
+		}
+
+		/* Cancellation is only reported once */
+		if (event->reported == 0U) {
+			state |= event->state & K_POLL_STATE_CANCELLED;
+		}
+		event->state = state;
+
+		if (state == K_POLL_STATE_NOT_READY) {
+			(void)register_event(event, &set->poller);
+			continue;
+		}
+
+		if (first == NULL) {
+			first = event;
+		}
+
+		event->reported = 1U;
+		sys_dlist_append(&set->ready, &event->_node);
+		events[count++] = event;
+	}
+
+	return count;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	uint64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int count;
+	int rc;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	for (;;) {
+		key = k_spin_lock(&lock);
+		(void)k_spin_lock(&set->lock);
+
+		count = poll_set_collect(set, events, max_events);
+		if (count > 0) {
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			count = -EAGAIN;
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			if (remaining <= 0) {
+				count = -EAGAIN;
+				break;
+			}
+			timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+
+		/* The lock of the set is held until the thread is pended,
+		 * so that an event signaled after the collection wakes it.
+		 */
+		k_spin_release(&lock);
+		rc = z_pend_curr(&set->lock, key, &set->wait_q, timeout);
+		if (rc == -EAGAIN) {
+			/* Pick up events signaled while timing out */
+			timeout = K_NO_WAIT;
+		}
+	}
+
+	k_spin_release(&set->lock);
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
@@ -38,15 +38,25 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #define _priq_run_remove	z_priq_rb_remove
 #define _priq_run_best		z_priq_rb_best
 #elif defined(CONFIG_SCHED_MULTIQ)
-#define _priq_run_add		z_priq_mq_add
-#define _priq_run_remove	z_priq_mq_remove
-#define _priq_run_best		z_priq_mq_best
+# if defined(CONFIG_SCHED_CPU_MASK)
+#  define _priq_run_add		_priq_mq_mask_add
+#  define _priq_run_remove	_priq_mq_mask_remove
+#  define _priq_run_best	_priq_mq_mask_best
+# else
+#  define _priq_run_add		z_priq_mq_add
+#  define _priq_run_remove	z_priq_mq_remove
+#  define _priq_run_best	z_priq_mq_best
+# endif
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
 #define z_priq_wait_add		z_priq_rb_add
 #define _priq_wait_remove	z_priq_rb_remove
 #define _priq_wait_best		z_priq_rb_best
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define z_priq_wait_add		z_priq_mq_add
+#define _priq_wait_remove	z_priq_mq_remove
+#define _priq_wait_best		z_priq_mq_best
 #elif defined(CONFIG_WAITQ_DUMB)
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
@@ -164,7 +174,7 @@ static ALWAYS_INLINE bool should_preempt(struct k_thread *thread,
 	return false;
 }
 
-#ifdef CONFIG_SCHED_CPU_MASK
+#if defined(CONFIG_SCHED_DUMB) && defined(CONFIG_SCHED_CPU_MASK)
 static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 {
 	/* With masks enabled we need to be prepared to walk the list
@@ -181,6 +191,150 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#if defined(CONFIG_SCHED_MULTIQ) && defined(CONFIG_SCHED_CPU_MASK)
+static ALWAYS_INLINE void _priq_mq_mask_add(struct _priq_mq_mask *pq,
+					    struct k_thread *thread)
+{
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	z_priq_mq_add(&pq->mq, thread);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((thread->base.cpu_mask & BIT(i)) != 0) {
+			pq->cpu_count[priority_bit][i]++;
+			pq->cpu_bitmask[i] |= BIT(priority_bit);
+		}
+	}
+}
+
+static ALWAYS_INLINE void _priq_mq_mask_remove(struct _priq_mq_mask *pq,
+					       struct k_thread *thread)
+{
+#if defined(CONFIG_SWAP_NONATOMIC)
+	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	    z_is_thread_prevented_from_running(thread)) {
+		return;
+	}
+#endif
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	z_priq_mq_remove(&pq->mq, thread);
+
+	/* The mask can't change while the thread is queued (see
+	 * cpu_mask_mod()), so it matches what _priq_mq_mask_add() saw
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((thread->base.cpu_mask & BIT(i)) != 0 &&
+		    --pq->cpu_count[priority_bit][i] == 0U) {
+			pq->cpu_bitmask[i] &= ~BIT(priority_bit);
+		}
+	}
+}
+
+static ALWAYS_INLINE struct k_thread *_priq_mq_mask_best(struct _priq_mq_mask *pq)
+{
+	unsigned int bitmask = pq->cpu_bitmask[_current_cpu->id];
+	struct k_thread *thread;
+
+	if (bitmask == 0U) {
+		return NULL;
+	}
+
+	/* This level is known to hold a thread we can run.  Only
+	 * same-priority threads pinned to other CPUs can precede it.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(&pq->mq.queues[__builtin_ctz(bitmask)],
+				     thread, base.qnode_dlist) {
+		if ((thread->base.cpu_mask & BIT(_current_cpu->id)) != 0) {
+			return thread;
+		}
+	}
+
+	__ASSERT(false, "cpu_bitmask out of sync with queue contents");
+	return NULL;
+}
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* With per-CPU run queues, a queued thread always lives in the queue
+ * of CPU thread->base.cpu.  That is the CPU it last ran on, unless
+ * its affinity mask no longer allows it there.
+ */
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
+{
+	return &_kernel.cpus[thread->base.cpu].ready_q;
+}
+
+static ALWAYS_INLINE int runq_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(thread->base.cpu)) == 0U) {
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if ((thread->base.cpu_mask & BIT(i)) != 0U) {
+				return i;
+			}
+		}
+	}
+#endif
+	return thread->base.cpu;
+}
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	thread->base.cpu = runq_cpu(thread);
+	_priq_run_add(&thread_ready_q(thread)->runq, thread);
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	struct k_thread *thread = _priq_run_best(&_current_cpu->ready_q.runq);
+
+	/* Steal from the other CPUs' queues any thread that a single
+	 * shared queue would have picked over our local candidate, so
+	 * strict priority order still holds across the whole system.
+	 * A CPU with an empty local queue takes the best thread it is
+	 * allowed to run from anywhere.
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *t;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if (t != NULL && (thread == NULL ||
+				  z_is_t1_higher_prio_than_t2(t, thread))) {
+			thread = t;
+		}
+	}
+
+	return thread;
+}
+#else
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+
+	return &_kernel.ready_q;
+}
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	_priq_run_add(&_kernel.ready_q.runq, thread);
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	return _priq_run_best(&_kernel.ready_q.runq);
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(&thread_ready_q(thread)->runq, thread);
+}
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 	struct k_thread *thread;
@@ -192,7 +346,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		return _current_cpu->idle_thread;
 	}
 
-	thread = _priq_run_best(&_kernel.ready_q.runq);
+	thread = runq_best();
 
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
@@ -262,13 +416,13 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	/* Put _current back into the queue */
 	if (thread != _current && active &&
 		!z_is_idle_thread_object(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 	}
 	z_mark_thread_as_not_queued(thread);
 
@@ -279,9 +433,9 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 	}
-	_priq_run_add(&_kernel.ready_q.runq, thread);
+	runq_add(thread);
 	z_mark_thread_as_queued(thread);
 	update_cache(thread == _current);
 }
@@ -422,7 +576,7 @@ static void ready_thread(struct k_thread *thread)
 	 */
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		sys_trace_thread_ready(thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
@@ -465,7 +619,7 @@ void z_impl_k_thread_suspend(struct k_thread *thread)
 
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		z_mark_thread_as_suspended(thread);
@@ -552,8 +706,7 @@ void z_thread_single_abort(struct k_thread *thread)
 
 		if (z_is_thread_ready(thread)) {
 			if (z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 			update_cache(thread == _current);
@@ -637,7 +790,7 @@ void z_thread_single_abort(struct k_thread *thread)
 static void unready_thread(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 		z_mark_thread_as_not_queued(thread);
 	}
 	update_cache(thread == _current);
@@ -786,6 +939,19 @@ void z_unpend_thread(struct k_thread *thread)
 	(void)z_abort_thread_timeout(thread);
 }
 
+/* Moves a pended thread to another wait queue without waking it; its
+ * timeout, if any, keeps running.
+ */
+void z_requeue_thread(struct k_thread *thread, _wait_q_t *wait_q)
+{
+	LOCKED(&sched_spinlock) {
+		unpend_thread_no_timeout(thread);
+		z_mark_thread_as_pending(thread);
+		thread->base.pended_on = wait_q;
+		z_priq_wait_add(&wait_q->waitq, thread);
+	}
+}
+
 /* Priority set utility that does no rescheduling, it just changes the
  * run queue state, returning true if a reschedule is needed later.
  */
@@ -799,13 +965,20 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				thread->base.prio = prio;
-				_priq_run_add(&_kernel.ready_q.runq, thread);
+				runq_add(thread);
 			} else {
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+		} else if (thread->base.pended_on != NULL) {
+			/* Wait queues are ordered by priority, a pended
+			 * thread must be requeued too.
+			 */
+			_priq_wait_remove(&pended_on(thread)->waitq, thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&pended_on(thread)->waitq, thread);
 		} else {
 			thread->base.prio = prio;
 		}
@@ -915,6 +1088,9 @@ struct k_thread *z_get_next_ready_thread(void)
 static inline void set_current(struct k_thread *new_thread)
 {
 	z_thread_mark_switched_out();
+#ifdef CONFIG_SMP
+	new_thread->base.cpu = _current_cpu->id;
+#endif
 	_current_cpu->current = new_thread;
 }
 
@@ -1070,7 +1246,7 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
-#ifdef CONFIG_SCHED_MULTIQ
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 # if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
 # error Too many priorities for multiqueue scheduler (max 32)
 # endif
@@ -1079,14 +1255,42 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dlist_t *l = &pq->queues[priority_bit];
 
-	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
+#ifdef CONFIG_SCHED_DEADLINE
+	/* Keep each list sorted by deadline so its head is still the
+	 * EDF choice.  Walk from the tail: threads with equal deadlines
+	 * (including every thread that never set one) stay FIFO, and a
+	 * thread whose deadline is the latest is appended right away.
+	 */
+	sys_dnode_t *n = sys_dlist_peek_tail(l);
+
+	while (n != NULL) {
+		struct k_thread *t = CONTAINER_OF(n, struct k_thread,
+						  base.qnode_dlist);
+
+		if (!z_is_t1_higher_prio_than_t2(thread, t)) {
+			break;
+		}
+		n = sys_dlist_peek_prev(l, n);
+	}
+
+	n = (n == NULL) ? sys_dlist_peek_head(l) : sys_dlist_peek_next(l, n);
+	if (n != NULL) {
+		sys_dlist_insert(n, &thread->base.qnode_dlist);
+	} else {
+		sys_dlist_append(l, &thread->base.qnode_dlist);
+	}
+#else
+	sys_dlist_append(l, &thread->base.qnode_dlist);
+#endif
 	pq->bitmask |= BIT(priority_bit);
 }
 
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
 {
-#if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_MULTIQ)
+#if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_MULTIQ) && \
+	!defined(CONFIG_SCHED_CPU_MASK)
 	if (pq == &_kernel.ready_q.runq && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
@@ -1116,6 +1320,27 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+/* Thread queued after @thread in priority order, or NULL */
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dnode_t *n = sys_dlist_peek_next(&pq->queues[priority_bit],
+					     &thread->base.qnode_dlist);
+
+	if (n == NULL) {
+		/* Two shifts: priority_bit + 1 may be 32 */
+		unsigned int later = (pq->bitmask >> priority_bit) >> 1;
+
+		if (later == 0U) {
+			return NULL;
+		}
+		priority_bit += __builtin_ctz(later) + 1;
+		n = sys_dlist_peek_head(&pq->queues[priority_bit]);
+	}
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1130,14 +1355,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -1145,9 +1370,26 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+# ifdef CONFIG_SCHED_CPU_MASK
+	struct _priq_mq *mq = &rq->runq.mq;
+# else
+	struct _priq_mq *mq = &rq->runq;
+# endif
+
+	for (int i = 0; i < ARRAY_SIZE(mq->queues); i++) {
+		sys_dlist_init(&mq->queues[i]);
+	}
+#endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
+#else
+	init_ready_q(&_kernel.ready_q);
 #endif
 
 #ifdef CONFIG_TIMESLICING
@@ -1207,8 +1449,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			_priq_run_add(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
+			runq_add(thread);
 		}
 	}
 }
@@ -1237,10 +1479,9 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
+				runq_remove(_current);
 			}
-			_priq_run_add(&_kernel.ready_q.runq, _current);
+			runq_add(_current);
 			z_mark_thread_as_queued(_current);
 			update_cache(1);
 		}
@@ -1420,7 +1661,7 @@ void z_sched_abort(struct k_thread *thread)
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
 		} else if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
@@ -13,11 +13,20 @@
 
 #include <kernel.h>
 #include <init.h>
+#include <sys/printk.h>
 
 K_KERNEL_STACK_DEFINE(sys_work_q_stack, CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
 
 struct k_work_q k_sys_work_q;
 
+#define EXTRA_WORKERS (CONFIG_SYSTEM_WORKQUEUE_THREADS - 1)
+
+#if EXTRA_WORKERS > 0
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_extra_stacks, EXTRA_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_extra_threads[EXTRA_WORKERS];
+#endif
+
 static int k_sys_work_q_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -28,6 +37,20 @@ static int k_sys_work_q_init(const struct device *dev)
 		       CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
 	k_thread_name_set(&k_sys_work_q.thread, "sysworkq");
 
+#if EXTRA_WORKERS > 0
+	for (int i = 0; i < EXTRA_WORKERS; i++) {
+		char name[16];
+
+		k_work_q_add_worker(&k_sys_work_q,
+				    &sys_work_q_extra_threads[i],
+				    sys_work_q_extra_stacks[i],
+				    CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE,
+				    CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
+		snprintk(name, sizeof(name), "sysworkq%d", i + 1);
+		k_thread_name_set(&sys_work_q_extra_threads[i], name);
+	}
+#endif
+
 	return 0;
 }
 
@@ -30,12 +30,119 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 		    size_t stack_size, int prio)
 {
 	k_queue_init(&work_q->queue);
+#ifdef CONFIG_WORKQUEUE_STATS
+	work_q->stats = (struct k_work_q_stats) { .workers = 1 };
+#endif
 	(void)k_thread_create(&work_q->thread, stack, stack_size, z_work_q_main,
 			work_q, NULL, NULL, prio, 0, K_NO_WAIT);
 
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+void k_work_q_add_worker(struct k_work_q *work_q, struct k_thread *thread,
+			 k_thread_stack_t *stack, size_t stack_size, int prio)
+{
+	__ASSERT((work_q->thread.base.user_options & K_USER) == 0U,
+		 "user mode workqueues have a single worker");
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+
+	work_q->stats.workers++;
+	k_spin_unlock(&work_q->stats_lock, key);
+#endif
+
+	(void)k_thread_create(thread, stack, stack_size, z_work_q_main,
+			      work_q, NULL, NULL, prio, 0, K_NO_WAIT);
+
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+}
+
+#ifdef CONFIG_WORKQUEUE_STATS
+/* User mode workers can't reach the statistics, so none are kept */
+static inline bool stats_enabled(struct k_work_q *work_q)
+{
+	return (work_q->thread.base.user_options & K_USER) == 0U;
+}
+
+void z_work_q_stats_queued(struct k_work_q *work_q, struct k_work *work)
+{
+	if (!stats_enabled(work_q)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+	struct k_work_q_stats *stats = &work_q->stats;
+
+	atomic_set_bit(work->flags, K_WORK_STATE_COUNTED);
+	work->queued_at = k_cycle_get_32();
+	stats->submitted++;
+	stats->queued++;
+	stats->queued_max = MAX(stats->queued_max, stats->queued);
+
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+
+void z_work_q_stats_unqueued(struct k_work_q *work_q, struct k_work *work)
+{
+	if (!atomic_test_and_clear_bit(work->flags, K_WORK_STATE_COUNTED)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+
+	work_q->stats.queued--;
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+
+void z_work_q_stats_started(struct k_work_q *work_q, struct k_work *work)
+{
+	uint32_t latency = k_cycle_get_32() - work->queued_at;
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+	struct k_work_q_stats *stats = &work_q->stats;
+
+	stats->queued--;
+	stats->busy++;
+	stats->busy_max = MAX(stats->busy_max, stats->busy);
+	stats->latency_max = MAX(stats->latency_max, latency);
+	stats->latency_total += latency;
+
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+
+void z_work_q_stats_finished(struct k_work_q *work_q)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+
+	work_q->stats.busy--;
+	work_q->stats.completed++;
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+
+void k_work_q_stats_get(struct k_work_q *work_q, struct k_work_q_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+
+	*stats = work_q->stats;
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+
+void k_work_q_stats_reset(struct k_work_q *work_q)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->stats_lock);
+	struct k_work_q_stats *stats = &work_q->stats;
+
+	stats->submitted = 0U;
+	stats->completed = 0U;
+	stats->queued_max = stats->queued;
+	stats->busy_max = stats->busy;
+	stats->latency_max = 0U;
+	stats->latency_total = 0U;
+
+	k_spin_unlock(&work_q->stats_lock, key);
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -53,6 +160,9 @@ static int work_cancel(struct k_delayed_work *work)
 		if (!k_queue_remove(&work->work_q->queue, &work->work)) {
 			return -EINVAL;
 		}
+#ifdef CONFIG_WORKQUEUE_STATS
+		z_work_q_stats_unqueued(work->work_q, &work->work);
+#endif
 	} else {
 		int err = z_abort_timeout(&work->timeout);
 
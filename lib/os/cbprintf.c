@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
 #include <stdarg.h>
 #include <stddef.h>
+#include <string.h>
 #include <sys/cbprintf.h>
+#include <sys/util.h>
 
 int cbprintf(cbprintf_cb out, void *ctx, const char *format, ...)
 {
@@ -20,6 +23,314 @@ int cbprintf(cbprintf_cb out, void *ctx, const char *format, ...)
 	return rc;
 }
 
+bool z_cbprintf_is_rodata(const void *addr)
+{
+#if defined(CONFIG_ARM) || defined(CONFIG_ARC) || defined(CONFIG_X86)
+	extern const char *_image_rodata_start[];
+	extern const char *_image_rodata_end[];
+	#define RO_START _image_rodata_start
+	#define RO_END _image_rodata_end
+#elif defined(CONFIG_NIOS2) || defined(CONFIG_RISCV)
+	extern const char *_image_rom_start[];
+	extern const char *_image_rom_end[];
+	#define RO_START _image_rom_start
+	#define RO_END _image_rom_end
+#elif defined(CONFIG_XTENSA)
+	extern const char *_rodata_start[];
+	extern const char *_rodata_end[];
+	#define RO_START _rodata_start
+	#define RO_END _rodata_end
+#else
+	#define RO_START 0
+	#define RO_END 0
+#endif
+
+	return (((const char *)addr >= (const char *)RO_START) &&
+		((const char *)addr < (const char *)RO_END));
+}
+
+/* Find the copy of the string argument stored at @p arg, if the package
+ * has one.
+ */
+const char *z_cbprintf_pkg_str_get(const uint8_t *pkg, const uint8_t *arg,
+				   const char *str)
+{
+	const struct z_cbprintf_pkg_hdr *hdr =
+		(const struct z_cbprintf_pkg_hdr *)pkg;
+	const uint8_t *pos = pkg + hdr->args_wlen * sizeof(uint32_t);
+	const char *copy = (const char *)(pos + hdr->str_cnt);
+	uint8_t idx = (uint8_t)((arg - pkg) / sizeof(uint32_t));
+
+	/* Not copied yet, the string is still where it was */
+	if ((const uint8_t *)copy == pkg + hdr->len) {
+		return str;
+	}
+
+	for (size_t i = 0; i < hdr->str_cnt; i++) {
+		if (pos[i] == idx) {
+			return copy;
+		}
+		copy += strlen(copy) + 1;
+	}
+
+	return str;
+}
+
+int cbprintf_package_copy(const void *packaged, void *out, size_t len)
+{
+	const struct z_cbprintf_pkg_hdr *hdr = packaged;
+	const uint8_t *pkg = packaged;
+	size_t args_len = hdr->args_wlen * sizeof(uint32_t);
+	size_t fixed_len = args_len + hdr->str_cnt;
+	const uint8_t *pos = pkg + args_len;
+	size_t out_len = fixed_len;
+	const char *str;
+	uint8_t *dst;
+
+	/* Already copied, or nothing to copy */
+	if (hdr->len != fixed_len || hdr->str_cnt == 0U) {
+		out_len = hdr->len;
+		if (out != NULL) {
+			if (len < out_len) {
+				return -ENOSPC;
+			}
+			memcpy(out, packaged, out_len);
+		}
+
+		return (int)out_len;
+	}
+
+	for (size_t i = 0; i < hdr->str_cnt; i++) {
+		memcpy(&str, pkg + pos[i] * sizeof(uint32_t), sizeof(str));
+		out_len += strlen(str) + 1;
+	}
+
+	if (out_len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	if (out == NULL) {
+		return (int)out_len;
+	}
+
+	if (len < out_len) {
+		return -ENOSPC;
+	}
+
+	memcpy(out, packaged, fixed_len);
+	dst = (uint8_t *)out + fixed_len;
+	for (size_t i = 0; i < hdr->str_cnt; i++) {
+		size_t slen;
+
+		memcpy(&str, pkg + pos[i] * sizeof(uint32_t), sizeof(str));
+		slen = strlen(str) + 1;
+		memcpy(dst, str, slen);
+		dst += slen;
+	}
+
+	((struct z_cbprintf_pkg_hdr *)out)->len = (uint16_t)out_len;
+
+	return (int)out_len;
+}
+
+static const char *skip_digits(const char *fp)
+{
+	while ((*fp >= '0') && (*fp <= '9')) {
+		++fp;
+	}
+
+	return fp;
+}
+
+int cbvprintf_package(void *packaged, size_t len, const char *format,
+		      va_list ap)
+{
+	uint8_t *pkg = packaged;
+	size_t pos = Z_CBPRINTF_PKG_ARGS_OFFSET;
+	uint8_t str_idx[CBPRINTF_PACKAGE_MAX_STR];
+	size_t str_cnt = 0;
+	const char *fp = format;
+
+/* Store the next argument of @p type, or only account for it when
+ * calculating the length.
+ */
+#define PKG_PUT(type) do { \
+	type _v = va_arg(ap, type); \
+	\
+	if (pkg != NULL) { \
+		if ((pos + sizeof(_v)) > len) { \
+			return -ENOSPC; \
+		} \
+		memcpy(&pkg[pos], &_v, sizeof(_v)); \
+	} \
+	pos += sizeof(_v); \
+} while (false)
+
+	while (*fp != '\0') {
+		enum {
+			LEN_NONE, LEN_L, LEN_LL, LEN_J, LEN_Z, LEN_UPPER_L,
+		} length_mod = LEN_NONE;
+
+		if (*fp++ != '%') {
+			continue;
+		}
+
+		while ((*fp != '\0') && (strchr("-+ #0", *fp) != NULL)) {
+			++fp;
+		}
+
+		if (*fp == '*') {
+			PKG_PUT(int);
+			++fp;
+		} else {
+			fp = skip_digits(fp);
+		}
+
+		if (*fp == '.') {
+			++fp;
+			if (*fp == '*') {
+				PKG_PUT(int);
+				++fp;
+			} else {
+				fp = skip_digits(fp);
+			}
+		}
+
+		switch (*fp) {
+		case 'h':
+			fp += (fp[1] == 'h') ? 2 : 1;
+			break;
+		case 'l':
+			if (fp[1] == 'l') {
+				length_mod = LEN_LL;
+				++fp;
+			} else {
+				length_mod = LEN_L;
+			}
+			++fp;
+			break;
+		case 'j':
+			length_mod = LEN_J;
+			++fp;
+			break;
+		case 'z':
+		case 't':
+			length_mod = LEN_Z;
+			++fp;
+			break;
+		case 'L':
+			length_mod = LEN_UPPER_L;
+			++fp;
+			break;
+		default:
+			break;
+		}
+
+		switch (*fp) {
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			if (length_mod == LEN_L) {
+				PKG_PUT(long);
+			} else if (length_mod == LEN_LL) {
+				PKG_PUT(long long);
+			} else if (length_mod == LEN_J) {
+				PKG_PUT(intmax_t);
+			} else if (length_mod == LEN_Z) {
+				PKG_PUT(size_t);
+			} else {
+				PKG_PUT(int);
+			}
+			break;
+		case 'c':
+			PKG_PUT(int);
+			break;
+		case 'a':
+		case 'A':
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G':
+			if (length_mod == LEN_UPPER_L) {
+				PKG_PUT(long double);
+			} else {
+				PKG_PUT(double);
+			}
+			break;
+		case 's': {
+			const char *s = va_arg(ap, const char *);
+
+			if ((s != NULL) && !z_cbprintf_is_rodata(s)) {
+				if (str_cnt == ARRAY_SIZE(str_idx)) {
+					return -EINVAL;
+				}
+				str_idx[str_cnt++] =
+					(uint8_t)(pos / sizeof(uint32_t));
+			}
+
+			if (pkg != NULL) {
+				if ((pos + sizeof(s)) > len) {
+					return -ENOSPC;
+				}
+				memcpy(&pkg[pos], &s, sizeof(s));
+			}
+			pos += sizeof(s);
+			break;
+		}
+		case 'p':
+		case 'n':
+			PKG_PUT(void *);
+			break;
+		case '\0':
+			/* Truncated conversion, do not step past the end */
+			continue;
+		default:
+			/* %% or an invalid conversion, no argument */
+			break;
+		}
+		++fp;
+	}
+
+#undef PKG_PUT
+
+	if (pos > (UINT8_MAX * sizeof(uint32_t))) {
+		return -EINVAL;
+	}
+
+	if (pkg != NULL) {
+		struct z_cbprintf_pkg_hdr *hdr = (struct z_cbprintf_pkg_hdr *)pkg;
+
+		if ((pos + str_cnt) > len) {
+			return -ENOSPC;
+		}
+
+		memcpy(&pkg[sizeof(*hdr)], &format, sizeof(format));
+		memcpy(&pkg[pos], str_idx, str_cnt);
+		hdr->args_wlen = (uint8_t)(pos / sizeof(uint32_t));
+		hdr->str_cnt = (uint8_t)str_cnt;
+		hdr->len = (uint16_t)(pos + str_cnt);
+	}
+
+	return (int)(pos + str_cnt);
+}
+
+int cbprintf_package(void *packaged, size_t len, const char *format, ...)
+{
+	va_list ap;
+	int rc;
+
+	va_start(ap, format);
+	rc = cbvprintf_package(packaged, len, format, ap);
+	va_end(ap);
+
+	return rc;
+}
+
 #if defined(CONFIG_CBPRINTF_LIBC_SUBSTS)
 
 /* Context for sn* variants is the next space in the buffer, and the buffer
@@ -1355,10 +1355,18 @@ static int outs(cbprintf_cb out,
 	return (int)count;
 }
 
-int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
+/* Format either from @p ap or, when @p pkg is not NULL, from the
+ * arguments stored in the package.
+ */
+static int cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fp,
+			  va_list ap, const uint8_t *pkg)
 {
 	char buf[CONVERTED_BUFLEN];
 	size_t count = 0;
+	const uint8_t *pkg_arg = (pkg != NULL) ?
+				 pkg + Z_CBPRINTF_PKG_ARGS_OFFSET : NULL;
+
+#define PULL_ARG(dst, type) Z_CBPRINTF_ARG_PULL(ap, pkg_arg, dst, type)
 
 /* Output character, returning EOF if output failed, otherwise
  * updating count.
@@ -1419,7 +1427,7 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 		 * otherwise set with if present.
 		 */
 		if (conv->width_star) {
-			width = va_arg(ap, int);
+			PULL_ARG(width, int);
 
 			if (width < 0) {
 				conv->flag_dash = true;
@@ -1434,7 +1442,9 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 		 * precision is not present use 6.
 		 */
 		if (conv->prec_star) {
-			int arg = va_arg(ap, int);
+			int arg;
+
+			PULL_ARG(arg, int);
 
 			if (arg < 0) {
 				conv->prec_present = false;
@@ -1484,18 +1494,16 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 			case LENGTH_NONE:
 			case LENGTH_HH:
 			case LENGTH_H:
-				value->sint = va_arg(ap, int);
+				PULL_ARG(value->sint, int);
 				break;
 			case LENGTH_L:
-				value->sint = va_arg(ap, long);
+				PULL_ARG(value->sint, long);
 				break;
 			case LENGTH_LL:
-				value->sint =
-					(sint_value_type)va_arg(ap, long long);
+				PULL_ARG(value->sint, long long);
 				break;
 			case LENGTH_J:
-				value->sint =
-					(sint_value_type)va_arg(ap, intmax_t);
+				PULL_ARG(value->sint, intmax_t);
 				break;
 			case LENGTH_Z:		/* size_t */
 			case LENGTH_T:		/* ptrdiff_t */
@@ -1506,8 +1514,7 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 				 * other.  This can be checked in a platform
 				 * test.
 				 */
-				value->sint =
-					(sint_value_type)va_arg(ap, ptrdiff_t);
+				PULL_ARG(value->sint, ptrdiff_t);
 				break;
 			}
 			if (length_mod == LENGTH_HH) {
@@ -1521,25 +1528,20 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 			case LENGTH_NONE:
 			case LENGTH_HH:
 			case LENGTH_H:
-				value->uint = va_arg(ap, unsigned int);
+				PULL_ARG(value->uint, unsigned int);
 				break;
 			case LENGTH_L:
-				value->uint = va_arg(ap, unsigned long);
+				PULL_ARG(value->uint, unsigned long);
 				break;
 			case LENGTH_LL:
-				value->uint =
-					(uint_value_type)va_arg(ap,
-						unsigned long long);
+				PULL_ARG(value->uint, unsigned long long);
 				break;
 			case LENGTH_J:
-				value->uint =
-					(uint_value_type)va_arg(ap,
-								uintmax_t);
+				PULL_ARG(value->uint, uintmax_t);
 				break;
 			case LENGTH_Z:		/* size_t */
 			case LENGTH_T:		/* ptrdiff_t */
-				value->uint =
-					(uint_value_type)va_arg(ap, size_t);
+				PULL_ARG(value->uint, size_t);
 				break;
 			}
 			if (length_mod == LENGTH_HH) {
@@ -1549,12 +1551,20 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 			}
 		} else if (specifier_cat == SPECIFIER_FP) {
 			if (length_mod == LENGTH_UPPER_L) {
-				value->ldbl = va_arg(ap, long double);
+				PULL_ARG(value->ldbl, long double);
 			} else {
-				value->dbl = va_arg(ap, double);
+				PULL_ARG(value->dbl, double);
 			}
 		} else if (specifier_cat == SPECIFIER_PTR) {
-			value->ptr = va_arg(ap, void *);
+			const uint8_t *arg = pkg_arg;
+
+			PULL_ARG(value->ptr, void *);
+
+			/* Strings may have been copied into the package */
+			if ((pkg != NULL) && (conv->specifier == 's')) {
+				value->ptr = (void *)z_cbprintf_pkg_str_get(
+					pkg, arg, (const char *)value->ptr);
+			}
 		}
 
 		/* We've now consumed all arguments related to this
@@ -1818,10 +1828,37 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
 	}
 
 	return count;
+#undef PULL_ARG
 #undef OUTS
 #undef OUTC
 }
 
+int cbvprintf(cbprintf_cb out, void *ctx, const char *fp, va_list ap)
+{
+	return cbvprintf_impl(out, ctx, fp, ap, NULL);
+}
+
+/* Provides the va_list cbvprintf_impl() requires; it is never read. */
+static int cbpprintf_va(cbprintf_cb out, void *ctx, const uint8_t *pkg, ...)
+{
+	const char *fp;
+	va_list ap;
+	int rc;
+
+	memcpy(&fp, pkg + sizeof(struct z_cbprintf_pkg_hdr), sizeof(fp));
+
+	va_start(ap, pkg);
+	rc = cbvprintf_impl(out, ctx, fp, ap, pkg);
+	va_end(ap);
+
+	return rc;
+}
+
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged)
+{
+	return cbpprintf_va(out, ctx, packaged);
+}
+
 size_t cbprintf_arglen(const char *format)
 {
 	size_t rv = 0;
@@ -6,6 +6,7 @@
  */
 
 #include <stdarg.h>
+#include <string.h>
 #include <sys/cbprintf.h>
 #include <toolchain.h>
 #include <linker/sections.h>
@@ -44,6 +45,8 @@ BUILD_ASSERT(sizeof(uint_value_type) <= 8U,
 	} \
 } while (false)
 
+#define PULL_ARG(dst, type) Z_CBPRINTF_ARG_PULL(ap, pkg_arg, dst, type)
+
 static void print_digits(cbprintf_cb out, void *ctx, uint_value_type num,
 			 unsigned int base, bool pad_before, char pad_char,
 			 int min_width, size_t *countp)
@@ -120,13 +123,17 @@ static bool negative(uint_value_type val)
  *
  * See printk() for description.
  * @param fmt Format string
- * @param ap Variable parameters
+ * @param ap Variable parameters, used when @p pkg is NULL
+ * @param pkg Package holding the parameters, or NULL
  *
  * @return N/A
  */
-int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
+static int cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fmt,
+			  va_list ap, const uint8_t *pkg)
 {
 	size_t count = 0;
+	const uint8_t *pkg_arg = (pkg != NULL) ?
+				 pkg + Z_CBPRINTF_PKG_ARGS_OFFSET : NULL;
 	int might_format = 0; /* 1 if encountered a '%' */
 	enum pad_type padding = PAD_NONE;
 	int padlen, min_width = -1;
@@ -193,21 +200,22 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
 				uint_value_type d;
 
 				if (length_mod == 'z') {
-					d = va_arg(ap, ssize_t);
+					PULL_ARG(d, ssize_t);
 				} else if (length_mod == 'l') {
-					d = va_arg(ap, long);
+					PULL_ARG(d, long);
 				} else if (length_mod == 'L') {
 
-					long long lld = va_arg(ap,
-							       long long);
+					long long lld;
+
+					PULL_ARG(lld, long long);
 					if (!ok64(out, ctx, lld, &count)) {
 						break;
 					}
 					d = (uint_value_type) lld;
 				} else if (*fmt == 'u') {
-					d = va_arg(ap, unsigned int);
+					PULL_ARG(d, unsigned int);
 				} else {
-					d = va_arg(ap, int);
+					PULL_ARG(d, int);
 				}
 
 				if (*fmt != 'u' && negative(d)) {
@@ -227,7 +235,10 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
 				if (*fmt == 'p') {
 					const char *cp;
 
-					x = (uintptr_t)va_arg(ap, void *);
+					void *p;
+
+					PULL_ARG(p, void *);
+					x = (uintptr_t)p;
 					if (x == 0) {
 						cp = "(nil)";
 					} else {
@@ -243,11 +254,11 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
 					}
 					min_width -= 2;
 				} else if (length_mod == 'l') {
-					x = va_arg(ap, unsigned long);
+					PULL_ARG(x, unsigned long);
 				} else if (length_mod == 'L') {
-					x = va_arg(ap, unsigned long long);
+					PULL_ARG(x, unsigned long long);
 				} else {
-					x = va_arg(ap, unsigned int);
+					PULL_ARG(x, unsigned int);
 				}
 
 				print_hex(out, ctx, x, padding, min_width,
@@ -255,8 +266,15 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
 				break;
 			}
 			case 's': {
-				char *s = va_arg(ap, char *);
-				char *start = s;
+				const uint8_t *arg = pkg_arg;
+				const char *s;
+				const char *start;
+
+				PULL_ARG(s, const char *);
+				if (pkg != NULL) {
+					s = z_cbprintf_pkg_str_get(pkg, arg, s);
+				}
+				start = s;
 
 				while (*s) {
 					OUTC(*s++);
@@ -272,7 +290,9 @@ pad_string:
 				break;
 			}
 			case 'c': {
-				int c = va_arg(ap, int);
+				int c;
+
+				PULL_ARG(c, int);
 
 				OUTC(c);
 				break;
@@ -295,6 +315,32 @@ still_might_format:
 	return count;
 }
 
+int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
+{
+	return cbvprintf_impl(out, ctx, fmt, ap, NULL);
+}
+
+/* Provides the va_list cbvprintf_impl() requires; it is never read. */
+static int cbpprintf_va(cbprintf_cb out, void *ctx, const uint8_t *pkg, ...)
+{
+	const char *fmt;
+	va_list ap;
+	int rc;
+
+	memcpy(&fmt, pkg + sizeof(struct z_cbprintf_pkg_hdr), sizeof(fmt));
+
+	va_start(ap, pkg);
+	rc = cbvprintf_impl(out, ctx, fmt, ap, pkg);
+	va_end(ap);
+
+	return rc;
+}
+
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged)
+{
+	return cbpprintf_va(out, ctx, packaged);
+}
+
 size_t cbprintf_arglen(const char *format)
 {
 	size_t rv = 0;
@@ -21,49 +21,94 @@
 #include <syscall_handler.h>
 #include <sys/atomic.h>
 
+/* Descriptors live in fixed size chunks, the first one static and the
+ * others, with CONFIG_POSIX_FDTABLE_GROW, allocated from the system heap
+ * when all earlier ones are full. Chunks are never freed nor moved, so
+ * an fd keeps mapping to the same entry and lookup needs no lock.
+ */
+#define FD_CHUNK_SIZE CONFIG_POSIX_MAX_FDS
+
+#ifdef CONFIG_POSIX_FDTABLE_GROW
+BUILD_ASSERT(CONFIG_POSIX_FDTABLE_GROW_MAX >= CONFIG_POSIX_MAX_FDS,
+	     "POSIX_FDTABLE_GROW_MAX must be at least POSIX_MAX_FDS");
+
+/* The last chunk may be only partly usable */
+#define FD_MAX CONFIG_POSIX_FDTABLE_GROW_MAX
+#else
+#define FD_MAX CONFIG_POSIX_MAX_FDS
+#endif
+
+#define FD_CHUNKS ceiling_fraction(FD_MAX, FD_CHUNK_SIZE)
+
+/* The table holds one reference on every allocated entry, and each
+ * operation in progress another one. Closing sets FD_CLOSING so that
+ * new lookups fail, and the entry is only returned to the allocator
+ * once the last reference is dropped.
+ */
+#define FD_CLOSING BIT(30)
+#define FD_REF_MASK (FD_CLOSING - 1)
+
 struct fd_entry {
 	void *obj;
 	const struct fd_op_vtable *vtable;
 	atomic_t refcount;
 };
 
+struct fd_chunk {
+	/* Entries in use, including those still being closed */
+	ATOMIC_DEFINE(used, FD_CHUNK_SIZE);
+	struct fd_entry entries[FD_CHUNK_SIZE];
+};
+
 #ifdef CONFIG_POSIX_API
 static const struct fd_op_vtable stdinout_fd_op_vtable;
 #endif
 
-static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
+static struct fd_chunk fdtable = {
 #ifdef CONFIG_POSIX_API
-	/*
-	 * Predefine entries for stdin/stdout/stderr.
-	 */
-	{
-		/* STDIN */
-		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1)
-	},
-	{
-		/* STDOUT */
-		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1)
-	},
-	{
-		/* STDERR */
-		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1)
+	.used = { BIT(0) | BIT(1) | BIT(2) },
+	.entries = {
+		/*
+		 * Predefine entries for stdin/stdout/stderr.
+		 */
+		{
+			/* STDIN */
+			.vtable = &stdinout_fd_op_vtable,
+			.refcount = ATOMIC_INIT(1)
+		},
+		{
+			/* STDOUT */
+			.vtable = &stdinout_fd_op_vtable,
+			.refcount = ATOMIC_INIT(1)
+		},
+		{
+			/* STDERR */
+			.vtable = &stdinout_fd_op_vtable,
+			.refcount = ATOMIC_INIT(1)
+		},
 	},
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+static atomic_ptr_t fd_chunks[FD_CHUNKS] = {
+	&fdtable,
+};
+
+static struct fd_chunk *fd_chunk_get(int fd)
+{
+	return atomic_ptr_get(&fd_chunks[fd / FD_CHUNK_SIZE]);
+}
 
-static int z_fd_ref(int fd)
+static struct fd_entry *fd_entry_get(int fd)
 {
-	return atomic_inc(&fdtable[fd].refcount) + 1;
+	return &fd_chunk_get(fd)->entries[fd % FD_CHUNK_SIZE];
 }
 
 static int z_fd_unref(int fd)
 {
+	struct fd_entry *entry = fd_entry_get(fd);
 	atomic_val_t old_rc;
+	atomic_val_t new_rc;
 
 	/* Reference counter must be checked to avoid decrement refcount below
 	 * zero causing file descriptor leak. Loop statement below executes
@@ -71,46 +116,46 @@ static int z_fd_unref(int fd)
 	 * refcount is not going to be written.
 	 */
 	do {
-		old_rc = atomic_get(&fdtable[fd].refcount);
-		if (!old_rc) {
+		old_rc = atomic_get(&entry->refcount);
+		if ((old_rc & FD_REF_MASK) == 0) {
 			return 0;
 		}
-	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc - 1));
 
-	if (old_rc != 1) {
-		return old_rc - 1;
+		new_rc = old_rc - 1;
+		if ((new_rc & FD_REF_MASK) == 0) {
+			new_rc = 0;
+		}
+	} while (!atomic_cas(&entry->refcount, old_rc, new_rc));
+
+	if (new_rc != 0) {
+		return new_rc & FD_REF_MASK;
 	}
 
-	fdtable[fd].obj = NULL;
-	fdtable[fd].vtable = NULL;
+	entry->obj = NULL;
+	entry->vtable = NULL;
+	atomic_clear_bit(fd_chunk_get(fd)->used, fd % FD_CHUNK_SIZE);
 
 	return 0;
 }
 
-static int _find_fd_entry(void)
+static int _check_fd(int fd)
 {
-	int fd;
+	atomic_val_t rc;
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (!atomic_get(&fdtable[fd].refcount)) {
-			return fd;
-		}
+	if (fd < 0 || fd >= FD_MAX) {
+		errno = EBADF;
+		return -1;
 	}
 
-	errno = ENFILE;
-	return -1;
-}
+	fd = k_array_index_sanitize(fd, FD_MAX);
 
-static int _check_fd(int fd)
-{
-	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
+	if (fd_chunk_get(fd) == NULL) {
 		errno = EBADF;
 		return -1;
 	}
 
-	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
-
-	if (!atomic_get(&fdtable[fd].refcount)) {
+	rc = atomic_get(&fd_entry_get(fd)->refcount);
+	if (rc == 0 || (rc & FD_CLOSING) != 0) {
 		errno = EBADF;
 		return -1;
 	}
@@ -118,6 +163,93 @@ static int _check_fd(int fd)
 	return 0;
 }
 
+/* Mark an entry as closing and drop the reference held by the table.
+ * Only the first caller succeeds.
+ */
+static bool z_fd_retire(int fd)
+{
+	struct fd_entry *entry = fd_entry_get(fd);
+	atomic_val_t old_rc;
+
+	do {
+		old_rc = atomic_get(&entry->refcount);
+		if (old_rc == 0 || (old_rc & FD_CLOSING) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&entry->refcount, old_rc, old_rc | FD_CLOSING));
+
+	(void)z_fd_unref(fd);
+
+	return true;
+}
+
+static struct fd_chunk *fd_chunk_add(int n)
+{
+	struct fd_chunk *chunk = atomic_ptr_get(&fd_chunks[n]);
+
+	if (IS_ENABLED(CONFIG_POSIX_FDTABLE_GROW) && chunk == NULL) {
+		struct fd_chunk *new_chunk = k_calloc(1, sizeof(*new_chunk));
+
+		if (new_chunk == NULL) {
+			return NULL;
+		}
+
+		if (atomic_ptr_cas(&fd_chunks[n], NULL, new_chunk)) {
+			return new_chunk;
+		}
+
+		/* Another thread was faster */
+		k_free(new_chunk);
+		chunk = atomic_ptr_get(&fd_chunks[n]);
+	}
+
+	return chunk;
+}
+
+static int fd_chunk_alloc(struct fd_chunk *chunk, int limit)
+{
+	for (int i = 0; i < ARRAY_SIZE(chunk->used); i++) {
+		atomic_val_t used = atomic_get(&chunk->used[i]);
+		int bit;
+
+		while (~used != 0) {
+			bit = find_lsb_set((uint32_t)~used) - 1;
+			if ((i * ATOMIC_BITS + bit) >= limit) {
+				break;
+			}
+
+			if (atomic_cas(&chunk->used[i], used, used | (atomic_val_t)BIT(bit))) {
+				return i * ATOMIC_BITS + bit;
+			}
+
+			used = atomic_get(&chunk->used[i]);
+		}
+	}
+
+	return -1;
+}
+
+static int _find_fd_entry(void)
+{
+	for (int n = 0; n < FD_CHUNKS; n++) {
+		struct fd_chunk *chunk = fd_chunk_add(n);
+		int idx;
+
+		if (chunk == NULL) {
+			break;
+		}
+
+		idx = fd_chunk_alloc(chunk, MIN(FD_CHUNK_SIZE,
+						FD_MAX - n * FD_CHUNK_SIZE));
+		if (idx >= 0) {
+			return n * FD_CHUNK_SIZE + idx;
+		}
+	}
+
+	errno = ENFILE;
+	return -1;
+}
+
 void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 {
 	struct fd_entry *fd_entry;
@@ -126,7 +258,7 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 		return NULL;
 	}
 
-	fd_entry = &fdtable[fd];
+	fd_entry = fd_entry_get(fd);
 
 	if (vtable != NULL && fd_entry->vtable != vtable) {
 		errno = err;
@@ -144,7 +276,7 @@ void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable)
 		return NULL;
 	}
 
-	fd_entry = &fdtable[fd];
+	fd_entry = fd_entry_get(fd);
 	*vtable = fd_entry->vtable;
 
 	return fd_entry->obj;
@@ -152,25 +284,25 @@ void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable)
 
 int z_reserve_fd(void)
 {
+	struct fd_entry *entry;
 	int fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
-
 	fd = _find_fd_entry();
 	if (fd >= 0) {
 		/* Mark entry as used, z_finalize_fd() will fill it in. */
-		(void)z_fd_ref(fd);
-		fdtable[fd].obj = NULL;
-		fdtable[fd].vtable = NULL;
+		entry = fd_entry_get(fd);
+		entry->obj = NULL;
+		entry->vtable = NULL;
+		atomic_set(&entry->refcount, 1);
 	}
 
-	k_mutex_unlock(&fdtable_lock);
-
 	return fd;
 }
 
 void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 {
+	struct fd_entry *entry = fd_entry_get(fd);
+
 	/* Assumes fd was already bounds-checked. */
 #ifdef CONFIG_USERSPACE
 	/* descriptor context objects are inserted into the table when they
@@ -182,14 +314,14 @@ void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 	 */
 	z_object_recycle(obj);
 #endif
-	fdtable[fd].obj = obj;
-	fdtable[fd].vtable = vtable;
+	entry->obj = obj;
+	entry->vtable = vtable;
 }
 
 void z_free_fd(int fd)
 {
 	/* Assumes fd was already bounds-checked. */
-	(void)z_fd_unref(fd);
+	(void)z_fd_retire(fd);
 }
 
 int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
@@ -206,37 +338,85 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 
 #ifdef CONFIG_POSIX_API
 
-ssize_t read(int fd, void *buf, size_t sz)
+/* Look up an entry and take a reference on it, so that it is not reused
+ * before z_fd_unref() even if the descriptor is concurrently closed.
+ */
+static struct fd_entry *z_fd_ref(int fd)
 {
+	struct fd_entry *entry;
+	atomic_val_t old_rc;
+
 	if (_check_fd(fd) < 0) {
+		return NULL;
+	}
+
+	fd = k_array_index_sanitize(fd, FD_MAX);
+	entry = fd_entry_get(fd);
+
+	do {
+		old_rc = atomic_get(&entry->refcount);
+		if (old_rc == 0 || (old_rc & FD_CLOSING) != 0) {
+			errno = EBADF;
+			return NULL;
+		}
+	} while (!atomic_cas(&entry->refcount, old_rc, old_rc + 1));
+
+	return entry;
+}
+
+ssize_t read(int fd, void *buf, size_t sz)
+{
+	struct fd_entry *entry = z_fd_ref(fd);
+	ssize_t res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->read(fdtable[fd].obj, buf, sz);
+	res = entry->vtable->read(entry->obj, buf, sz);
+
+	(void)z_fd_unref(fd);
+
+	return res;
 }
 FUNC_ALIAS(read, _read, ssize_t);
 
 ssize_t write(int fd, const void *buf, size_t sz)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_ref(fd);
+	ssize_t res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->write(fdtable[fd].obj, buf, sz);
+	res = entry->vtable->write(entry->obj, buf, sz);
+
+	(void)z_fd_unref(fd);
+
+	return res;
 }
 FUNC_ALIAS(write, _write, ssize_t);
 
 int close(int fd)
 {
+	struct fd_entry *entry = z_fd_ref(fd);
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return -1;
 	}
 
-	res = fdtable[fd].vtable->close(fdtable[fd].obj);
+	/* Lose the race against a concurrent close() like a closed fd */
+	if (!z_fd_retire(fd)) {
+		(void)z_fd_unref(fd);
+		errno = EBADF;
+		return -1;
+	}
 
-	z_free_fd(fd);
+	res = entry->vtable->close(entry->obj);
+
+	(void)z_fd_unref(fd);
 
 	return res;
 }
@@ -244,62 +424,87 @@ FUNC_ALIAS(close, _close, int);
 
 int fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_ref(fd);
+	int res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	res = z_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_FSYNC);
+
+	(void)z_fd_unref(fd);
+
+	return res;
 }
 
 off_t lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_ref(fd);
+	off_t res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_LSEEK,
-			  offset, whence);
+	res = z_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_LSEEK,
+				   offset, whence);
+
+	(void)z_fd_unref(fd);
+
+	return res;
 }
 FUNC_ALIAS(lseek, _lseek, off_t);
 
 int ioctl(int fd, unsigned long request, ...)
 {
+	struct fd_entry *entry = z_fd_ref(fd);
 	va_list args;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return -1;
 	}
 
 	va_start(args, request);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = entry->vtable->ioctl(entry->obj, request, args);
 	va_end(args);
 
+	(void)z_fd_unref(fd);
+
 	return res;
 }
 
 int fcntl(int fd, int cmd, ...)
 {
+	struct fd_entry *entry;
 	va_list args;
 	int res;
 
-	if (_check_fd(fd) < 0) {
-		return -1;
-	}
-
 	/* Handle fdtable commands. */
 	switch (cmd) {
 	case F_DUPFD:
+		if (_check_fd(fd) < 0) {
+			return -1;
+		}
+
 		/* Not implemented so far. */
 		errno = EINVAL;
 		return -1;
 	}
 
+	entry = z_fd_ref(fd);
+	if (entry == NULL) {
+		return -1;
+	}
+
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = entry->vtable->ioctl(entry->obj, cmd, args);
 	va_end(args);
 
+	(void)z_fd_unref(fd);
+
 	return res;
 }
 
@@ -166,6 +166,15 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	free_chunk(h, c);
 }
 
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	uint8_t *end = (uint8_t *)chunk_buf(h) + right_chunk(h, c) * CHUNK_UNIT;
+
+	return end - (uint8_t *)mem;
+}
+
 static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -0,0 +1,196 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpsc_pbuf.h>
+#include <sys/__assert.h>
+
+/* One word is always left unused so that a full buffer can be told
+ * apart from an empty one.
+ */
+static inline uint32_t used_words(const struct mpsc_pbuf_buffer *buffer)
+{
+	if (buffer->wr_idx >= buffer->rd_idx) {
+		return buffer->wr_idx - buffer->rd_idx;
+	}
+
+	return buffer->size - buffer->rd_idx + buffer->wr_idx;
+}
+
+static inline uint32_t idx_inc(const struct mpsc_pbuf_buffer *buffer,
+			       uint32_t idx, uint32_t val)
+{
+	uint32_t i = idx + val;
+
+	return (i >= buffer->size) ? i - buffer->size : i;
+}
+
+static inline union mpsc_pbuf_generic *item_at(
+		const struct mpsc_pbuf_buffer *buffer, uint32_t idx)
+{
+	return (union mpsc_pbuf_generic *)&buffer->buf[idx];
+}
+
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
+		    const struct mpsc_pbuf_buffer_config *config)
+{
+	__ASSERT_NO_MSG(config->size > 1);
+
+	buffer->wr_idx = 0;
+	buffer->rd_idx = 0;
+	buffer->max_usage = 0;
+	buffer->flags = config->flags;
+	buffer->notify_drop = config->notify_drop;
+	buffer->buf = config->buf;
+	buffer->size = config->size;
+}
+
+/* Make room by dropping the oldest packet.  Returns false if it is not
+ * committed yet or held by the consumer.
+ */
+static bool drop_oldest(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item = item_at(buffer, buffer->rd_idx);
+
+	if (item->hdr.skip == 0U) {
+		if ((item->hdr.valid == 0U) || (item->hdr.busy != 0U)) {
+			return false;
+		}
+
+		if (buffer->notify_drop != NULL) {
+			buffer->notify_drop(buffer, item);
+		}
+	}
+
+	buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, item->hdr.len);
+
+	return true;
+}
+
+union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
+					 size_t wlen)
+{
+	union mpsc_pbuf_generic *item = NULL;
+	k_spinlock_key_t key;
+	uint32_t tail, need, used;
+
+	if ((wlen == 0U) || (wlen >= buffer->size)) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&buffer->lock);
+
+	while (true) {
+		used = used_words(buffer);
+		if (used == 0U) {
+			/* Restart from the beginning to avoid padding */
+			buffer->wr_idx = 0;
+			buffer->rd_idx = 0;
+		}
+
+		/* A packet which does not fit before the end of the
+		 * storage starts at the beginning, after a padding packet.
+		 */
+		tail = buffer->size - buffer->wr_idx;
+		need = (wlen > tail) ? tail + wlen : wlen;
+
+		if (need <= buffer->size - 1U - used) {
+			break;
+		}
+
+		if (((buffer->flags & MPSC_PBUF_MODE_OVERWRITE) == 0U) ||
+		    !drop_oldest(buffer)) {
+			goto out;
+		}
+	}
+
+	if (wlen > tail) {
+		item = item_at(buffer, buffer->wr_idx);
+		item->raw = 0;
+		item->hdr.skip = 1;
+		item->hdr.len = tail;
+		buffer->wr_idx = 0;
+	}
+
+	item = item_at(buffer, buffer->wr_idx);
+	item->raw = 0;
+	item->hdr.len = wlen;
+	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
+	buffer->max_usage = MAX(buffer->max_usage, used + need);
+
+out:
+	k_spin_unlock(&buffer->lock, key);
+
+	return item;
+}
+
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
+		      union mpsc_pbuf_generic *item)
+{
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	item->hdr.valid = 1;
+	k_spin_unlock(&buffer->lock, key);
+}
+
+const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item = NULL;
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	while (buffer->rd_idx != buffer->wr_idx) {
+		union mpsc_pbuf_generic *oldest = item_at(buffer,
+							  buffer->rd_idx);
+
+		if (oldest->hdr.skip != 0U) {
+			buffer->rd_idx = idx_inc(buffer, buffer->rd_idx,
+						 oldest->hdr.len);
+			continue;
+		}
+
+		if (oldest->hdr.valid != 0U) {
+			__ASSERT(oldest->hdr.busy == 0U,
+				 "Previous packet not freed");
+			oldest->hdr.busy = 1;
+			item = oldest;
+		}
+
+		break;
+	}
+
+	k_spin_unlock(&buffer->lock, key);
+
+	return item;
+}
+
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
+		    const union mpsc_pbuf_generic *item)
+{
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	__ASSERT_NO_MSG(item == item_at(buffer, buffer->rd_idx));
+
+	buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, item->hdr.len);
+	k_spin_unlock(&buffer->lock, key);
+}
+
+bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
+{
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	bool pending = (used_words(buffer) != 0U);
+
+	k_spin_unlock(&buffer->lock, key);
+
+	return pending;
+}
+
+void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
+			       uint32_t *size, uint32_t *now, uint32_t *max)
+{
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	*size = (buffer->size - 1U) * sizeof(uint32_t);
+	*now = used_words(buffer) * sizeof(uint32_t);
+	*max = buffer->max_usage * sizeof(uint32_t);
+	k_spin_unlock(&buffer->lock, key);
+}
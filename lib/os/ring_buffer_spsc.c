@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/ring_buffer.h>
+#include <string.h>
+
+/* Indexes are free running and wrap at 2^32, which is a multiple of the
+ * power of 2 buffer size. Only the side owning an index writes it, the
+ * other side reads it with acquire semantics, which orders the data
+ * accesses with the index update done with release semantics.
+ */
+#ifdef CONFIG_ATOMIC_OPERATIONS_BUILTIN
+static inline uint32_t idx_load(const atomic_t *idx)
+{
+	return (uint32_t)__atomic_load_n(idx, __ATOMIC_ACQUIRE);
+}
+
+static inline void idx_store(atomic_t *idx, uint32_t val)
+{
+	__atomic_store_n(idx, (atomic_val_t)val, __ATOMIC_RELEASE);
+}
+#else
+static inline uint32_t idx_load(const atomic_t *idx)
+{
+	return (uint32_t)atomic_get(idx);
+}
+
+static inline void idx_store(atomic_t *idx, uint32_t val)
+{
+	(void)atomic_set(idx, (atomic_val_t)val);
+}
+#endif
+
+uint32_t spsc_ring_buf_space_get(struct spsc_ring_buf *buf)
+{
+	buf->prod.rd_idx = idx_load(&buf->cons.rd_idx);
+
+	return (buf->mask + 1U) -
+	       ((uint32_t)buf->prod.wr_idx - buf->prod.rd_idx);
+}
+
+uint32_t spsc_ring_buf_size_get(struct spsc_ring_buf *buf)
+{
+	buf->cons.wr_idx = idx_load(&buf->prod.wr_idx);
+
+	return buf->cons.wr_idx - (uint32_t)buf->cons.rd_idx;
+}
+
+uint32_t spsc_ring_buf_put_claim(struct spsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	uint32_t wr = buf->prod.tmp_wr_idx;
+	uint32_t space = (buf->mask + 1U) - (wr - buf->prod.rd_idx);
+	uint32_t trail_size;
+
+	/* Only touch the consumer cache line when the cached read index
+	 * does not allow the request.
+	 */
+	if (space < size) {
+		buf->prod.rd_idx = idx_load(&buf->cons.rd_idx);
+		space = (buf->mask + 1U) - (wr - buf->prod.rd_idx);
+	}
+
+	trail_size = (buf->mask + 1U) - (wr & buf->mask);
+	size = MIN(size, MIN(space, trail_size));
+
+	*data = &buf->data[wr & buf->mask];
+	buf->prod.tmp_wr_idx = wr + size;
+
+	return size;
+}
+
+int spsc_ring_buf_put_finish(struct spsc_ring_buf *buf, uint32_t size)
+{
+	uint32_t wr = (uint32_t)buf->prod.wr_idx;
+
+	if (size > (buf->prod.tmp_wr_idx - wr)) {
+		return -EINVAL;
+	}
+
+	buf->prod.tmp_wr_idx = wr + size;
+	idx_store(&buf->prod.wr_idx, wr + size);
+
+	return 0;
+}
+
+uint32_t spsc_ring_buf_put(struct spsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = spsc_ring_buf_put_claim(buf, &dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = spsc_ring_buf_put_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
+
+uint32_t spsc_ring_buf_get_claim(struct spsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	uint32_t rd = buf->cons.tmp_rd_idx;
+	uint32_t avail = buf->cons.wr_idx - rd;
+	uint32_t trail_size;
+
+	if (avail < size) {
+		buf->cons.wr_idx = idx_load(&buf->prod.wr_idx);
+		avail = buf->cons.wr_idx - rd;
+	}
+
+	trail_size = (buf->mask + 1U) - (rd & buf->mask);
+	size = MIN(size, MIN(avail, trail_size));
+
+	*data = &buf->data[rd & buf->mask];
+	buf->cons.tmp_rd_idx = rd + size;
+
+	return size;
+}
+
+int spsc_ring_buf_get_finish(struct spsc_ring_buf *buf, uint32_t size)
+{
+	uint32_t rd = (uint32_t)buf->cons.rd_idx;
+
+	if (size > (buf->cons.tmp_rd_idx - rd)) {
+		return -EINVAL;
+	}
+
+	buf->cons.tmp_rd_idx = rd + size;
+	idx_store(&buf->cons.rd_idx, rd + size);
+
+	return 0;
+}
+
+uint32_t spsc_ring_buf_get(struct spsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = spsc_ring_buf_get_claim(buf, &src, size);
+		memcpy(data, src, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = spsc_ring_buf_get_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
@@ -27,12 +27,28 @@ void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 		handler = work->handler;
 		__ASSERT(handler != NULL, "handler must be provided");
 
+#ifdef CONFIG_WORKQUEUE_STATS
+		/* Done while still pending, a resubmission counts on its own */
+		bool stats = atomic_test_and_clear_bit(work->flags,
+						       K_WORK_STATE_COUNTED);
+
+		if (stats) {
+			z_work_q_stats_started(work_q, work);
+		}
+#endif
+
 		/* Reset pending state so it can be resubmitted by handler */
 		if (atomic_test_and_clear_bit(work->flags,
 					      K_WORK_STATE_PENDING)) {
 			handler(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_STATS
+		if (stats) {
+			z_work_q_stats_finished(work_q);
+		}
+#endif
+
 		/* Make sure we don't hog up the CPU if the FIFO never (or
 		 * very rarely) gets empty.
 		 */
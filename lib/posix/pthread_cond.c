@@ -7,6 +7,7 @@
 #include <kernel.h>
 #include <ksched.h>
 #include <wait_q.h>
+#include <timeout_q.h>
 #include <posix/pthread.h>
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
@@ -17,25 +18,69 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 	__ASSERT(mut->lock_count == 1U, "");
 
 	int ret, key = irq_lock();
+	struct k_thread *thread;
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
+	/* Release the mutex exactly like pthread_mutex_unlock() does,
+	 * handing it straight to the next waiter if there is one
+	 */
+	thread = z_unpend_first_thread(&mut->wait_q);
+	if (thread != NULL) {
+		mut->owner = (pthread_t)thread;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	} else {
+		mut->lock_count = 0U;
+		mut->owner = NULL;
+	}
+
+	/* Tell signal/broadcast which mutex we need back */
+	_current->base.swap_data = mut;
 	ret = z_pend_curr_irqlock(key, &cv->wait_q, timeout);
 
-	/* FIXME: this extra lock (and the potential context switch it
-	 * can cause) could be optimized out.  At the point of the
-	 * signal/broadcast, it's possible to detect whether or not we
-	 * will be swapping back to this particular thread and lock it
-	 * (i.e. leave the lock variable unchanged) on our behalf.
-	 * But that requires putting scheduler intelligence into this
-	 * higher level abstraction and is probably not worth it.
+	/* A signaled waiter is normally handed the mutex by whoever
+	 * releases it (see wake_one() below) and wakes up as its owner.
+	 * Only after a timeout do we still have to take it ourselves.
 	 */
-	pthread_mutex_lock(mut);
+	if (mut->owner != pthread_self()) {
+		pthread_mutex_lock(mut);
+	}
 
 	return ret == -EAGAIN ? ETIMEDOUT : ret;
 }
 
+/* Wakes the first waiter on the condition variable, irq_lock() held.
+ *
+ * Rather than making the waiter runnable only for it to block again
+ * on the mutex the signaling thread most likely still holds, the
+ * waiter is moved onto the mutex's wait queue ("wait morphing") and
+ * will be woken by pthread_mutex_unlock() as the new owner.  If the
+ * mutex is free it is handed over right away.  Either way the waiter
+ * has been signaled, so its timeout no longer applies.
+ */
+static void wake_one(pthread_cond_t *cv)
+{
+	struct k_thread *thread = z_waitq_head(&cv->wait_q);
+	pthread_mutex_t *mut;
+
+	if (thread == NULL) {
+		return;
+	}
+
+	mut = thread->base.swap_data;
+
+	if (mut->owner != NULL) {
+		z_requeue_thread(thread, &mut->wait_q);
+		(void)z_abort_thread_timeout(thread);
+		return;
+	}
+
+	z_unpend_thread(thread);
+	mut->owner = (pthread_t)thread;
+	mut->lock_count = 1U;
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
 /* This implements a "fair" scheduling policy: at the end of a POSIX
  * thread call that might result in a change of the current maximum
  * priority thread, we always check and context switch if needed.
@@ -51,7 +96,7 @@ int pthread_cond_signal(pthread_cond_t *cv)
 {
 	int key = irq_lock();
 
-	_ready_one_thread(&cv->wait_q);
+	wake_one(cv);
 	z_reschedule_irqlock(key);
 
 	return 0;
@@ -61,8 +106,11 @@ int pthread_cond_broadcast(pthread_cond_t *cv)
 {
 	int key = irq_lock();
 
+	/* At most one waiter becomes runnable, the rest queue up on the
+	 * mutex behind it instead of all racing for it at once
+	 */
 	while (z_waitq_head(&cv->wait_q)) {
-		_ready_one_thread(&cv->wait_q);
+		wake_one(cv);
 	}
 
 	z_reschedule_irqlock(key);
@@ -471,11 +471,29 @@ def write_dep_info(node):
     out_dt_define(f"{node.z_path_id}_REQUIRES_ORDS",
                   fmt_dep_list(node.depends_on))
 
+    out_comment("Ordinals for what this node depends on, directly or not:")
+    out_dt_define(f"{node.z_path_id}_REQUIRES_ALL_ORDS",
+                  fmt_dep_list(all_depends_on(node)))
+
     out_comment("Ordinals for what depends directly on this node:")
     out_dt_define(f"{node.z_path_id}_SUPPORTS_ORDS",
                   fmt_dep_list(node.required_by))
 
 
+def all_depends_on(node):
+    # Returns the nodes 'node' depends on, directly or through other nodes
+
+    deps = set()
+    todo = list(node.depends_on)
+    while todo:
+        dep = todo.pop()
+        if dep not in deps:
+            deps.add(dep)
+            todo.extend(dep.depends_on)
+
+    return deps
+
+
 def prop2value(prop):
     # Gets the macro value for property 'prop', if there is
     # a single well-defined C rvalue that it can be represented as.
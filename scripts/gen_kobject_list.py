@@ -90,6 +90,8 @@ from collections import OrderedDict
 # above. Good summary and pointers to official documents at:
 # https://stackoverflow.com/questions/39980323/are-dictionaries-ordered-in-python-3-6
 kobjects = OrderedDict([
+    ("k_condvar", (None, False, True)),
+    ("k_event", (None, False, True)),
     ("k_mem_slab", (None, False, True)),
     ("k_msgq", (None, False, True)),
     ("k_mutex", (None, False, True)),
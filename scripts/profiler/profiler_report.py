@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Symbolize the output of the "profiler show" shell command.
+
+Program counters are resolved to functions using the symbol table of
+zephyr.elf, and counts are summed per function (and optionally per
+thread) to produce a flat profile.
+"""
+
+import argparse
+import bisect
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+
+ROW_RE = re.compile(r"^\s*(\d+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s*(.*)$")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+
+    parser.add_argument("elffile", help="zephyr.elf of the profiled image")
+    parser.add_argument("logfile", nargs="?",
+            help="Captured \"profiler show\" output (default: stdin)")
+    parser.add_argument("--per-thread", action="store_true",
+            help="Report functions separately for every thread")
+
+    return parser.parse_args()
+
+
+class Symbols:
+    def __init__(self, elffile):
+        syms = []
+
+        with open(elffile, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    # Thumb functions have bit 0 set
+                    start = sym["st_value"] & ~1
+                    syms.append((start, start + sym["st_size"], sym.name))
+
+        syms.sort()
+        self.starts = [s[0] for s in syms]
+        self.syms = syms
+
+    def lookup(self, pc):
+        i = bisect.bisect_right(self.starts, pc) - 1
+        if i >= 0:
+            start, end, name = self.syms[i]
+            if pc < end:
+                return name
+
+        return f"0x{pc:08x}"
+
+
+def main():
+    args = parse_args()
+
+    symbols = Symbols(args.elffile)
+    logfile = open(args.logfile, "r") if args.logfile else sys.stdin
+
+    counts = {}
+    total = 0
+    for line in logfile:
+        m = ROW_RE.match(line)
+        if not m:
+            continue
+
+        count = int(m.group(1))
+        func = symbols.lookup(int(m.group(2), 16))
+        if args.per_thread:
+            thread = m.group(4) or f"0x{int(m.group(3), 16):08x}"
+            key = (thread, func)
+        else:
+            key = ("", func)
+
+        counts[key] = counts.get(key, 0) + count
+        total += count
+
+    if total == 0:
+        print("ERROR: No samples found, exiting...")
+        sys.exit(1)
+
+    for (thread, func), count in sorted(counts.items(),
+                                        key=lambda kv: kv[1], reverse=True):
+        pct = 100.0 * count / total
+        if args.per_thread:
+            print(f"{count:8d} {pct:6.2f}%  {thread:<20} {func}")
+        else:
+            print(f"{count:8d} {pct:6.2f}%  {func}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,196 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/atomic.h>
+#include <debug/profiler.h>
+
+#define BUF_SIZE CONFIG_PROFILER_BUFFER_SIZE
+#define HIST_SIZE CONFIG_PROFILER_HISTOGRAM_SIZE
+
+/* Longest probe sequence in the histogram before a sample is counted
+ * as overflow, which bounds the time spent per sample once it fills up.
+ */
+#define HIST_MAX_PROBES 32
+
+BUILD_ASSERT((BUF_SIZE & (BUF_SIZE - 1)) == 0,
+	     "PROFILER_BUFFER_SIZE must be a power of two");
+BUILD_ASSERT((HIST_SIZE & (HIST_SIZE - 1)) == 0,
+	     "PROFILER_HISTOGRAM_SIZE must be a power of two");
+
+struct sample {
+	uintptr_t pc;
+	const struct k_thread *thread;
+};
+
+/* Single producer, single consumer ring: the head is only written from
+ * the sampling interrupt, the tail only with hist_lock held.
+ */
+static struct sample buf[BUF_SIZE];
+static atomic_t buf_head;
+static atomic_t buf_tail;
+
+static atomic_t samples;
+static atomic_t dropped;
+static atomic_t running;
+
+static struct profiler_entry hist[HIST_SIZE];
+static uint32_t overflow;
+static K_MUTEX_DEFINE(hist_lock);
+
+static void aggregate_handler(struct k_work *work);
+static K_DELAYED_WORK_DEFINE(aggregate_work, aggregate_handler);
+
+void z_profiler_sample(uintptr_t pc)
+{
+	uint32_t head = (uint32_t)atomic_get(&buf_head);
+	struct sample *s;
+
+	atomic_inc(&samples);
+
+	if ((head - (uint32_t)atomic_get(&buf_tail)) >= BUF_SIZE) {
+		atomic_inc(&dropped);
+		return;
+	}
+
+	s = &buf[head & (BUF_SIZE - 1)];
+	s->pc = pc;
+	s->thread = k_current_get();
+
+	/* Publish the sample only once it is complete */
+	atomic_set(&buf_head, (atomic_val_t)(head + 1));
+}
+
+static uint32_t hist_hash(uintptr_t pc, const struct k_thread *thread)
+{
+	uint32_t h = (uint32_t)(pc ^ ((uintptr_t)thread >> 4));
+
+	h *= 2654435761U;
+
+	return h ^ (h >> 16);
+}
+
+static void hist_add(uintptr_t pc, const struct k_thread *thread)
+{
+	uint32_t h = hist_hash(pc, thread);
+
+	for (uint32_t i = 0; i < HIST_MAX_PROBES; i++) {
+		struct profiler_entry *e = &hist[(h + i) & (HIST_SIZE - 1)];
+
+		if (e->count == 0U) {
+			e->pc = pc;
+			e->thread = thread;
+			e->count = 1U;
+			return;
+		}
+
+		if ((e->pc == pc) && (e->thread == thread)) {
+			e->count++;
+			return;
+		}
+	}
+
+	overflow++;
+}
+
+/* Move buffered samples into the histogram, with hist_lock held */
+static void aggregate(bool discard)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf_tail);
+	uint32_t head = (uint32_t)atomic_get(&buf_head);
+
+	for (; !discard && (tail != head); tail++) {
+		const struct sample *s = &buf[tail & (BUF_SIZE - 1)];
+
+		hist_add(s->pc, s->thread);
+	}
+
+	atomic_set(&buf_tail, (atomic_val_t)head);
+}
+
+static void aggregate_handler(struct k_work *work)
+{
+	k_mutex_lock(&hist_lock, K_FOREVER);
+	aggregate(false);
+	k_mutex_unlock(&hist_lock);
+
+	if (atomic_get(&running) != 0) {
+		k_delayed_work_submit(&aggregate_work,
+				      K_MSEC(CONFIG_PROFILER_AGGREGATE_INTERVAL));
+	}
+}
+
+int profiler_start(uint32_t period_us)
+{
+	int rc;
+
+	if (period_us == 0U) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	rc = arch_profiler_start(period_us);
+	if (rc != 0) {
+		atomic_clear(&running);
+		return rc;
+	}
+
+	k_delayed_work_submit(&aggregate_work,
+			      K_MSEC(CONFIG_PROFILER_AGGREGATE_INTERVAL));
+
+	return 0;
+}
+
+void profiler_stop(void)
+{
+	if (!atomic_cas(&running, 1, 0)) {
+		return;
+	}
+
+	arch_profiler_stop();
+	k_delayed_work_cancel(&aggregate_work);
+}
+
+bool profiler_is_running(void)
+{
+	return atomic_get(&running) != 0;
+}
+
+void profiler_reset(void)
+{
+	k_mutex_lock(&hist_lock, K_FOREVER);
+	aggregate(true);
+	memset(hist, 0, sizeof(hist));
+	overflow = 0U;
+	atomic_clear(&samples);
+	atomic_clear(&dropped);
+	k_mutex_unlock(&hist_lock);
+}
+
+void profiler_foreach(profiler_cb cb, void *user_data)
+{
+	k_mutex_lock(&hist_lock, K_FOREVER);
+	aggregate(false);
+
+	for (size_t i = 0; i < HIST_SIZE; i++) {
+		if (hist[i].count != 0U) {
+			cb(&hist[i], user_data);
+		}
+	}
+
+	k_mutex_unlock(&hist_lock);
+}
+
+void profiler_stats_get(struct profiler_stats *stats)
+{
+	k_mutex_lock(&hist_lock, K_FOREVER);
+	stats->samples = (uint32_t)atomic_get(&samples);
+	stats->dropped = (uint32_t)atomic_get(&dropped);
+	stats->overflow = overflow;
+	k_mutex_unlock(&hist_lock);
+}
@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <stdlib.h>
+#include <shell/shell.h>
+#include <debug/profiler.h>
+
+#define DEFAULT_PERIOD_US 1000
+#define DEFAULT_SHOW 20
+#define MAX_SHOW 64
+
+struct top_ctx {
+	struct profiler_entry top[MAX_SHOW];
+	size_t max;
+	size_t cnt;
+};
+
+struct name_ctx {
+	const struct k_thread *thread;
+	const char *name;
+};
+
+/* Keep the entries with the highest counts, in descending order */
+static void top_cb(const struct profiler_entry *entry, void *user_data)
+{
+	struct top_ctx *ctx = user_data;
+	size_t i;
+
+	if ((ctx->cnt == ctx->max) &&
+	    (entry->count <= ctx->top[ctx->cnt - 1].count)) {
+		return;
+	}
+
+	if (ctx->cnt < ctx->max) {
+		ctx->cnt++;
+	}
+
+	for (i = ctx->cnt - 1; (i > 0) && (ctx->top[i - 1].count < entry->count);
+	     i--) {
+		ctx->top[i] = ctx->top[i - 1];
+	}
+	ctx->top[i] = *entry;
+}
+
+static void name_cb(const struct k_thread *thread, void *user_data)
+{
+	struct name_ctx *ctx = user_data;
+
+	if (thread == ctx->thread) {
+		ctx->name = k_thread_name_get((k_tid_t)thread);
+	}
+}
+
+/* Only threads which still exist are named, as others may have been
+ * reused for something else.
+ */
+static const char *thread_name(const struct k_thread *thread)
+{
+	struct name_ctx ctx = {
+		.thread = thread,
+	};
+
+	if (IS_ENABLED(CONFIG_THREAD_MONITOR)) {
+		k_thread_foreach_unlocked(name_cb, &ctx);
+	}
+
+	return (ctx.name != NULL) ? ctx.name : "";
+}
+
+static int cmd_profiler_start(const struct shell *shell, size_t argc,
+			      char **argv)
+{
+	uint32_t period_us = DEFAULT_PERIOD_US;
+	int rc;
+
+	if (argc > 1) {
+		period_us = strtoul(argv[1], NULL, 0);
+	}
+
+	rc = profiler_start(period_us);
+	if (rc != 0) {
+		shell_error(shell, "Failed to start profiler (%d)", rc);
+		return rc;
+	}
+
+	shell_print(shell, "Sampling every %u us", period_us);
+
+	return 0;
+}
+
+static int cmd_profiler_stop(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stop();
+
+	return 0;
+}
+
+static int cmd_profiler_reset(const struct shell *shell, size_t argc,
+			      char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_reset();
+
+	return 0;
+}
+
+static int cmd_profiler_show(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	static struct top_ctx ctx;
+	struct profiler_stats stats;
+
+	ctx.max = DEFAULT_SHOW;
+	ctx.cnt = 0;
+	if (argc > 1) {
+		ctx.max = CLAMP(strtoul(argv[1], NULL, 0), 1, MAX_SHOW);
+	}
+
+	profiler_foreach(top_cb, &ctx);
+	profiler_stats_get(&stats);
+
+	shell_print(shell, "%s, %u samples, %u dropped, %u not recorded",
+		    profiler_is_running() ? "running" : "stopped",
+		    stats.samples, stats.dropped, stats.overflow);
+	shell_print(shell, "%8s  %-10s  %-10s  %s", "count", "pc", "thread",
+		    "name");
+
+	for (size_t i = 0; i < ctx.cnt; i++) {
+		const struct profiler_entry *e = &ctx.top[i];
+
+		shell_print(shell, "%8u  0x%08lx  0x%08lx  %s", e->count,
+			    (unsigned long)e->pc, (unsigned long)e->thread,
+			    thread_name(e->thread));
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL,
+		      "Start sampling. Usage: start [period_us]",
+		      cmd_profiler_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling.", cmd_profiler_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear the histogram.",
+		      cmd_profiler_reset, 1, 0),
+	SHELL_CMD_ARG(show, NULL,
+		      "Print the most frequent samples. Usage: show [count]",
+		      cmd_profiler_show, 1, 1),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler", NULL);
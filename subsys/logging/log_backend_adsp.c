@@ -41,6 +41,12 @@ static inline void put(const struct log_backend *const backend,
 {
 	log_backend_std_put(&log_output_adsp, format_flags(), msg);
 }
+
+static inline void put_msg2(const struct log_backend *const backend,
+			    const struct log_msg2 *msg)
+{
+	log_output_msg2_process(&log_output_adsp, msg, format_flags());
+}
 static void panic(struct log_backend const *const backend)
 {
 	log_backend_std_panic(&log_output_adsp);
@@ -76,6 +82,7 @@ const struct log_backend_api log_backend_adsp_api = {
 	.put_sync_hexdump = put_sync_hexdump,
 #else
 	.put = put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
 	.dropped = dropped,
 #endif
 	.panic = panic,
@@ -80,6 +80,24 @@ static void put(const struct log_backend *const backend,
 
 }
 
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	uint32_t flags = LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP;
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_SHOW_COLOR)) {
+		if (posix_trace_over_tty(0)) {
+			flags |= LOG_OUTPUT_FLAG_COLORS;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FORMAT_TIMESTAMP)) {
+		flags |= LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP;
+	}
+
+	log_output_msg2_process(&log_output_posix, msg, flags);
+}
+
 static void panic(struct log_backend const *const backend)
 {
 	log_output_flush(&log_output_posix);
@@ -136,6 +154,7 @@ static void sync_hexdump(const struct log_backend *const backend,
 
 const struct log_backend_api log_backend_native_posix_api = {
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 			sync_string : NULL,
 	.put_sync_hexdump = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
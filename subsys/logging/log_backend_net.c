@@ -194,6 +194,22 @@ static void send_output(const struct log_backend *const backend,
 	log_msg_put(msg);
 }
 
+static void send_output_msg2(const struct log_backend *const backend,
+			     const struct log_msg2 *msg)
+{
+	if (panic_mode) {
+		return;
+	}
+
+	if (!net_init_done && do_net_init() == 0) {
+		net_init_done = true;
+	}
+
+	log_output_msg2_process(&log_output_net, msg,
+				LOG_OUTPUT_FLAG_FORMAT_SYSLOG |
+				LOG_OUTPUT_FLAG_TIMESTAMP);
+}
+
 static void init_net(void)
 {
 	int ret;
@@ -240,6 +256,7 @@ const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : send_output,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? send_output_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 							sync_string : NULL,
 	/* Currently we do not send hexdumps over network to remote server
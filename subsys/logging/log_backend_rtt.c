@@ -243,6 +243,12 @@ static void put(const struct log_backend *const backend,
 	log_backend_std_put(&log_output_rtt, flag, msg);
 }
 
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	log_backend_std_put_msg2(&log_output_rtt, 0, msg);
+}
+
 static void log_backend_rtt_cfg(void)
 {
 	SEGGER_RTT_ConfigUpBuffer(CONFIG_LOG_BACKEND_RTT_BUFFER, "Logger",
@@ -297,6 +303,7 @@ static void sync_hexdump(const struct log_backend *const backend,
 
 const struct log_backend_api log_backend_rtt_api = {
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 			sync_string : NULL,
 	.put_sync_hexdump = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
@@ -6,6 +6,7 @@
 
 #include <logging/log_backend.h>
 #include <logging/log_backend_std.h>
+#include <logging/log_msg2.h>
 #include <logging/log_output.h>
 #include <openthread/platform/logging.h>
 #include <openthread/platform/uart.h>
@@ -39,6 +40,17 @@ static void put(const struct log_backend *const backend,
 	log_backend_std_put(&log_output_spinel, flag, msg);
 }
 
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	/* prevent adding CRLF, which may crash spinel decoding */
+	uint32_t flag = LOG_OUTPUT_FLAG_CRLF_NONE;
+
+	last_log_level = log_msg2_get_level(msg);
+
+	log_backend_std_put_msg2(&log_output_spinel, flag, msg);
+}
+
 static void sync_string(const struct log_backend *const backend,
 			 struct log_msg_ids src_level, uint32_t timestamp,
 			 const char *fmt, va_list ap)
@@ -119,6 +131,7 @@ static int write(uint8_t *data, size_t length, void *ctx)
 
 const struct log_backend_api log_backend_spinel_api = {
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 			sync_string : NULL,
 	.put_sync_hexdump = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
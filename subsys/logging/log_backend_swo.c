@@ -74,6 +74,12 @@ static void log_backend_swo_put(const struct log_backend *const backend,
 	log_backend_std_put(&log_output_swo, flag, msg);
 }
 
+static void log_backend_swo_put_msg2(const struct log_backend *const backend,
+				     const struct log_msg2 *msg)
+{
+	log_backend_std_put_msg2(&log_output_swo, 0, msg);
+}
+
 static void log_backend_swo_init(void)
 {
 	/* Enable DWT and ITM units */
@@ -136,6 +142,7 @@ static void log_backend_swo_sync_hexdump(
 
 const struct log_backend_api log_backend_swo_api = {
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : log_backend_swo_put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? log_backend_swo_put_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 			log_backend_swo_sync_string : NULL,
 	.put_sync_hexdump = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
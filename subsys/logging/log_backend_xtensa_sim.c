@@ -44,6 +44,12 @@ static void put(const struct log_backend *const backend,
 
 }
 
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	log_backend_std_put_msg2(&log_output_xsim, 0, msg);
+}
+
 static void panic(struct log_backend const *const backend)
 {
 	log_backend_std_panic(&log_output_xsim);
@@ -74,6 +80,7 @@ static void sync_hexdump(const struct log_backend *const backend,
 
 const struct log_backend_api log_backend_xtensa_sim_api = {
 	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 			sync_string : NULL,
 	.put_sync_hexdump = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <logging/log_msg.h>
+#include <logging/log_msg2.h>
 #include "log_list.h"
 #include <logging/log.h>
 #include <logging/log_backend.h>
@@ -43,13 +44,22 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_STRDUP_BUF_COUNT 0
 #endif
 
+#ifndef CONFIG_LOG2_RUNTIME_MAX_STRING
+#define CONFIG_LOG2_RUNTIME_MAX_STRING 0
+#endif
+
 struct log_strdup_buf {
 	atomic_t refcount;
 	char buf[CONFIG_LOG_STRDUP_MAX_STRING + 1]; /* for termination */
 };
 
+/* Packaged (v2) messages carry copies of transient strings. */
+#ifdef CONFIG_LOG2
+#define LOG_STRDUP_POOL_BUFFER_SIZE 0
+#else
 #define LOG_STRDUP_POOL_BUFFER_SIZE \
 	(sizeof(struct log_strdup_buf) * CONFIG_LOG_STRDUP_BUF_COUNT)
+#endif
 
 K_SEM_DEFINE(log_process_thread_sem, 0, 1);
 
@@ -182,22 +192,11 @@ static void detect_missed_strdup(struct log_msg *msg)
 #undef ERR_MSG
 }
 
-static inline void msg_finalize(struct log_msg *msg,
-				struct log_msg_ids src_level)
+/* Trigger processing of a message which has just been buffered. */
+static void msg_post_finalize(void)
 {
 	unsigned int key;
 
-	msg->hdr.ids = src_level;
-	msg->hdr.timestamp = timestamp_func();
-
-	atomic_inc(&buffered_cnt);
-
-	key = irq_lock();
-
-	log_list_add_tail(&list, msg);
-
-	irq_unlock(key);
-
 	if (panic_mode) {
 		key = irq_lock();
 		(void)log_process(false);
@@ -215,10 +214,184 @@ static inline void msg_finalize(struct log_msg *msg,
 	}
 }
 
+static inline void msg_finalize(struct log_msg *msg,
+				struct log_msg_ids src_level)
+{
+	unsigned int key;
+
+	msg->hdr.ids = src_level;
+	msg->hdr.timestamp = timestamp_func();
+
+	atomic_inc(&buffered_cnt);
+
+	key = irq_lock();
+
+	log_list_add_tail(&list, msg);
+
+	irq_unlock(key);
+
+	msg_post_finalize();
+}
+
+#ifdef CONFIG_LOG2
+static uint32_t log_msg2_buf[CONFIG_LOG_BUFFER_SIZE / sizeof(uint32_t)];
+static struct mpsc_pbuf_buffer log_msg2_buffer;
+
+static void msg2_drop_notify(const struct mpsc_pbuf_buffer *buffer,
+			     const union mpsc_pbuf_generic *item)
+{
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(item);
+
+	atomic_dec(&buffered_cnt);
+	atomic_inc(&dropped_cnt);
+}
+
+void z_log_msg2_init(void)
+{
+	const struct mpsc_pbuf_buffer_config config = {
+		.buf = log_msg2_buf,
+		.size = ARRAY_SIZE(log_msg2_buf),
+		.notify_drop = msg2_drop_notify,
+		.flags = IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
+			 MPSC_PBUF_MODE_OVERWRITE : 0
+	};
+
+	mpsc_pbuf_init(&log_msg2_buffer, &config);
+}
+
+struct log_msg2 *z_log_msg2_alloc(size_t wlen)
+{
+	struct log_msg2 *msg;
+
+	msg = (struct log_msg2 *)mpsc_pbuf_alloc(&log_msg2_buffer, wlen);
+	if (msg == NULL) {
+		log_dropped();
+	}
+
+	return msg;
+}
+
+void z_log_msg2_commit(struct log_msg2 *msg, struct log_msg_ids src_level)
+{
+	msg->ids = src_level;
+	msg->timestamp = timestamp_func();
+
+	atomic_inc(&buffered_cnt);
+	mpsc_pbuf_commit(&log_msg2_buffer, &msg->buf);
+
+	msg_post_finalize();
+}
+
+void z_log_msg2_static_create(struct log_msg_ids src_level,
+			      const void *package,
+			      const void *data, size_t dlen)
+{
+	struct log_msg2 *msg;
+	int plen;
+
+	plen = cbprintf_package_copy(package, NULL, 0);
+	if (plen < 0) {
+		log_dropped();
+		return;
+	}
+
+	msg = z_log_msg2_alloc(LOG_MSG2_WLEN(plen, dlen));
+	if (msg == NULL) {
+		return;
+	}
+
+	(void)cbprintf_package_copy(package, log_msg2_get_package(msg), plen);
+	msg->pkg_len = (uint16_t)plen;
+	msg->data_len = (uint16_t)dlen;
+	if (dlen != 0U) {
+		memcpy(log_msg2_get_package(msg) + plen, data, dlen);
+	}
+
+	z_log_msg2_commit(msg, src_level);
+}
+
+void z_log_msg2_runtime_vcreate(struct log_msg_ids src_level,
+				const void *data, size_t dlen,
+				const char *fmt, va_list ap)
+{
+	union {
+		char str[CONFIG_LOG2_RUNTIME_MAX_STRING + 1];
+		uint8_t pkg[CONFIG_LOG2_RUNTIME_MAX_STRING + 1]
+			__aligned(sizeof(uint32_t));
+	} buf;
+	uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%s", buf.str)]
+		__aligned(sizeof(uint32_t));
+
+	/* Formatting can be deferred if the format string outlives the
+	 * message, the package holds it by reference.
+	 */
+	if (z_cbprintf_is_rodata(fmt)) {
+		va_list ap2;
+		int plen;
+
+		va_copy(ap2, ap);
+		plen = cbvprintf_package(buf.pkg, sizeof(buf.pkg), fmt, ap2);
+		va_end(ap2);
+
+		if (plen > 0) {
+			z_log_msg2_static_create(src_level, buf.pkg, data, dlen);
+			return;
+		}
+	}
+
+	vsnprintk(buf.str, sizeof(buf.str), fmt, ap);
+	CBPRINTF_STATIC_PACKAGE(pkg, "%s", buf.str);
+	z_log_msg2_static_create(src_level, pkg, data, dlen);
+}
+
+const struct log_msg2 *z_log_msg2_claim(void)
+{
+	return (const struct log_msg2 *)mpsc_pbuf_claim(&log_msg2_buffer);
+}
+
+void z_log_msg2_free(const struct log_msg2 *msg)
+{
+	mpsc_pbuf_free(&log_msg2_buffer, &msg->buf);
+}
+
+bool z_log_msg2_pending(void)
+{
+	return mpsc_pbuf_is_pending(&log_msg2_buffer);
+}
+#endif /* CONFIG_LOG2 */
+
+static void msg2_runtime_create(struct log_msg_ids src_level,
+				const void *data, size_t dlen,
+				const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	z_log_msg2_runtime_vcreate(src_level, data, dlen, fmt, ap);
+	va_end(ap);
+}
+
+/* Arguments of a legacy log message are formatted when it is logged. */
+static void msg2_args_create(struct log_msg_ids src_level, const char *str,
+			     const log_arg_t *args, uint32_t nargs)
+{
+	log_arg_t a[LOG_MAX_NARGS] = { 0 };
+
+	__ASSERT_NO_MSG(nargs <= LOG_MAX_NARGS);
+	memcpy(a, args, nargs * sizeof(log_arg_t));
+
+	msg2_runtime_create(src_level, NULL, 0, str,
+			    a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7],
+			    a[8], a[9], a[10], a[11], a[12], a[13], a[14]);
+}
+
 void log_0(const char *str, struct log_msg_ids src_level)
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_0(str, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_args_create(src_level, str, NULL, 0);
 	} else {
 		struct log_msg *msg = log_msg_create_0(str);
 
@@ -235,6 +408,8 @@ void log_1(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_1(str, arg0, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_args_create(src_level, str, &arg0, 1);
 	} else {
 		struct log_msg *msg = log_msg_create_1(str, arg0);
 
@@ -252,6 +427,10 @@ void log_2(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_2(str, arg0, arg1, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		log_arg_t args[] = { arg0, arg1 };
+
+		msg2_args_create(src_level, str, args, ARRAY_SIZE(args));
 	} else {
 		struct log_msg *msg = log_msg_create_2(str, arg0, arg1);
 
@@ -271,6 +450,10 @@ void log_3(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_3(str, arg0, arg1, arg2, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		log_arg_t args[] = { arg0, arg1, arg2 };
+
+		msg2_args_create(src_level, str, args, ARRAY_SIZE(args));
 	} else {
 		struct log_msg *msg = log_msg_create_3(str, arg0, arg1, arg2);
 
@@ -289,6 +472,8 @@ void log_n(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_n(str, args, narg, src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_args_create(src_level, str, args, narg);
 	} else {
 		struct log_msg *msg = log_msg_create_n(str, args, narg);
 
@@ -306,6 +491,12 @@ void log_hexdump(const char *str, const void *data, uint32_t length,
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_hexdump(str, (const uint8_t *)data, length,
 				     src_level);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%s", str)]
+			__aligned(sizeof(uint32_t));
+
+		CBPRINTF_STATIC_PACKAGE(pkg, "%s", str);
+		z_log_msg2_static_create(src_level, pkg, data, length);
 	} else {
 		struct log_msg *msg =
 			log_msg_hexdump_create(str, (const uint8_t *)data, length);
@@ -339,6 +530,9 @@ void log_printk(const char *fmt, va_list ap)
 		} else if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
 			log_generic(src_level_union.structure, fmt, ap,
 							LOG_STRDUP_SKIP);
+		} else if (IS_ENABLED(CONFIG_LOG2)) {
+			z_log_msg2_runtime_vcreate(src_level_union.structure,
+						   NULL, 0, fmt, ap);
 		} else {
 			uint8_t str[CONFIG_LOG_PRINTK_MAX_STRING_LENGTH + 1];
 			struct log_msg *msg;
@@ -402,6 +596,8 @@ void log_generic(struct log_msg_ids src_level, const char *fmt, va_list ap,
 				va_end(ap_tmp);
 			}
 		}
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		z_log_msg2_runtime_vcreate(src_level, NULL, 0, fmt, ap);
 	} else {
 		log_arg_t args[LOG_MAX_NARGS];
 		uint32_t nargs = log_count_args(fmt);
@@ -480,7 +676,9 @@ void log_core_init(void)
 {
 	uint32_t freq;
 
-	if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		z_log_msg2_init();
+	} else if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
 		log_msg_pool_init();
 		log_list_init(&list);
 
@@ -623,19 +821,17 @@ void z_vrfy_log_panic(void)
 #endif
 
 static bool msg_filter_check(struct log_backend const *backend,
-			     struct log_msg *msg)
+			     struct log_msg_ids ids)
 {
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) {
 		uint32_t backend_level;
-		uint32_t msg_level;
 
 		backend_level = log_filter_get(backend,
-					       log_msg_domain_id_get(msg),
-					       log_msg_source_id_get(msg),
+					       ids.domain_id,
+					       ids.source_id,
 					       true /*enum RUNTIME, COMPILETIME*/);
-		msg_level = log_msg_level_get(msg);
 
-		return (msg_level <= backend_level);
+		return (ids.level <= backend_level);
 	} else {
 		return true;
 	}
@@ -655,7 +851,7 @@ static void msg_process(struct log_msg *msg, bool bypass)
 			backend = log_backend_get(i);
 
 			if (log_backend_is_active(backend) &&
-			    msg_filter_check(backend, msg)) {
+			    msg_filter_check(backend, msg->hdr.ids)) {
 				log_backend_put(backend, msg);
 			}
 		}
@@ -664,6 +860,25 @@ static void msg_process(struct log_msg *msg, bool bypass)
 	log_msg_put(msg);
 }
 
+static void msg2_process(const struct log_msg2 *msg, bool bypass)
+{
+	struct log_backend const *backend;
+
+	if (bypass) {
+		return;
+	}
+
+	for (int i = 0; i < log_backend_count_get(); i++) {
+		backend = log_backend_get(i);
+
+		if (log_backend_is_active(backend) &&
+		    (backend->api->put_msg2 != NULL) &&
+		    msg_filter_check(backend, msg->ids)) {
+			log_backend_put_msg2(backend, msg);
+		}
+	}
+}
+
 void dropped_notify(void)
 {
 	uint32_t dropped = atomic_set(&dropped_cnt, 0);
@@ -679,25 +894,44 @@ void dropped_notify(void)
 
 bool z_impl_log_process(bool bypass)
 {
-	struct log_msg *msg;
+	const struct log_msg2 *msg2 = NULL;
 
 	if (!backend_attached && !bypass) {
 		return false;
 	}
-	unsigned int key = irq_lock();
 
-	msg = log_list_head_get(&list);
-	irq_unlock(key);
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2 = z_log_msg2_claim();
+
+		if (msg2 != NULL) {
+			atomic_dec(&buffered_cnt);
+			msg2_process(msg2, bypass);
+			z_log_msg2_free(msg2);
+		}
+	} else {
+		struct log_msg *msg;
+		unsigned int key = irq_lock();
+
+		msg = log_list_head_get(&list);
+		irq_unlock(key);
 
-	if (msg != NULL) {
-		atomic_dec(&buffered_cnt);
-		msg_process(msg, bypass);
+		if (msg != NULL) {
+			atomic_dec(&buffered_cnt);
+			msg_process(msg, bypass);
+		}
 	}
 
 	if (!bypass && dropped_cnt) {
 		dropped_notify();
 	}
 
+	if (IS_ENABLED(CONFIG_LOG2)) {
+		/* A message which is allocated but not committed yet cannot
+		 * be claimed, so only a successful claim means progress.
+		 */
+		return (msg2 != NULL);
+	}
+
 	return (log_list_head_peek(&list) != NULL);
 }
 
@@ -886,7 +1120,7 @@ char *log_strdup(const char *str)
 	struct log_strdup_buf *dup;
 	int err;
 
-	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) ||
+	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) || IS_ENABLED(CONFIG_LOG2) ||
 	    is_rodata(str) || _is_user_context()) {
 		return (char *)str;
 	}
@@ -1005,6 +1239,9 @@ void z_vrfy_z_log_string_from_user(uint32_t src_level_val, const char *str)
 
 	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
 		log_string_sync(src_level_union.structure, "%s", str);
+	} else if (IS_ENABLED(CONFIG_LOG2)) {
+		msg2_runtime_create(src_level_union.structure, NULL, 0,
+				    "%s", str);
 	} else if (IS_ENABLED(CONFIG_LOG_PRINTK) &&
 		   (level == LOG_LEVEL_INTERNAL_RAW_STRING)) {
 		struct log_msg *msg;
@@ -1184,7 +1421,16 @@ static void log_process_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	while (true) {
 		if (log_process(false) == false) {
-			k_sem_take(&log_process_thread_sem, K_FOREVER);
+			k_timeout_t timeout = K_FOREVER;
+
+			/* A message which is not committed yet holds back
+			 * the ones after it, check again later.
+			 */
+			if (IS_ENABLED(CONFIG_LOG2) && z_log_msg2_pending()) {
+				timeout = K_MSEC(CONFIG_LOG_PROCESS_THREAD_SLEEP_MS);
+			}
+
+			k_sem_take(&log_process_thread_sem, timeout);
 		}
 	}
 }
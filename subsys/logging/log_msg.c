@@ -37,12 +37,19 @@ BUILD_ASSERT((sizeof(union log_msg_head_data) ==
 #define CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS 0
 #endif
 
+/* Packaged (v2) messages are allocated from a buffer in log_core.c. */
+#ifdef CONFIG_LOG2
+#define LOG_MSG_POOL_SIZE 0
+#else
+#define LOG_MSG_POOL_SIZE CONFIG_LOG_BUFFER_SIZE
+#endif
+
 #define MSG_SIZE sizeof(union log_msg_chunk)
-#define NUM_OF_MSGS (CONFIG_LOG_BUFFER_SIZE / MSG_SIZE)
+#define NUM_OF_MSGS (LOG_MSG_POOL_SIZE / MSG_SIZE)
 
 struct k_mem_slab log_msg_pool;
 static uint8_t __noinit __aligned(sizeof(void *))
-		log_msg_pool_buf[CONFIG_LOG_BUFFER_SIZE];
+		log_msg_pool_buf[LOG_MSG_POOL_SIZE];
 
 void log_msg_pool_init(void)
 {
@@ -7,6 +7,7 @@
 #include <logging/log_output.h>
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
+#include <logging/log_msg2.h>
 #include <sys/__assert.h>
 #include <sys/cbprintf.h>
 #include <ctype.h>
@@ -548,6 +549,52 @@ void log_output_msg_process(const struct log_output *log_output,
 	log_output_flush(log_output);
 }
 
+void log_output_msg2_process(const struct log_output *log_output,
+			     const struct log_msg2 *msg,
+			     uint32_t flags)
+{
+	uint32_t timestamp = log_msg2_get_timestamp(msg);
+	uint8_t level = (uint8_t)log_msg2_get_level(msg);
+	uint8_t domain_id = (uint8_t)log_msg2_get_domain(msg);
+	uint16_t source_id = (uint16_t)log_msg2_get_source(msg);
+	bool raw_string = (level == LOG_LEVEL_INTERNAL_RAW_STRING);
+	const uint8_t *data;
+	size_t len;
+	int prefix_offset;
+
+	data = log_msg2_get_data(msg, &len);
+
+	prefix_offset = raw_string ?
+			0 : prefix_print(log_output, flags, len == 0U,
+					 timestamp, level, domain_id,
+					 source_id);
+
+	(void)cbpprintf(out_func, (void *)log_output,
+			log_msg2_get_package(msg));
+
+	while (len) {
+		uint32_t part_len = MIN(len, HEXDUMP_BYTES_IN_LINE);
+
+		hexdump_line_print(log_output, data, part_len,
+				   prefix_offset, flags);
+		data += part_len;
+		len -= part_len;
+	}
+
+	if (raw_string) {
+		uint32_t offset = log_output->control_block->offset;
+
+		/* add \r if string ends with newline. */
+		if ((offset != 0U) && (log_output->buf[offset - 1] == '\n')) {
+			print_formatted(log_output, "\r");
+		}
+	} else {
+		postfix_print(log_output, flags, level);
+	}
+
+	log_output_flush(log_output);
+}
+
 static bool ends_with_newline(const char *fmt)
 {
 	char c = '\0';
@@ -54,11 +54,28 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+#if defined(CONFIG_NET_CONN_HASH_BUCKETS)
+#define CONN_HASH_BUCKETS CONFIG_NET_CONN_HASH_BUCKETS
+#else
+#define CONN_HASH_BUCKETS 1
+#endif
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Lookup tables for received UDP and TCP packets. Every used connection
+ * is in exactly one chain: in conn_hash4 if it has a remote address,
+ * a remote port and a local port, else in conn_hash2 if it has a local
+ * port, else in conn_wild, which also holds all the connections of other
+ * protocols. Like conn_used, chains are ordered newest connection first.
+ */
+static sys_slist_t conn_hash4[CONN_HASH_BUCKETS];
+static sys_slist_t conn_hash2[CONN_HASH_BUCKETS];
+static sys_slist_t conn_wild;
+static uint32_t conn_seq;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +130,84 @@ void conn_register_debug(struct net_conn *conn,
 #define conn_register_debug(...)
 #endif /* (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG) */
 
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash = (hash ^ val) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+uint32_t net_conn_hash(uint16_t proto, sa_family_t family, const void *addr,
+		       uint16_t remote_port, uint16_t local_port)
+{
+	uint32_t hash;
+
+	hash = conn_hash_mix(proto, ((uint32_t)remote_port << 16) | local_port);
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr && family == AF_INET6) {
+		const struct in6_addr *addr6 = addr;
+
+		for (int i = 0; i < ARRAY_SIZE(addr6->s6_addr32); i++) {
+			hash = conn_hash_mix(hash,
+					UNALIGNED_GET(&addr6->s6_addr32[i]));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && addr && family == AF_INET) {
+		const struct in_addr *addr4 = addr;
+
+		hash = conn_hash_mix(hash, UNALIGNED_GET(&addr4->s_addr));
+	}
+
+	return hash;
+}
+
+/* Return the IP address of a socket address if it is a specified one */
+static const void *conn_spec_addr(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		if (!net_ipv6_is_addr_unspecified(&net_sin6(addr)->sin6_addr)) {
+			return &net_sin6(addr)->sin6_addr;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && addr->sa_family == AF_INET) {
+		if (net_sin(addr)->sin_addr.s_addr) {
+			return &net_sin(addr)->sin_addr;
+		}
+	}
+
+	return NULL;
+}
+
+/* Chain of a connection, addr is NULL unless the remote address is
+ * specified and ports are in network byte order, 0 when not specified.
+ */
+static sys_slist_t *conn_get_chain(uint16_t proto, sa_family_t family,
+				   const void *addr, uint16_t remote_port,
+				   uint16_t local_port)
+{
+	uint32_t hash;
+
+	if ((proto != IPPROTO_UDP && proto != IPPROTO_TCP) || !local_port) {
+		return &conn_wild;
+	}
+
+	if (addr && remote_port) {
+		hash = net_conn_hash(proto, family, addr, remote_port,
+				     local_port);
+		return &conn_hash4[hash % CONN_HASH_BUCKETS];
+	}
+
+	hash = net_conn_hash(proto, AF_UNSPEC, NULL, 0, local_port);
+
+	return &conn_hash2[hash % CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_chain(struct net_conn *conn)
+{
+	return conn_get_chain(conn->proto, conn->remote_addr.sa_family,
+			      conn_spec_addr(&conn->remote_addr),
+			      net_sin(&conn->remote_addr)->sin_port,
+			      net_sin(&conn->local_addr)->sin_port);
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -130,8 +225,10 @@ static struct net_conn *conn_get_unused(void)
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
+	conn->seq = conn_seq++;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_chain(conn), &conn->hash_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -150,8 +247,15 @@ static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
 {
 	struct net_conn *conn;
 	struct net_conn *tmp;
+	sys_slist_t *chain;
+
+	/* An identical handler is in the chain the new one would be in */
+	chain = conn_get_chain(proto,
+			       remote_addr ? remote_addr->sa_family : AF_UNSPEC,
+			       remote_addr ? conn_spec_addr(remote_addr) : NULL,
+			       htons(remote_port), htons(local_port));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(chain, conn, tmp, hash_node) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -378,6 +482,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_chain(conn), &conn->hash_node);
 
 	conn_set_unused(conn);
 
@@ -457,6 +562,127 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+static bool conn_is_match(struct net_conn *conn, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Find the connection of a unicast UDP or TCP packet. The candidate
+ * chains are merged newest connection first, which is the order of
+ * conn_used, so the selection is the one of a walk of conn_used: the
+ * highest ranked match, unless a match specifying the remote port is
+ * found first.
+ */
+static struct net_conn *conn_lookup(struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    uint8_t proto,
+				    uint16_t src_port,
+				    uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	sys_snode_t *next[3];
+	struct net_conn *conn;
+	const void *src;
+	uint32_t hash;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else {
+		src = &ip_hdr->ipv4->src;
+	}
+
+	next[0] = NULL;
+	next[1] = NULL;
+	next[2] = sys_slist_peek_head(&conn_wild);
+
+	if (dst_port) {
+		hash = net_conn_hash(proto, family, src, src_port, dst_port);
+		next[0] = sys_slist_peek_head(
+				&conn_hash4[hash % CONN_HASH_BUCKETS]);
+
+		hash = net_conn_hash(proto, AF_UNSPEC, NULL, 0, dst_port);
+		next[1] = sys_slist_peek_head(
+				&conn_hash2[hash % CONN_HASH_BUCKETS]);
+	}
+
+	while (true) {
+		int n = -1;
+
+		for (int i = 0; i < ARRAY_SIZE(next); i++) {
+			if (next[i] == NULL) {
+				continue;
+			}
+
+			if (n < 0 ||
+			    (int32_t)(CONTAINER_OF(next[i], struct net_conn,
+						   hash_node)->seq -
+				      CONTAINER_OF(next[n], struct net_conn,
+						   hash_node)->seq) > 0) {
+				n = i;
+			}
+		}
+
+		if (n < 0) {
+			break;
+		}
+
+		conn = CONTAINER_OF(next[n], struct net_conn, hash_node);
+		next[n] = sys_slist_peek_next(next[n]);
+
+		if (conn->proto != proto) {
+			continue;
+		}
+
+		if (conn->family != AF_UNSPEC && conn->family != family) {
+			continue;
+		}
+
+		if (!conn_is_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+			continue;
+		}
+
+		if (best_rank < NET_CONN_RANK(conn->flags)) {
+			best_rank = NET_CONN_RANK(conn->flags);
+			best_match = conn;
+		}
+
+		/* A listening connection found later must not override */
+		if (best_match->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			break;
+		}
+	}
+
+	return best_match;
+}
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -580,6 +806,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* Unicast UDP and TCP packets are matched through the lookup
+	 * tables, others are checked against every connection.
+	 */
+	if (((IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+	     (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP)) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6) && !is_mcast_pkt) {
+		best_match = conn_lookup(pkt, ip_hdr, proto,
+					 src_port, dst_port);
+		goto deliver;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* For packet socket data, the proto is set to ETH_P_ALL but
 		 * the listener might have a specific protocol set. This is ok
@@ -603,34 +841,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_is_match(conn, pkt, ip_hdr,
+					   src_port, dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -730,6 +943,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+deliver:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -789,6 +1003,12 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wild);
+
+	for (i = 0; i < CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash4[i]);
+		sys_slist_init(&conn_hash2[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
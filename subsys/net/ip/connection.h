@@ -50,6 +50,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Node in the lookup table chain of the connection */
+	sys_snode_t hash_node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -70,6 +73,9 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+	/** Registration order, newer connections have a higher value */
+	uint32_t seq;
 };
 
 /**
@@ -179,6 +185,21 @@ static inline enum net_verdict net_conn_input(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_UDP || CONFIG_NET_TCP  || CONFIG_NET_SOCKETS_PACKET */
 
+/**
+ * @brief Hash a connection end point for a connection lookup table.
+ *
+ * @param proto Protocol of the connection
+ * @param family Family of the remote address, AF_INET or AF_INET6
+ * @param addr Remote IP address, struct in_addr or struct in6_addr, or
+ *        NULL to hash the ports only.
+ * @param remote_port Remote port in network byte order
+ * @param local_port Local port in network byte order
+ *
+ * @return Hash value, to be reduced to the table size by the caller.
+ */
+uint32_t net_conn_hash(uint16_t proto, sa_family_t family, const void *addr,
+		       uint16_t remote_port, uint16_t local_port);
+
 /**
  * @typedef net_conn_foreach_cb_t
  * @brief Callback used while iterating over network connection
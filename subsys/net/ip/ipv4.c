@@ -277,6 +277,22 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		goto drop;
 	}
 
+	if (sys_get_be16(hdr->offset) &
+	    (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAG_OFFSET_MASK)) {
+		if (!IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT)) {
+			NET_DBG("DROP: fragmented packet");
+			net_stats_update_ip_errors_fragerr(net_pkt_iface(pkt));
+			goto drop;
+		}
+
+		verdict = net_ipv4_handle_fragment_hdr(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	net_pkt_acknowledge_data(pkt, &ipv4_access);
 
 	if (opts_len) {
@@ -35,6 +35,11 @@
 
 #define NET_IPV4_HDR_OPTNS_MAX_LEN 40
 
+/* IPv4 fragment flags and offset, the offset field in host byte order */
+#define NET_IPV4_DO_NOT_FRAG_MASK 0x4000
+#define NET_IPV4_MORE_FRAG_MASK   0x2000
+#define NET_IPV4_FRAG_OFFSET_MASK 0x1FFF
+
 /**
  * @brief Create IPv4 packet in provided net_pkt.
  *
@@ -132,4 +137,108 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT_MAX_PKT)
+#define NET_IPV4_FRAGMENTS_MAX_PKT CONFIG_NET_IPV4_FRAGMENT_MAX_PKT
+#else
+#define NET_IPV4_FRAGMENTS_MAX_PKT 2
+#endif
+
+/** Store pending IPv4 fragment information that is needed for reassembly. */
+struct net_ipv4_reassembly {
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_delayed_work timer;
+
+	/** Pointers to pending fragments, sorted by offset */
+	struct net_pkt *pkt[NET_IPV4_FRAGMENTS_MAX_PKT];
+
+	/** Offset of each pending fragment in the datagram payload */
+	uint16_t offset[NET_IPV4_FRAGMENTS_MAX_PKT];
+
+	/** Payload length, known once the last fragment is received */
+	uint16_t len;
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** Protocol of the fragmented datagram */
+	uint8_t proto;
+
+	/** Number of pending fragments */
+	uint8_t count;
+};
+
+/**
+ * @typedef net_ipv4_frag_cb_t
+ * @brief Callback used while iterating over pending IPv4 fragments.
+ *
+ * @param reass IPv4 fragment reassembly struct
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_ipv4_frag_cb_t)(struct net_ipv4_reassembly *reass,
+				   void *user_data);
+
+/**
+ * @brief Go through all the currently pending IPv4 fragments.
+ *
+ * @param cb Callback to call for each pending IPv4 fragment.
+ * @param user_data User specified data or NULL.
+ */
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * @param pkt Network head packet.
+ * @param hdr The IPv4 header of the current packet
+ *
+ * @return Return verdict about the packet
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Fragment an IPv4 packet that does not fit into the MTU of
+ * the network interface, and send the fragments.
+ *
+ * @param iface Network interface the packet is sent to
+ * @param pkt Network packet, already finalized
+ *
+ * @return NET_OK if the packet can be sent as is, NET_CONTINUE if it was
+ * sent as fragments and released, NET_DROP if it cannot be sent.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_prepare_for_send(struct net_if *iface,
+					   struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(struct net_if *iface,
+							 struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #endif /* __IPV4_H */
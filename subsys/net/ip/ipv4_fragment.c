@@ -0,0 +1,536 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_stats.h>
+#include <net/net_context.h>
+#include <random/rand32.h>
+#include "net_private.h"
+#include "icmpv4.h"
+#include "ipv4.h"
+#include "net_stats.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+static void reassembly_timeout(struct k_work *work);
+static bool reassembly_init_done;
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+/* Fragments are received by the RX threads and expire in the system work
+ * queue, so the slots are only touched with this held.
+ */
+static K_MUTEX_DEFINE(reassembly_lock);
+
+static void reassembly_init(void)
+{
+	int i;
+
+	/* Static initializing does not work here because of the array
+	 * so we must do it at runtime.
+	 */
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		k_delayed_work_init(&reassembly[i].timer, reassembly_timeout);
+	}
+
+	reassembly_init_done = true;
+}
+
+static inline uint16_t frag_hdr_len(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+}
+
+static inline uint16_t frag_data_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - frag_hdr_len(pkt);
+}
+
+static struct net_ipv4_reassembly *reassembly_get(uint16_t id,
+						  struct in_addr *src,
+						  struct in_addr *dst,
+						  uint8_t proto)
+{
+	int i, avail = -1;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!reassembly[i].count) {
+			if (avail < 0) {
+				avail = i;
+			}
+
+			continue;
+		}
+
+		if (reassembly[i].id == id &&
+		    reassembly[i].proto == proto &&
+		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
+		    net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+			return &reassembly[i];
+		}
+	}
+
+	if (avail < 0) {
+		return NULL;
+	}
+
+	k_delayed_work_submit(&reassembly[avail].timer,
+			      IPV4_REASSEMBLY_TIMEOUT);
+
+	net_ipaddr_copy(&reassembly[avail].src, src);
+	net_ipaddr_copy(&reassembly[avail].dst, dst);
+
+	reassembly[avail].id = id;
+	reassembly[avail].proto = proto;
+	reassembly[avail].len = 0U;
+
+	return &reassembly[avail];
+}
+
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
+{
+	int i;
+
+	NET_DBG("Cancel 0x%x", reass->id);
+
+	k_delayed_work_cancel(&reass->timer);
+
+	for (i = 0; i < reass->count; i++) {
+		if (!reass->pkt[i]) {
+			continue;
+		}
+
+		NET_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data",
+			i, reass->pkt[i], net_pkt_get_len(reass->pkt[i]));
+
+		net_stats_update_ipv4_frag_drop(net_pkt_iface(reass->pkt[i]));
+
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
+	}
+
+	reass->count = 0U;
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		log_strdup(net_sprint_ipv4_addr(&reass->src)),
+		log_strdup(net_sprint_ipv4_addr(&reass->dst)),
+		k_delayed_work_remaining_get(&reass->timer));
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(work, struct net_ipv4_reassembly, timer);
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The slot might have been completed, and even reused, while
+	 * we were waiting for the lock.
+	 */
+	if (reass->count && !k_delayed_work_remaining_get(&reass->timer)) {
+		reassembly_info("Reassembly cancelled", reass);
+
+		/* RFC 792, only if the first fragment is available */
+		if (reass->offset[0] == 0U) {
+			net_icmpv4_send_error(reass->pkt[0],
+					      NET_ICMPV4_TIME_EXCEEDED,
+					      NET_ICMPV4_TIME_EXCEEDED_REASM);
+		}
+
+		reassembly_cancel(reass);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+/* Verify that the fragments cover the whole payload without holes */
+static bool fragments_complete(struct net_ipv4_reassembly *reass)
+{
+	uint16_t expected = 0U;
+	int i;
+
+	for (i = 0; i < reass->count; i++) {
+		if (reass->offset[i] != expected) {
+			return false;
+		}
+
+		expected += frag_data_len(reass->pkt[i]);
+	}
+
+	return expected == reass->len;
+}
+
+static void reassemble_packet(struct net_ipv4_reassembly *reass)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	struct net_buf *last;
+	int i;
+
+	k_delayed_work_cancel(&reass->timer);
+
+	last = net_buf_frag_last(reass->pkt[0]->buffer);
+
+	/* We start from 2nd packet which is then appended to
+	 * the first one.
+	 */
+	for (i = 1; i < reass->count; i++) {
+		pkt = reass->pkt[i];
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_pull(pkt, frag_hdr_len(pkt))) {
+			NET_ERR("Failed to pull headers");
+			reassembly_cancel(reass);
+			return;
+		}
+
+		/* Attach the data to previous pkt */
+		last->frags = pkt->buffer;
+		last = net_buf_frag_last(pkt->buffer);
+
+		pkt->buffer = NULL;
+		reass->pkt[i] = NULL;
+
+		net_pkt_unref(pkt);
+	}
+
+	pkt = reass->pkt[0];
+	reass->pkt[0] = NULL;
+	reass->count = 0U;
+
+	/* The header of the first fragment is the one of the datagram */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		goto error;
+	}
+
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->offset[0] = 0U;
+	hdr->offset[1] = 0U;
+	hdr->chksum = 0U;
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_data(pkt, &ipv4_access);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt, net_pkt_get_len(pkt));
+
+	net_stats_update_ipv4_frag_reassembled(net_pkt_iface(pkt));
+
+	/* Feed the datagram back through the RX queue, see the comment in
+	 * the IPv6 reassembly. The packet has no link layer header, so
+	 * process_data() must not pass it to L2.
+	 */
+	net_pkt_set_ipv4_reassembled(pkt, true);
+
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
+{
+	int i;
+
+	if (!reassembly_init_done) {
+		return;
+	}
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!reassembly[i].count) {
+			continue;
+		}
+
+		cb(&reassembly[i], user_data);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass;
+	uint16_t flag = sys_get_be16(hdr->offset);
+	uint16_t offset = (flag & NET_IPV4_FRAG_OFFSET_MASK) * 8U;
+	uint16_t len = frag_data_len(pkt);
+	bool more = flag & NET_IPV4_MORE_FRAG_MASK;
+	uint32_t end = (uint32_t)offset + len;
+	int i;
+
+	net_stats_update_ipv4_frag_recv(net_pkt_iface(pkt));
+
+	/* All but the last fragment carry a multiple of 8 bytes */
+	if (len == 0U || (more && (len % 8U)) ||
+	    end + frag_hdr_len(pkt) > UINT16_MAX) {
+		NET_DBG("DROP: invalid fragment, offset %u len %u",
+			offset, len);
+		goto drop;
+	}
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	if (!reassembly_init_done) {
+		reassembly_init();
+	}
+
+	reass = reassembly_get(sys_get_be16(hdr->id), &hdr->src, &hdr->dst,
+			       hdr->proto);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		goto unlock;
+	}
+
+	/* The fragments might come in wrong order so keep them sorted */
+	for (i = 0; i < reass->count && reass->offset[i] < offset; i++) {
+	}
+
+	if (i < reass->count && reass->offset[i] == offset &&
+	    frag_data_len(reass->pkt[i]) == len) {
+		NET_DBG("Duplicate fragment, offset %u", offset);
+		goto unlock;
+	}
+
+	/* Overlapping fragments are a sign of an attack rather than of a
+	 * retransmission, so give up the datagram as RFC 5722 does for IPv6.
+	 */
+	if ((i > 0 && reass->offset[i - 1] +
+		      frag_data_len(reass->pkt[i - 1]) > offset) ||
+	    (i < reass->count && end > reass->offset[i]) ||
+	    (reass->len && end > reass->len) ||
+	    (!more && (reass->len || i < reass->count))) {
+		NET_DBG("Invalid fragment, offset %u len %u", offset, len);
+		goto cancel;
+	}
+
+	if (reass->count == NET_IPV4_FRAGMENTS_MAX_PKT) {
+		NET_DBG("No slots available for 0x%x", reass->id);
+		goto cancel;
+	}
+
+	memmove(&reass->pkt[i + 1], &reass->pkt[i],
+		(reass->count - i) * sizeof(reass->pkt[0]));
+	memmove(&reass->offset[i + 1], &reass->offset[i],
+		(reass->count - i) * sizeof(reass->offset[0]));
+
+	NET_DBG("Storing pkt %p to slot %d offset %u", pkt, i, offset);
+
+	reass->pkt[i] = pkt;
+	reass->offset[i] = offset;
+	reass->count++;
+
+	if (!more) {
+		reass->len = end;
+		reassembly_info("Reassembly last pkt", reass);
+	}
+
+	if (reass->len && fragments_complete(reass)) {
+		reassemble_packet(reass);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+
+	return NET_OK;
+
+cancel:
+	reassembly_cancel(reass);
+unlock:
+	k_mutex_unlock(&reassembly_lock);
+drop:
+	net_stats_update_ipv4_frag_drop(net_pkt_iface(pkt));
+
+	return NET_DROP;
+}
+
+static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t id,
+			      uint16_t fit_len, uint16_t frag_offset,
+			      uint16_t flag)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *frag_pkt;
+	uint8_t opts_len;
+	int ret = -ENOBUFS;
+
+	/* Options are not copied to the other fragments. The ones we
+	 * support do not have the copied flag set.
+	 */
+	opts_len = frag_offset ? 0U : net_pkt_ipv4_opts_len(pkt);
+
+	frag_pkt = net_pkt_alloc_with_buffer(iface, opts_len + fit_len,
+					     AF_INET, 0, BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(frag_pkt, pkt, net_pkt_ip_hdr_len(pkt) + opts_len) ||
+	    net_pkt_skip(pkt, net_pkt_ipv4_opts_len(pkt) - opts_len) ||
+	    net_pkt_skip(pkt, frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(frag_pkt, opts_len);
+
+	net_pkt_cursor_init(frag_pkt);
+	net_pkt_set_overwrite(frag_pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt, &ipv4_access);
+	if (!hdr) {
+		goto fail;
+	}
+
+	/* The upper layer checksum was computed over the whole datagram,
+	 * only the IPv4 header is updated.
+	 */
+	hdr->vhl = 0x40 | (frag_hdr_len(frag_pkt) / 4U);
+	hdr->len = htons(net_pkt_get_len(frag_pkt));
+	sys_put_be16(id, hdr->id);
+	sys_put_be16(flag, hdr->offset);
+	hdr->chksum = 0U;
+
+	if (net_if_need_calc_tx_checksum(iface)) {
+		hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	}
+
+	net_pkt_set_data(frag_pkt, &ipv4_access);
+
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_stats_update_ipv4_frag_sent(iface);
+
+	/* Let this packet to be sent and hopefully it will release
+	 * the memory that can be utilized for next sent IPv4 fragment.
+	 */
+	k_yield();
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+static int send_fragmented_pkt(struct net_pkt *pkt, uint16_t mtu,
+			       uint16_t flag)
+{
+	uint16_t hdr_len = frag_hdr_len(pkt);
+	uint16_t id = (uint16_t)sys_rand32_get();
+	uint16_t frag_offset = 0U;
+	size_t length;
+	int fit_len;
+	int ret;
+
+	/* Fragment payload is a multiple of 8 bytes, except the last one */
+	fit_len = (mtu - hdr_len) & ~7;
+	if (fit_len <= 0) {
+		NET_DBG("No room for IPv4 payload MTU %u hdr_len %u",
+			mtu, hdr_len);
+		return -EINVAL;
+	}
+
+	length = net_pkt_get_len(pkt) - hdr_len;
+	while (length) {
+		bool final = false;
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		/* A fragment being fragmented again keeps its own offset
+		 * and MF flag.
+		 */
+		ret = send_ipv4_fragment(pkt, id, fit_len, frag_offset,
+					 (flag + frag_offset / 8U) |
+					 (final ? 0 : NET_IPV4_MORE_FRAG_MASK));
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_if *iface,
+					   struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	uint16_t mtu = net_if_get_mtu(iface);
+	struct net_ipv4_hdr *hdr;
+	uint16_t flag;
+	int ret;
+
+	/* Interfaces without an MTU, such as the loopback, take any size.
+	 * TCP super-segments are split by TCP or by the device.
+	 */
+	if (mtu == 0U || net_pkt_get_len(pkt) <= mtu ||
+	    net_pkt_gso_size(pkt)) {
+		return NET_OK;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		return NET_DROP;
+	}
+
+	flag = sys_get_be16(hdr->offset);
+	if (flag & NET_IPV4_DO_NOT_FRAG_MASK) {
+		NET_DBG("DROP: pkt %p len %zd > MTU %u, DF set", pkt,
+			net_pkt_get_len(pkt), mtu);
+		return NET_DROP;
+	}
+
+	ret = send_fragmented_pkt(pkt, mtu,
+				  flag & (NET_IPV4_MORE_FRAG_MASK |
+					  NET_IPV4_FRAG_OFFSET_MASK));
+	if (ret < 0) {
+		NET_DBG("Cannot fragment pkt %p (%d)", pkt, ret);
+		return NET_DROP;
+	}
+
+	/* The fragments were sent, the original packet is not needed */
+	net_pkt_unref(pkt);
+
+	return NET_CONTINUE;
+}
@@ -21,8 +21,10 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include <net/ethernet.h>
 
 #include "net_private.h"
+#include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -451,6 +453,23 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		goto done;
 	}
 
+	/* TCP super-segments are split here unless the device does it */
+	if (net_pkt_gso_size(pkt) && net_if_need_tcp_segmentation(iface)) {
+		status = net_tcp_gso_send(iface, pkt);
+		verdict = status < 0 ? NET_DROP : NET_CONTINUE;
+		goto done;
+	}
+
+	/* IPv4 datagrams larger than the MTU are fragmented here */
+	if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_prepare_for_send(iface, pkt);
+		if (verdict != NET_OK) {
+			status = -EMSGSIZE;
+			goto done;
+		}
+	}
+
 	/* If the ll address is not set at all, then we must set
 	 * it here.
 	 * Workaround Linux bug, see:
@@ -3506,7 +3525,7 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 	}
 }
 
-static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
+static bool need_sw_offload(struct net_if *iface, enum ethernet_hw_caps caps)
 {
 #if defined(CONFIG_NET_L2_ETHERNET)
 	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
@@ -3521,12 +3540,17 @@ static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
 
 bool net_if_need_calc_tx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
+	return need_sw_offload(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
 }
 
 bool net_if_need_calc_rx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+	return need_sw_offload(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+}
+
+bool net_if_need_tcp_segmentation(struct net_if *iface)
+{
+	return need_sw_offload(iface, ETHERNET_HW_TSO);
 }
 
 int net_if_get_by_iface(struct net_if *iface)
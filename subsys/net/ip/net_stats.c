@@ -105,6 +105,13 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv4.sent),
 			 GET_STAT(iface, ipv4.drop),
 			 GET_STAT(iface, ipv4.forwarded));
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT)
+		NET_INFO("IPv4 frag recv %d\tsent\t%d\treasm\t%d\tdrop\t%d",
+			 GET_STAT(iface, ipv4_frag.recv),
+			 GET_STAT(iface, ipv4_frag.sent),
+			 GET_STAT(iface, ipv4_frag.reassembled),
+			 GET_STAT(iface, ipv4_frag.drop));
+#endif /* CONFIG_NET_STATISTICS_IPV4_FRAGMENT */
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
 		NET_INFO("IP vhlerr      %d\thblener\t%d\tlblener\t%d",
@@ -152,6 +159,10 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+		NET_INFO("TCP seg ooo    %d\tooodrop\t%d\tsackrexmit\t%d",
+			 GET_STAT(iface, tcp.ooo),
+			 GET_STAT(iface, tcp.ooodrop),
+			 GET_STAT(iface, tcp.sackrexmit));
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
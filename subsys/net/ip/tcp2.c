@@ -29,8 +29,20 @@ static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_window = NET_IPV6_MTU;
 
+#define TCP_RTO_MAX_MS (60 * MSEC_PER_SEC)
+#define TCP_DUP_ACK_THRESHOLD 3
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+static const struct tcp_cc *tcp_cc = &tcp_cc_cubic;
+#else
+static const struct tcp_cc *tcp_cc = &tcp_cc_newreno;
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
+/* Connections with their end points set, by remote address and ports */
+static sys_slist_t tcp_conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+
 static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -325,6 +337,71 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Merged data is bounded like the out-of-order queue, it holds RX buffers */
+#define TCP_GRO_MAX MIN(CONFIG_NET_TCP_GRO_MAX_SIZE,			\
+			(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3)
+
+/* Move the merged data to the recv_data fifo */
+static void tcp_gro_flush(struct tcp *conn)
+{
+	if (!conn->gro_data) {
+		return;
+	}
+
+	NET_DBG("conn: %p %zu bytes", conn, conn->gro_len);
+
+	net_pkt_cursor_init(conn->gro_data);
+	k_fifo_put(&conn->recv_data, conn->gro_data);
+
+	conn->gro_data = NULL;
+	conn->gro_len = 0;
+
+	k_delayed_work_cancel(&conn->gro_timer);
+}
+
+static void tcp_gro_timeout(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, gro_timer);
+	struct net_conn *conn_handler = NULL;
+	struct net_pkt *pkt;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	tcp_gro_flush(conn);
+
+	if (conn->context) {
+		conn_handler = (struct net_conn *)conn->context->conn_handler;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	while (conn_handler && atomic_get(&conn->ref_count) > 0 &&
+	       (pkt = k_fifo_get(&conn->recv_data, K_NO_WAIT)) != NULL) {
+		net_context_packet_received(conn_handler, pkt, NULL, NULL,
+					    conn->recv_user_data);
+	}
+}
+
+/* Flush the merged data at the end of a segment with PSH or FIN, or of
+ * any other event than in-order data, otherwise hold it for a while.
+ */
+static void tcp_gro_end(struct tcp *conn, struct tcphdr *th)
+{
+	if (!conn->gro_data) {
+		return;
+	}
+
+	if (!th || (th->th_flags & (PSH | FIN)) ||
+	    conn->gro_len >= TCP_GRO_MAX || conn->state != TCP_ESTABLISHED) {
+		tcp_gro_flush(conn);
+	} else if (!k_delayed_work_pending(&conn->gro_timer)) {
+		k_delayed_work_submit(&conn->gro_timer,
+				      K_MSEC(CONFIG_NET_TCP_GRO_TIMEOUT));
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static int tcp_conn_unref(struct tcp *conn)
 {
 	int key, ref_count = atomic_get(&conn->ref_count);
@@ -350,6 +427,11 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	key = irq_lock();
 
+#if defined(CONFIG_NET_TCP_GRO)
+	k_delayed_work_cancel(&conn->gro_timer);
+	tcp_gro_flush(conn);
+#endif
+
 	/* If there is any pending data, pass that to application */
 	while ((pkt = k_fifo_get(&conn->recv_data, K_NO_WAIT)) != NULL) {
 		net_context_packet_received(
@@ -376,11 +458,19 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_delayed_work_cancel(&conn->send_data_timer);
 	tcp_pkt_unref(conn->send_data);
 
+	if (conn->ooo_data) {
+		net_pkt_unref(conn->ooo_data);
+	}
+
 	k_delayed_work_cancel(&conn->timewait_timer);
 	k_delayed_work_cancel(&conn->fin_timer);
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
+	if (conn->hash_chain) {
+		sys_slist_find_and_remove(conn->hash_chain, &conn->hash_next);
+	}
+
 	memset(conn, 0, sizeof(*conn));
 
 	k_mem_slab_free(&tcp_conns_slab, (void **)&conn);
@@ -565,8 +655,8 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* Options of the SYN stay valid for the whole connection */
+	recv_options->sack_num = 0;
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -613,6 +703,31 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case TCPOPT_SACK:
+			if ((opt_len - 2) % 8 != 0 ||
+			    opt_len > 2 + 8 * TCP_SACK_BLOCKS) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 0; i < (opt_len - 2) / 8; i++) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[i];
+
+				block->start = sys_get_be32(options + 2 + 8 * i);
+				block->end = sys_get_be32(options + 6 + 8 * i);
+			}
+
+			recv_options->sack_num = (opt_len - 2) / 8;
+			break;
 		default:
 			continue;
 		}
@@ -625,6 +740,46 @@ end:
 	return result;
 }
 
+/* Queue len bytes of data at the end of up for the application */
+static void tcp_recv_queue(struct tcp *conn, struct net_pkt *up, size_t len)
+{
+#if defined(CONFIG_NET_TCP_GRO)
+	size_t hdr_len = net_pkt_get_len(up) - len;
+	struct net_buf *buf;
+
+	/* Only the data is kept, the buffers are appended as they are */
+	while (hdr_len && (buf = up->buffer) != NULL) {
+		size_t pull = MIN(hdr_len, buf->len);
+
+		net_buf_pull(buf, pull);
+		hdr_len -= pull;
+
+		if (!buf->len) {
+			up->buffer = buf->frags;
+			buf->frags = NULL;
+			net_buf_unref(buf);
+		}
+	}
+
+	if (conn->gro_data) {
+		net_pkt_append_buffer(conn->gro_data, up->buffer);
+		up->buffer = NULL;
+		net_pkt_unref(up);
+	} else {
+		conn->gro_data = up;
+	}
+
+	conn->gro_len += len;
+#else
+	net_pkt_cursor_init(up);
+	net_pkt_set_overwrite(up, true);
+
+	net_pkt_skip(up, net_pkt_get_len(up) - len);
+
+	k_fifo_put(&conn->recv_data, up);
+#endif
+}
+
 static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t len)
 {
 	int ret = 0;
@@ -642,23 +797,203 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t len)
 			goto out;
 		}
 
-		net_pkt_cursor_init(up);
-		net_pkt_set_overwrite(up, true);
-
-		net_pkt_skip(up, net_pkt_get_len(up) - len);
-
 		/* Do not pass data to application with TCP conn
 		 * locked as there could be an issue when the app tries
 		 * to send the data and the conn is locked. So the recv
 		 * data is placed in fifo which is flushed in tcp_in()
 		 * after unlocking the conn
 		 */
-		k_fifo_put(&conn->recv_data, up);
+		tcp_recv_queue(conn, up, len);
 	}
  out:
 	return ret;
 }
 
+/* Out-of-order data kept per connection, limited like the send window so
+ * that the missing segment can still be received.
+ */
+#define TCP_OOO_MAX MIN(CONFIG_NET_TCP_OOO_QUEUE_SIZE,			\
+			(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3)
+
+static void tcp_ooo_insert(struct tcp *conn, struct net_buf *buf)
+{
+	struct net_buf *cur = conn->ooo_data->buffer;
+	struct net_buf *prev = NULL;
+	uint32_t end;
+
+	while (cur && net_tcp_seq_cmp(tcp_buf_seq(cur), tcp_buf_seq(buf)) <= 0) {
+		prev = cur;
+		cur = cur->frags;
+	}
+
+	/* Only keep the part of buf that is not queued yet */
+	if (prev) {
+		end = tcp_buf_seq(prev) + prev->len;
+		if (net_tcp_seq_cmp(end, tcp_buf_seq(buf)) > 0) {
+			uint16_t overlap = MIN(end - tcp_buf_seq(buf), buf->len);
+
+			net_buf_pull(buf, overlap);
+			tcp_buf_seq(buf) += overlap;
+		}
+	}
+
+	if (cur && net_tcp_seq_cmp(tcp_buf_seq(buf) + buf->len,
+				   tcp_buf_seq(cur)) > 0) {
+		buf->len = tcp_buf_seq(cur) - tcp_buf_seq(buf);
+	}
+
+	if (buf->len == 0U) {
+		net_buf_unref(buf);
+		return;
+	}
+
+	conn->ooo_len += buf->len;
+
+	if (prev) {
+		net_buf_frag_insert(prev, buf);
+	} else {
+		buf->frags = conn->ooo_data->buffer;
+		conn->ooo_data->buffer = buf;
+	}
+}
+
+/* Keep the data of a segment received after a missing one */
+static void tcp_ooo_queue(struct tcp *conn, struct net_pkt *pkt, size_t len)
+{
+	struct tcphdr *th = th_get(pkt);
+	struct net_pkt_cursor backup;
+	struct net_buf *buf, *next;
+	struct net_pkt *copy;
+	uint32_t seq;
+	int ret;
+
+	/* The test protocol reads the TCP header of the data it gets */
+	if (TCP_OOO_MAX == 0 || tcp_recv_cb) {
+		return;
+	}
+
+	if (conn->ooo_len + len > TCP_OOO_MAX ||
+	    net_tcp_seq_cmp(th_seq(th) + len,
+			    conn->ack + conn->recv_win) > 0) {
+		goto drop;
+	}
+
+	if (!conn->ooo_data) {
+		conn->ooo_data = net_pkt_rx_alloc_on_iface(conn->iface,
+							   K_NO_WAIT);
+		if (!conn->ooo_data) {
+			goto drop;
+		}
+
+		net_pkt_set_family(conn->ooo_data,
+				   net_context_get_family(conn->context));
+	}
+
+	copy = net_pkt_rx_alloc_with_buffer(conn->iface, len, AF_UNSPEC, 0,
+					    K_NO_WAIT);
+	if (!copy) {
+		goto drop;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_skip(pkt, net_pkt_get_len(pkt) - len);
+	if (ret == 0) {
+		ret = net_pkt_copy(copy, pkt, len);
+	}
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if (ret < 0) {
+		net_pkt_unref(copy);
+		goto drop;
+	}
+
+	buf = copy->buffer;
+	copy->buffer = NULL;
+	net_pkt_unref(copy);
+
+	for (seq = th_seq(th); buf; buf = next) {
+		next = buf->frags;
+		buf->frags = NULL;
+
+		tcp_buf_seq(buf) = seq;
+		seq += buf->len;
+
+		tcp_ooo_insert(conn, buf);
+	}
+
+	conn->ooo_last = th_seq(th);
+
+	NET_DBG("conn: %p seq=%u len=%zu queued=%zu", conn, th_seq(th), len,
+		conn->ooo_len);
+
+	net_stats_update_tcp_seg_ooo(conn->iface);
+
+	return;
+drop:
+	net_stats_update_tcp_seg_ooodrop(conn->iface);
+
+	if (conn->ooo_data && !conn->ooo_data->buffer) {
+		net_pkt_unref(conn->ooo_data);
+		conn->ooo_data = NULL;
+	}
+}
+
+/* Pass the queued data made contiguous by a received segment */
+static void tcp_ooo_deliver(struct tcp *conn)
+{
+	struct net_buf *buf;
+	struct net_pkt *up;
+	uint32_t seq;
+
+	if (!conn->ooo_data || !conn->ooo_data->buffer ||
+	    net_tcp_seq_cmp(tcp_buf_seq(conn->ooo_data->buffer),
+			    conn->ack) > 0) {
+		return;
+	}
+
+	up = net_pkt_rx_alloc_on_iface(conn->iface, K_NO_WAIT);
+	if (!up) {
+		return;
+	}
+
+	net_pkt_set_family(up, net_pkt_family(conn->ooo_data));
+
+	while ((buf = conn->ooo_data->buffer) != NULL &&
+	       net_tcp_seq_cmp(tcp_buf_seq(buf), conn->ack) <= 0) {
+		seq = tcp_buf_seq(buf);
+
+		conn->ooo_data->buffer = buf->frags;
+		buf->frags = NULL;
+		conn->ooo_len -= buf->len;
+
+		if (net_tcp_seq_cmp(seq + buf->len, conn->ack) <= 0) {
+			net_buf_unref(buf);
+			continue;
+		}
+
+		net_buf_pull(buf, conn->ack - seq);
+		conn_ack(conn, + buf->len);
+
+		net_pkt_append_buffer(up, buf);
+	}
+
+	if (!conn->ooo_data->buffer) {
+		net_pkt_unref(conn->ooo_data);
+		conn->ooo_data = NULL;
+	}
+
+	NET_DBG("conn: %p delivered %zu bytes, ack=%u", conn,
+		net_pkt_get_len(up), conn->ack);
+
+	if (up->buffer && conn->context->recv_cb) {
+		tcp_recv_queue(conn, up, net_pkt_get_len(up));
+	} else {
+		net_pkt_unref(up);
+	}
+}
+
 static int tcp_finalize_pkt(struct net_pkt *pkt)
 {
 	net_pkt_cursor_init(pkt);
@@ -675,7 +1010,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -690,7 +1025,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 	th->th_sport = conn->src.sin.sin_port;
 	th->th_dport = conn->dst.sin.sin_port;
 
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 	th->th_flags = flags;
 	th->th_win = htons(conn->recv_win);
 	th->th_seq = htonl(seq);
@@ -719,13 +1054,101 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Next contiguous run of out-of-order data starting at buf, returns the
+ * buffer after the run.
+ */
+static struct net_buf *tcp_ooo_run(struct net_buf *buf,
+				   struct tcp_sack_block *run)
+{
+	run->start = tcp_buf_seq(buf);
+	run->end = run->start;
+
+	for ( ; buf && tcp_buf_seq(buf) == run->end; buf = buf->frags) {
+		run->end += buf->len;
+	}
+
+	return buf;
+}
+
+/* RFC 2018, the first block reports the latest segment received */
+static size_t tcp_sack_add(struct tcp *conn, uint8_t *opts)
+{
+	struct tcp_sack_block run;
+	struct net_buf *buf;
+	size_t len = 4;
+	int n = 0;
+
+	for (int pass = 0; pass < 2; pass++) {
+		buf = conn->ooo_data->buffer;
+
+		while (buf && n < TCP_SACK_BLOCKS) {
+			bool latest;
+
+			buf = tcp_ooo_run(buf, &run);
+
+			latest = net_tcp_seq_cmp(conn->ooo_last, run.start) >= 0 &&
+				 net_tcp_seq_cmp(conn->ooo_last, run.end) < 0;
+			if (latest != (pass == 0)) {
+				continue;
+			}
+
+			sys_put_be32(run.start, opts + len);
+			sys_put_be32(run.end, opts + len + 4);
+			len += 8;
+			n++;
+		}
+	}
+
+	opts[0] = TCPOPT_NOP;
+	opts[1] = TCPOPT_NOP;
+	opts[2] = TCPOPT_SACK;
+	opts[3] = len - 2;
+
+	return len;
+}
+
+/* Write the options of an outgoing segment to opts, returns their length */
+static size_t tcp_options_add(struct tcp *conn, uint8_t flags,
+			      struct net_pkt *data, uint8_t *opts)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		return 0;
+	}
+
+	if (flags & SYN) {
+		/* Offered in a SYN, agreed to in a SYN ACK */
+		if ((flags & ACK) && !tcp_sack_ok(conn)) {
+			return 0;
+		}
+
+		opts[0] = TCPOPT_NOP;
+		opts[1] = TCPOPT_NOP;
+		opts[2] = TCPOPT_SACK_PERM;
+		opts[3] = 2;
+
+		return 4;
+	}
+
+	/* Data segments are already a full MSS, so SACK blocks only go
+	 * in pure ACKs, which are sent as soon as data is out of order.
+	 */
+	if ((flags & ACK) && !data && tcp_sack_ok(conn) &&
+	    conn->ooo_len > 0) {
+		return tcp_sack_add(conn, opts);
+	}
+
+	return 0;
+}
+
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_add(conn, flags, data, opts);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -734,6 +1157,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -743,12 +1167,20 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -808,9 +1240,17 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Amount of data that can be outstanding, limited by both the receiver
+ * and the congestion window.
+ */
+static int tcp_send_window(struct tcp *conn)
+{
+	return MIN(conn->send_win, conn->cwnd);
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -835,17 +1275,21 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* With GSO, data is sent as super-segments of several MSS */
+#if defined(CONFIG_NET_TCP_GSO)
+#define tcp_segment_max(_conn) (conn_mss(_conn) * CONFIG_NET_TCP_GSO_MAX_SEGS)
+#else
+#define tcp_segment_max(_conn) conn_mss(_conn)
+#endif
+
+/* Send len bytes of send_data starting at pos as a segment, or as a
+ * super-segment if len is more than the MSS.
+ */
+static int tcp_send_segment(struct tcp *conn, int pos, int len, bool resend)
 {
 	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
@@ -860,11 +1304,13 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
+	if (len > conn_mss(conn)) {
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+	if (ret == 0) {
+		if (resend) {
 			net_stats_update_tcp_resent(net_pkt_iface(pkt), len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -879,12 +1325,290 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
-	conn_send_data_dump(conn);
-
  out:
 	return ret;
 }
 
+static int tcp_send_data(struct tcp *conn)
+{
+	bool resend = conn->data_mode == TCP_DATA_MODE_RESEND;
+	int ret;
+	int len;
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   tcp_segment_max(conn));
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len, resend);
+	if (ret < 0) {
+		return ret;
+	}
+
+	conn->unacked_len += len;
+
+	/* Time one segment per round trip, never a retransmitted one */
+	if (resend) {
+		conn->rtt_pending = false;
+	} else if (!conn->rtt_pending) {
+		conn->rtt_pending = true;
+		conn->rtt_seq = conn->seq + conn->unacked_len;
+		conn->rtt_start = k_uptime_get_32();
+	}
+
+	conn_send_data_dump(conn);
+
+	return 0;
+}
+
+/* RFC 6298 estimation of the retransmission timeout */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	if (!conn->rtt_valid) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+		conn->rtt_valid = true;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt += delta;
+		conn->rttvar += (delta < 0 ? -delta : delta) -
+				(conn->rttvar >> 2);
+	}
+
+	conn->rto = CLAMP((conn->srtt >> 3) + MAX(conn->rttvar, 1U),
+			  (uint32_t)tcp_rto, TCP_RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+static void tcp_cc_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	/* RFC 3390 initial window */
+	conn->cwnd = MIN(4U * mss, MAX(2U * mss, 4380U));
+	conn->ssthresh = UINT16_MAX;
+	/* RFC 6582, a loss of the first window starts a recovery */
+	conn->recover = conn->seq - 1;
+	conn->dup_acks = 0U;
+	conn->in_recovery = false;
+
+	tcp_cc->init(conn);
+}
+
+/* Called with len_acked bytes newly acked, after conn->seq was advanced */
+static void tcp_cc_ack(struct tcp *conn, uint32_t ack, uint32_t len_acked)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t flight = MAX(conn->unacked_len, 0);
+
+	conn->dup_acks = 0U;
+
+	if (conn->rtt_pending && net_tcp_seq_cmp(ack, conn->rtt_seq) >= 0) {
+		conn->rtt_pending = false;
+		tcp_rtt_update(conn, k_uptime_get_32() - conn->rtt_start);
+	}
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_cmp(ack, conn->recover) >= 0) {
+			/* Full acknowledgment, RFC 6582 */
+			conn->cwnd = MIN(conn->ssthresh, MAX(flight, mss) + mss);
+			conn->in_recovery = false;
+		} else {
+			/* Partial acknowledgment, the next segment was lost */
+			(void)tcp_send_segment(conn, 0, MIN(flight, mss), true);
+			if (net_tcp_seq_cmp(conn->sack_rexmit,
+					    conn->seq + MIN(flight, mss)) < 0) {
+				conn->sack_rexmit = conn->seq + MIN(flight, mss);
+			}
+			conn->cwnd -= MIN(conn->cwnd - mss, len_acked);
+			if (len_acked >= mss) {
+				conn->cwnd += mss;
+			}
+		}
+
+		return;
+	}
+
+	if (conn->cwnd < conn->ssthresh) {
+		conn->cwnd += MIN(len_acked, mss);
+	} else {
+		tcp_cc->cong_avoid(conn, len_acked);
+	}
+
+	/* The window cannot be used beyond what a peer can advertise */
+	conn->cwnd = MIN(conn->cwnd, UINT16_MAX);
+}
+
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->dup_acks++;
+
+	if (conn->in_recovery) {
+		/* Each duplicate ack means a segment left the network */
+		conn->cwnd = MIN(conn->cwnd + mss, UINT16_MAX);
+		return;
+	}
+
+	/* RFC 6582, no new recovery for losses of the previous window */
+	if (conn->dup_acks != TCP_DUP_ACK_THRESHOLD ||
+	    net_tcp_seq_cmp(conn->seq, conn->recover) <= 0) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit seq=%u", conn, conn->seq);
+
+	tcp_cc->loss(conn, conn->unacked_len);
+	conn->cwnd = conn->ssthresh + TCP_DUP_ACK_THRESHOLD * mss;
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = true;
+	conn->rtt_pending = false;
+	conn->sack_rexmit = conn->seq + MIN(conn->unacked_len, (int)mss);
+
+	(void)tcp_send_segment(conn, 0, MIN(conn->unacked_len, (int)mss), true);
+}
+
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	/* The first timeout of a segment is a loss, later ones are not */
+	if (conn->send_data_retries == 0U) {
+		tcp_cc->loss(conn, MAX(conn->unacked_len, 0));
+		conn->recover = conn->seq + conn->unacked_len;
+	}
+
+	conn->cwnd = conn_mss(conn);
+	conn->dup_acks = 0U;
+	conn->in_recovery = false;
+	conn->rtt_pending = false;
+	conn->rto = MIN(conn->rto * 2U, TCP_RTO_MAX_MS);
+}
+
+/* Add a block the peer reported to the scoreboard, the highest block is
+ * forgotten when there is no room.
+ */
+static void tcp_sack_insert(struct tcp *conn, struct tcp_sack_block block)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int n = conn->sacked_num;
+	int i;
+
+	for (i = 0; i < n; ) {
+		if (net_tcp_seq_cmp(block.start, sacked[i].end) <= 0 &&
+		    net_tcp_seq_cmp(sacked[i].start, block.end) <= 0) {
+			if (net_tcp_seq_cmp(sacked[i].start, block.start) < 0) {
+				block.start = sacked[i].start;
+			}
+
+			if (net_tcp_seq_cmp(sacked[i].end, block.end) > 0) {
+				block.end = sacked[i].end;
+			}
+
+			memmove(&sacked[i], &sacked[i + 1],
+				(n - i - 1) * sizeof(*sacked));
+			n--;
+		} else {
+			i++;
+		}
+	}
+
+	for (i = 0; i < n; i++) {
+		if (net_tcp_seq_cmp(block.start, sacked[i].start) < 0) {
+			break;
+		}
+	}
+
+	if (i < TCP_SACK_BLOCKS) {
+		memmove(&sacked[i + 1], &sacked[i],
+			(MIN(n, TCP_SACK_BLOCKS - 1) - i) * sizeof(*sacked));
+		sacked[i] = block;
+		n = MIN(n + 1, TCP_SACK_BLOCKS);
+	}
+
+	conn->sacked_num = n;
+}
+
+/* Update the scoreboard with an ack and its SACK blocks */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t high = conn->seq + conn->unacked_len;
+	struct tcp_sack_block block;
+	int n = 0;
+
+	for (int i = 0; i < conn->sacked_num; i++) {
+		block = conn->sacked[i];
+
+		if (net_tcp_seq_cmp(block.end, ack) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block.start, ack) < 0) {
+			block.start = ack;
+		}
+
+		conn->sacked[n++] = block;
+	}
+
+	conn->sacked_num = n;
+
+	for (int i = 0; i < conn->recv_options.sack_num; i++) {
+		block = conn->recv_options.sack[i];
+
+		if (net_tcp_seq_cmp(block.start, ack) < 0) {
+			block.start = ack;
+		}
+
+		/* Only data that was sent and is not acked yet */
+		if (net_tcp_seq_cmp(block.start, block.end) >= 0 ||
+		    net_tcp_seq_cmp(block.end, high) > 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, block);
+	}
+}
+
+/* Retransmit the next data the peer reported missing in a recovery,
+ * returns true if a segment was sent.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t start = conn->sack_rexmit;
+	uint32_t len;
+
+	if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+		start = conn->seq;
+	}
+
+	/* Holes are only known below the highest block */
+	for (int i = 0; i < conn->sacked_num; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(start, block->start) < 0) {
+			len = MIN(block->start - start, conn_mss(conn));
+
+			if (tcp_send_segment(conn, start - conn->seq, len,
+					     true) < 0) {
+				return false;
+			}
+
+			conn->sack_rexmit = start + len;
+			net_stats_update_tcp_seg_sackrexmit(conn->iface);
+
+			return true;
+		}
+
+		if (net_tcp_seq_cmp(start, block->end) < 0) {
+			start = block->end;
+		}
+	}
+
+	return false;
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -927,7 +1651,8 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_data_timer,
+				      K_MSEC(conn->rto));
 	}
  out:
 	return ret;
@@ -949,6 +1674,11 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_cc_timeout(conn);
+
+	/* RFC 2018, the peer may have dropped data it reported */
+	conn->sacked_num = 0;
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -974,7 +1704,7 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
-	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn->rto));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1030,6 +1760,7 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->state = TCP_LISTEN;
 
 	conn->recv_win = tcp_window;
+	conn->rto = tcp_rto;
 
 	conn->seq = (IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
@@ -1040,6 +1771,9 @@ static struct tcp *tcp_conn_alloc(void)
 
 	k_delayed_work_init(&conn->timewait_timer, tcp_timewait_timeout);
 	k_delayed_work_init(&conn->fin_timer, tcp_fin_timeout);
+#if defined(CONFIG_NET_TCP_GRO)
+	k_delayed_work_init(&conn->gro_timer, tcp_gro_timeout);
+#endif
 
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	k_delayed_work_init(&conn->send_data_timer, tcp_resend_data);
@@ -1047,6 +1781,8 @@ static struct tcp *tcp_conn_alloc(void)
 	k_sem_init(&conn->connect_sem, 0, UINT_MAX);
 	conn->in_connect = false;
 
+	tcp_cc_init(conn);
+
 	tcp_conn_ref(conn);
 
 	sys_slist_append(&tcp_conns, &conn->next);
@@ -1076,39 +1812,58 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static sys_slist_t *tcp_conn_chain(union tcp_endpoint *src,
+				   union tcp_endpoint *dst)
 {
-	union tcp_endpoint ep_tmp;
+	uint32_t hash;
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
-	}
+	hash = net_conn_hash(IPPROTO_TCP, dst->sa.sa_family,
+			     dst->sa.sa_family == AF_INET ?
+			     (const void *)&dst->sin.sin_addr :
+			     (const void *)&dst->sin6.sin6_addr,
+			     dst->sin.sin_port, src->sin.sin_port);
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
+	return &tcp_conn_hash[hash % CONFIG_NET_CONN_HASH_BUCKETS];
 }
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
+/* Index the connection by its end points, to be called once they are set */
+static void tcp_conn_hash_update(struct tcp *conn)
 {
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	int key = irq_lock();
+
+	if (conn->hash_chain) {
+		sys_slist_find_and_remove(conn->hash_chain, &conn->hash_next);
+	}
+
+	conn->hash_chain = tcp_conn_chain(&conn->src, &conn->dst);
+	sys_slist_append(conn->hash_chain, &conn->hash_next);
+
+	irq_unlock(key);
 }
 
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	bool found = false;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
 	struct tcp *conn;
 	struct tcp *tmp;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
 
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
-			break;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(tcp_conn_chain(&src, &dst), conn,
+					  tmp, hash_next) {
+		if (!memcmp(&conn->src, &src,
+			    tcp_endpoint_len(src.sa.sa_family)) &&
+		    !memcmp(&conn->dst, &dst,
+			    tcp_endpoint_len(dst.sa.sa_family))) {
+			return conn;
 		}
 	}
 
-	return found ? conn : NULL;
+	return NULL;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -1187,6 +1942,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_update(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -1267,6 +2024,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint16_t prev_send_win;
 	size_t len;
 	int ret;
 
@@ -1279,6 +2037,8 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	NET_DBG("%s", log_strdup(tcp_conn_state(conn, pkt)));
 
+	prev_send_win = conn->send_win;
+
 	if (th && th->th_off < 5) {
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
@@ -1353,6 +2113,7 @@ next_state:
 		if (FL(&fl, &, ACK, th_ack(th) == conn->seq &&
 				th_seq(th) == conn->ack)) {
 			tcp_send_timer_cancel(conn);
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1393,6 +2154,7 @@ next_state:
 				conn_ack(conn, + len);
 			}
 			k_sem_give(&conn->connect_sem);
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1431,6 +2193,11 @@ next_state:
 			break;
 		}
 
+		if (th && tcp_sack_ok(conn) &&
+		    conn->data_mode == TCP_DATA_MODE_SEND) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -1453,6 +2220,8 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_cc_ack(conn, th_ack(th), len_acked);
+
 			conn_send_data_dump(conn);
 
 			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
@@ -1483,6 +2252,19 @@ next_state:
 				conn_state(conn, TCP_CLOSED);
 				break;
 			}
+		} else if (th && len == 0 && th_ack(th) == conn->seq &&
+			   conn->unacked_len > 0 &&
+			   conn->send_win == prev_send_win &&
+			   conn->data_mode == TCP_DATA_MODE_SEND) {
+			/* RFC 5681 duplicate acknowledgment */
+			tcp_cc_dup_ack(conn);
+
+			/* Missing data the peer reported goes before new data */
+			if (conn->in_recovery &&
+			    (conn->dup_acks <= TCP_DUP_ACK_THRESHOLD ||
+			     !tcp_sack_retransmit(conn))) {
+				(void)tcp_send_queued_data(conn);
+			}
 		}
 
 		if (th && len) {
@@ -1493,11 +2275,18 @@ next_state:
 
 				net_stats_update_tcp_seg_recv(conn->iface);
 				conn_ack(conn, + len);
+				tcp_ooo_deliver(conn);
 				tcp_out(conn, ACK);
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				tcp_out(conn, ACK); /* peer has resent */
 
 				net_stats_update_tcp_seg_ackerr(conn->iface);
+			} else {
+				/* A segment is missing, a duplicate ack
+				 * lets the peer know.
+				 */
+				tcp_ooo_queue(conn, pkt, len);
+				tcp_out(conn, ACK);
 			}
 		}
 		break;
@@ -1564,6 +2353,10 @@ next_state:
 		goto next_state;
 	}
 
+#if defined(CONFIG_NET_TCP_GRO)
+	tcp_gro_end(conn, th);
+#endif
+
 	/* If the conn->context is not set, then the connection was already
 	 * closed.
 	 */
@@ -1820,6 +2613,8 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	tcp_conn_hash_update(conn);
+
 	NET_DBG("conn: %p src: %s, dst: %s", conn,
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -1964,13 +2759,113 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* Each segment of a super-segment gets its own checksum */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Copy the headers of a super-segment and len bytes of its data found
+ * at offset into a new segment.
+ */
+static struct net_pkt *tcp_gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				       size_t offset, size_t len, bool last)
+{
+	struct net_pkt *seg;
+	struct tcphdr *th;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, TCP_PKT_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	th = th_get(seg);
+	if (!th) {
+		goto fail;
+	}
+
+	UNALIGNED_PUT(htonl(th_seq(th) + offset), &th->th_seq);
+
+	/* Only the last segment pushes the data or closes */
+	if (!last) {
+		th->th_flags &= ~(PSH | FIN);
+	}
+
+	if (tcp_finalize_pkt(seg) < 0) {
+		goto fail;
+	}
+
+	return seg;
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint16_t gso_size = net_pkt_gso_size(pkt);
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t data_len;
+	size_t len;
+
+	th = th_get(pkt);
+	if (!th) {
+		return -EINVAL;
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		th->th_off * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < data_len; offset += len) {
+		len = MIN(gso_size, data_len - offset);
+
+		seg = tcp_gso_segment(pkt, hdr_len, offset, len,
+				      offset + len == data_len);
+		if (!seg) {
+			return -ENOBUFS;
+		}
+
+		if (net_if_send_data(iface, seg) == NET_DROP) {
+			net_pkt_unref(seg);
+			return -EIO;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -2013,6 +2908,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_update(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -2134,6 +3030,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_update(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
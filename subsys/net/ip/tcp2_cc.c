@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms. Slow start, loss detection and
+ * recovery are done by tcp2.c, the algorithms only decide how cwnd grows
+ * in congestion avoidance and how much it is reduced on a loss.
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+static void newreno_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+/* RFC 5681, about one segment per round trip */
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	ARG_UNUSED(acked);
+
+	conn->cwnd += MAX(mss * mss / conn->cwnd, 1U);
+}
+
+static void newreno_loss(struct tcp *conn, uint32_t flight)
+{
+	conn->ssthresh = MAX(flight / 2U, 2U * conn_mss(conn));
+}
+
+const struct tcp_cc tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.cong_avoid = newreno_cong_avoid,
+	.loss = newreno_loss,
+};
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* RFC 8312 constants, C = 0.4 and beta = 0.7 */
+#define CUBIC_C_NUM 4
+#define CUBIC_C_DEN 10
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+
+/* Bound of |t - K|, in ms, which keeps the cube of it in 64 bits */
+#define CUBIC_T_MAX (30 * MSEC_PER_SEC)
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		x <<= 1;
+		b = 3 * x * (x + 1) + 1;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			x++;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cubic, 0, sizeof(conn->cubic));
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t rtt = MAX(conn->srtt >> 3, 1U);
+	uint32_t target;
+	uint32_t w_est;
+	int64_t offs;
+	int64_t t;
+
+	ARG_UNUSED(acked);
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+
+		if (conn->cwnd < cubic->w_max) {
+			/* K = cbrt(W_max * (1 - beta) / C), in ms */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max -
+							 conn->cwnd) *
+					      CUBIC_C_DEN * 1000000000ULL /
+					      (CUBIC_C_NUM * mss));
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->origin = conn->cwnd;
+		}
+	}
+
+	t = now - cubic->epoch_start;
+
+	/* W_cubic(t + RTT) = C * (t + RTT - K)^3 + origin */
+	offs = CLAMP(t + rtt - (int64_t)cubic->k, -CUBIC_T_MAX, CUBIC_T_MAX);
+	offs = offs * offs * offs * CUBIC_C_NUM / CUBIC_C_DEN;
+	offs = offs * mss / 1000000000LL;
+	target = MAX((int64_t)cubic->origin + offs, (int64_t)mss);
+
+	/* Not slower than NewReno would be, in the TCP-friendly region */
+	w_est = cubic->w_max * CUBIC_BETA_NUM / CUBIC_BETA_DEN +
+		(uint32_t)(9 * t * mss / (17 * rtt));
+	target = MAX(target, w_est);
+
+	/* At most a 50% increase per round trip */
+	target = MIN(target, conn->cwnd + conn->cwnd / 2U);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += MAX(mss * (target - conn->cwnd) / conn->cwnd,
+				  1U);
+	}
+}
+
+static void cubic_loss(struct tcp *conn, uint32_t flight)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+
+	ARG_UNUSED(flight);
+
+	/* Fast convergence, release bandwidth to new flows */
+	if (conn->cwnd < cubic->w_max) {
+		cubic->w_max = conn->cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2 * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = conn->cwnd;
+	}
+
+	conn->ssthresh = MAX(conn->cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+			     2U * conn_mss(conn));
+	cubic->epoch_start = 0U;
+}
+
+const struct tcp_cc tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.loss = cubic_loss,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
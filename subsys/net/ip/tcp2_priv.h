@@ -110,6 +110,11 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+/* Number of SACK blocks that fit in the TCP options */
+#define TCP_SACK_BLOCKS 4
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -171,15 +176,42 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+	/* SACK blocks of the last received segment */
+	struct tcp_sack_block sack[TCP_SACK_BLOCKS];
+	uint8_t sack_num;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
 };
 
+#define tcp_sack_ok(_conn)						\
+	(IS_ENABLED(CONFIG_NET_TCP_SACK) &&				\
+	 (_conn)->recv_options.sack_perm_found)
+
+/* Sequence number of the first byte of a queued out-of-order buffer */
+#define tcp_buf_seq(_buf) (*(uint32_t *)net_buf_user_data(_buf))
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+struct tcp_cubic {
+	uint32_t w_max;       /* cwnd before the last reduction */
+	uint32_t origin;      /* cwnd the cubic function converges to */
+	uint32_t k;           /* time to reach origin, in ms */
+	uint32_t epoch_start; /* start of the growth period, 0 if none */
+};
+#endif
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_next;
+	sys_slist_t *hash_chain; /* lookup chain, once end points are set */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_if *iface;
@@ -192,11 +224,17 @@ struct tcp { /* TCP connection */
 	struct k_mutex lock;
 	struct k_sem connect_sem; /* semaphore for blocking connect */
 	struct k_fifo recv_data;  /* temp queue before passing data to app */
+	struct net_pkt *ooo_data; /* out-of-order data, buffers by seq */
 	struct tcp_options recv_options;
 	struct k_delayed_work send_timer;
 	struct k_delayed_work send_data_timer;
 	struct k_delayed_work timewait_timer;
 	struct k_delayed_work fin_timer;
+#if defined(CONFIG_NET_TCP_GRO)
+	struct k_delayed_work gro_timer;
+	struct net_pkt *gro_data; /* in-order data merged for the app */
+	size_t gro_len;           /* bytes in gro_data */
+#endif
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
 	size_t send_data_total;
@@ -209,12 +247,47 @@ struct tcp { /* TCP connection */
 	uint32_t ack;
 	uint16_t recv_win;
 	uint16_t send_win;
+	uint32_t cwnd;        /* congestion window */
+	uint32_t ssthresh;    /* slow start threshold */
+	uint32_t recover;     /* highest seq sent when recovery started */
+	uint32_t rtt_seq;     /* RTT sample taken when this seq is acked */
+	uint32_t rtt_start;   /* uptime when rtt_seq was sent */
+	uint32_t srtt;        /* smoothed RTT, in 1/8 ms */
+	uint32_t rttvar;      /* RTT variation, in 1/4 ms */
+	uint32_t rto;         /* retransmission timeout, in ms */
+	uint32_t ooo_last;    /* seq of the last out-of-order segment */
+	size_t ooo_len;       /* bytes in ooo_data */
+	/* Data the peer reported with SACK, sorted by seq */
+	struct tcp_sack_block sacked[TCP_SACK_BLOCKS];
+	uint8_t sacked_num;
+	uint32_t sack_rexmit; /* retransmitted up to here in recovery */
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct tcp_cubic cubic;
+#endif
 	uint8_t send_data_retries;
+	uint8_t dup_acks;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool in_recovery : 1;
+	bool rtt_pending : 1;
+	bool rtt_valid : 1;
 };
 
+/* Congestion control algorithm, called with the connection locked */
+struct tcp_cc {
+	const char *name;
+	/* Initialize the algorithm state of an established connection */
+	void (*init)(struct tcp *conn);
+	/* Grow cwnd in congestion avoidance, acked bytes were acked */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	/* Set ssthresh on a loss, flight bytes were outstanding */
+	void (*loss)(struct tcp *conn, uint32_t flight);
+};
+
+extern const struct tcp_cc tcp_cc_newreno;
+extern const struct tcp_cc tcp_cc_cubic;
+
 #define _flags(_fl, _op, _mask, _cond)					\
 ({									\
 	bool result = false;						\
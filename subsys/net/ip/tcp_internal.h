@@ -763,6 +763,26 @@ static inline int net_tcp_finalize(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Split a TCP super-segment into segments of net_pkt_gso_size()
+ * bytes of data and send them
+ *
+ * @param iface Network interface the segments are sent to
+ * @param pkt TCP super-segment, released on success
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
@@ -1444,6 +1444,173 @@ static inline int z_vrfy_zsock_poll(struct zsock_pollfd *fds,
 #include <syscalls/zsock_poll_mrsh.c>
 #endif
 
+void zsock_poll_set_init(struct zsock_poll_set *pset)
+{
+	k_poll_set_init(&pset->set);
+	sys_slist_init(&pset->always_ready);
+}
+
+int zsock_poll_set_add(struct zsock_poll_set *pset,
+		       struct zsock_poll_set_entry *entry,
+		       int fd, short events, void *user_data)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = &entry->event;
+	struct zsock_pollfd pfd = {
+		.fd = fd,
+		.events = events,
+	};
+	void *ctx;
+	int ret;
+
+	ctx = get_sock_vtable(fd, (const struct socket_op_vtable **)&vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	entry->event = (struct k_poll_event) {};
+	entry->fd = fd;
+	entry->events = events;
+	entry->revents = 0;
+	entry->user_data = user_data;
+	entry->always_ready = false;
+
+	ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE,
+				   &pfd, &pev, pev + 1);
+	if (ret == -EALREADY) {
+		entry->always_ready = true;
+	} else if (ret == -EXDEV || ret == -ENOMEM) {
+		/* Offloaded, or more than one event per socket */
+		errno = EOPNOTSUPP;
+		return -1;
+	} else if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	entry->has_event = (pev != &entry->event);
+
+	/* Only queue based readiness is level triggered */
+	if (entry->has_event &&
+	    entry->event.type != K_POLL_TYPE_FIFO_DATA_AVAILABLE) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (entry->always_ready) {
+		sys_slist_append(&pset->always_ready, &entry->node);
+	} else if (entry->has_event) {
+		(void)k_poll_set_add(&pset->set, &entry->event);
+	}
+
+	return 0;
+}
+
+void zsock_poll_set_remove(struct zsock_poll_set *pset,
+			   struct zsock_poll_set_entry *entry)
+{
+	if (entry->always_ready) {
+		(void)sys_slist_find_and_remove(&pset->always_ready,
+						&entry->node);
+	} else if (entry->has_event) {
+		(void)k_poll_set_remove(&pset->set, &entry->event);
+	}
+}
+
+static bool zsock_poll_set_update(struct zsock_poll_set_entry *entry)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = &entry->event;
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events,
+	};
+	void *ctx;
+	int ret;
+
+	ctx = get_sock_vtable(entry->fd,
+			      (const struct socket_op_vtable **)&vtable);
+	if (ctx == NULL) {
+		pfd.revents = ZSOCK_POLLNVAL;
+	} else {
+		ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_UPDATE,
+					   &pfd, &pev);
+		if (ret != 0 && ret != -EAGAIN) {
+			pfd.revents = ZSOCK_POLLERR;
+		}
+	}
+
+	entry->revents = pfd.revents;
+
+	return pfd.revents != 0;
+}
+
+int zsock_poll_set_wait(struct zsock_poll_set *pset,
+			struct zsock_poll_set_entry **ready, int max_ready,
+			int timeout)
+{
+	struct k_poll_event *events[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct zsock_poll_set_entry *entry;
+	k_timeout_t k_timeout;
+	uint64_t end;
+	int count = 0;
+	int ret;
+
+	max_ready = MIN(max_ready, ARRAY_SIZE(events));
+	k_timeout = (timeout < 0) ? K_FOREVER : K_MSEC(timeout);
+	end = z_timeout_end_calc(k_timeout);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&pset->always_ready, entry, node) {
+		if (count == max_ready) {
+			return count;
+		}
+
+		/* Refresh the state used for ZSOCK_POLLIN */
+		if (entry->has_event) {
+			entry->event.state = K_POLL_STATE_NOT_READY;
+			(void)k_poll(&entry->event, 1, K_NO_WAIT);
+		}
+
+		if (zsock_poll_set_update(entry)) {
+			ready[count++] = entry;
+		}
+	}
+
+	do {
+		if (count > 0) {
+			k_timeout = K_NO_WAIT;
+		} else if (!K_TIMEOUT_EQ(k_timeout, K_NO_WAIT) &&
+			   !K_TIMEOUT_EQ(k_timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			k_timeout = (remaining <= 0) ? K_NO_WAIT :
+				    Z_TIMEOUT_TICKS(remaining);
+		}
+
+		if (count == max_ready) {
+			break;
+		}
+
+		ret = k_poll_set_wait(&pset->set, events, max_ready - count,
+				      k_timeout);
+		if (ret < 0) {
+			break;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			entry = CONTAINER_OF(events[i],
+					     struct zsock_poll_set_entry,
+					     event);
+			if (zsock_poll_set_update(entry)) {
+				ready[count++] = entry;
+			}
+		}
+	} while (count == 0 && !K_TIMEOUT_EQ(k_timeout, K_NO_WAIT));
+
+	return count;
+}
+
 int z_impl_zsock_inet_pton(sa_family_t family, const char *src, void *dst)
 {
 	if (net_addr_pton(family, src, dst) == 0) {
@@ -51,8 +51,39 @@ static int cmd_kernel_cycles(const struct shell *shell,
 	return 0;
 }
 
+/* Only slabs defined with K_MEM_SLAB_DEFINE() can be enumerated */
+static int cmd_kernel_slabs(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "%-18s %8s %8s %8s %8s %8s", "slab", "blk size",
+		    "blocks", "used", "max used", "failed");
+
+	Z_STRUCT_SECTION_FOREACH(k_mem_slab, slab) {
+		shell_print(shell, "%-18p %8zu %8u %8u %8u %8u", slab,
+			    slab->block_size, slab->num_blocks,
+			    k_mem_slab_num_used_get(slab),
+			    k_mem_slab_max_used_get(slab),
+			    k_mem_slab_failures_get(slab));
+	}
+
+	return 0;
+}
+
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 	defined(CONFIG_THREAD_MONITOR)
+static k_ticks_t thread_timeout_remaining(struct k_thread *thread)
+{
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+	/* dticks is not a relative count with every timeout queue backend */
+	return z_timeout_remaining(&thread->base.timeout);
+#else
+	return 0;
+#endif
+}
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -77,7 +108,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(shell, "\toptions: 0x%x, priority: %d timeout: %d",
 		      thread->base.user_options,
 		      thread->base.prio,
-		      thread->base.timeout.dticks);
+		      (int)thread_timeout_remaining(thread));
 	shell_print(shell, "\tstate: %s", k_thread_state_str(thread));
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
@@ -245,6 +276,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
+	SHELL_CMD(slabs, NULL, "List memory slabs.", cmd_kernel_slabs),
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
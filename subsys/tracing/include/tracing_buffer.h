@@ -113,6 +113,47 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Claim room for one event in the current CPU's tracing buffer.
+ *
+ * Safe to call from any context without locking. The event is not seen
+ * by the tracing thread until it is committed.
+ *
+ * @param size Event size (in bytes).
+ *
+ * @return Address to write the event to, or NULL if the buffer is full.
+ */
+uint8_t *tracing_buffer_event_claim(uint32_t size);
+
+/**
+ * @brief Commit an event claimed with tracing_buffer_event_claim().
+ *
+ * @param data Address returned by tracing_buffer_event_claim().
+ * @param size Event size (in bytes), as claimed.
+ */
+void tracing_buffer_event_commit(uint8_t *data, uint32_t size);
+
+/**
+ * @brief Hand committed events to the backend in timestamp order.
+ *
+ * Events are taken from the per-CPU buffers oldest first. Stops early
+ * if the oldest event of a buffer is still being written.
+ *
+ * @return Number of events handed to the backend.
+ */
+uint32_t tracing_buffer_events_output(void);
+
+/**
+ * @brief Get the number of events dropped by a CPU's tracing buffer.
+ *
+ * @param cpu CPU index.
+ *
+ * @return Number of events that did not fit in the buffer.
+ */
+uint32_t tracing_buffer_drop_count_get(unsigned int cpu);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/util.h>
+#include <sys/atomic.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+/*
+ * Each CPU has its own buffer of variable sized events. Producers claim
+ * space by advancing the head counter with a compare and swap, so
+ * threads and ISRs on any CPU can write events concurrently. The tracing
+ * thread is the only consumer; it merges the buffers by timestamp.
+ *
+ * The head and tail counters run freely and are reduced modulo the
+ * buffer size. An event never wraps: if it does not fit before the end
+ * of the buffer, the rest of the buffer is claimed as padding. Consumed
+ * space is zeroed before it is released, so a header the producer has
+ * not written yet always reads as zero.
+ */
+
+#define BUF_SIZE CONFIG_TRACING_BUFFER_SIZE
+
+BUILD_ASSERT((BUF_SIZE & (BUF_SIZE - 1)) == 0,
+	     "CONFIG_TRACING_BUFFER_SIZE must be a power of two");
+
+#define EVT_COMMITTED BIT(30)
+#define EVT_PAD BIT(31)
+#define EVT_LEN_MASK (BIT(30) - 1)
+
+struct event_hdr {
+	/* Length plus flags, zero until the event is complete */
+	atomic_t info;
+	uint32_t timestamp;
+};
+
+struct cpu_buffer {
+	atomic_t head;
+	atomic_t tail;
+	atomic_t drops;
+	uint8_t data[BUF_SIZE] __aligned(sizeof(struct event_hdr));
+};
+
+static struct cpu_buffer cpu_buffers[CONFIG_MP_NUM_CPUS];
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+
+static inline uint32_t event_space(uint32_t size)
+{
+	return ROUND_UP(sizeof(struct event_hdr) + size,
+			sizeof(struct event_hdr));
+}
+
+static inline struct cpu_buffer *current_buffer(void)
+{
+#if CONFIG_MP_NUM_CPUS > 1
+	/* Migrating after this is harmless, every buffer takes any writer */
+	return &cpu_buffers[arch_curr_cpu()->id];
+#else
+	return &cpu_buffers[0];
+#endif
+}
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+uint8_t *tracing_buffer_event_claim(uint32_t size)
+{
+	struct cpu_buffer *buf = current_buffer();
+	uint32_t need = event_space(size);
+	uint32_t head, off, pad;
+	struct event_hdr *hdr;
+
+	do {
+		head = (uint32_t)atomic_get(&buf->head);
+		off = head & (BUF_SIZE - 1);
+		pad = (off + need > BUF_SIZE) ? (BUF_SIZE - off) : 0;
+
+		if ((head + pad + need -
+		     (uint32_t)atomic_get(&buf->tail)) > BUF_SIZE) {
+			atomic_inc(&buf->drops);
+			return NULL;
+		}
+	} while (!atomic_cas(&buf->head, head, head + pad + need));
+
+	if (pad != 0) {
+		hdr = (struct event_hdr *)&buf->data[off];
+		atomic_set(&hdr->info, EVT_PAD);
+		off = 0;
+	}
+
+	hdr = (struct event_hdr *)&buf->data[off];
+	hdr->timestamp = k_cycle_get_32();
+
+	return (uint8_t *)(hdr + 1);
+}
+
+void tracing_buffer_event_commit(uint8_t *data, uint32_t size)
+{
+	struct event_hdr *hdr = (struct event_hdr *)data - 1;
+
+	atomic_set(&hdr->info, EVT_COMMITTED | size);
+}
+
+/* Oldest event of a buffer: NULL if empty, -EBUSY if not committed yet */
+static struct event_hdr *buffer_peek(struct cpu_buffer *buf, int *err)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+	uint32_t off = tail & (BUF_SIZE - 1);
+	struct event_hdr *hdr = (struct event_hdr *)&buf->data[off];
+	atomic_val_t info;
+
+	*err = 0;
+	if (tail == (uint32_t)atomic_get(&buf->head)) {
+		return NULL;
+	}
+
+	info = atomic_get(&hdr->info);
+	if (info == 0) {
+		*err = -EBUSY;
+		return NULL;
+	}
+
+	if ((info & EVT_PAD) != 0) {
+		memset(hdr, 0, BUF_SIZE - off);
+		atomic_add(&buf->tail, BUF_SIZE - off);
+		return buffer_peek(buf, err);
+	}
+
+	return hdr;
+}
+
+static void buffer_release(struct cpu_buffer *buf, struct event_hdr *hdr)
+{
+	uint32_t space = event_space(atomic_get(&hdr->info) & EVT_LEN_MASK);
+
+	memset(hdr, 0, space);
+	atomic_add(&buf->tail, space);
+}
+
+uint32_t tracing_buffer_events_output(void)
+{
+	uint32_t count = 0;
+
+	while (true) {
+		struct cpu_buffer *oldest_buf = NULL;
+		struct event_hdr *oldest = NULL;
+		int err;
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			struct event_hdr *hdr = buffer_peek(&cpu_buffers[i], &err);
+
+			/* Outputting a later event from another CPU now would
+			 * put the stream out of order.
+			 */
+			if (err != 0) {
+				return count;
+			}
+
+			if ((hdr != NULL) &&
+			    ((oldest == NULL) ||
+			     ((int32_t)(hdr->timestamp -
+					oldest->timestamp) < 0))) {
+				oldest = hdr;
+				oldest_buf = &cpu_buffers[i];
+			}
+		}
+
+		if (oldest == NULL) {
+			return count;
+		}
+
+		tracing_buffer_handle((uint8_t *)(oldest + 1),
+				      atomic_get(&oldest->info) & EVT_LEN_MASK);
+		buffer_release(oldest_buf, oldest);
+		count++;
+	}
+}
+
+uint32_t tracing_buffer_drop_count_get(unsigned int cpu)
+{
+	return (uint32_t)atomic_get(&cpu_buffers[cpu].drops);
+}
+
+void tracing_buffer_init(void)
+{
+	/* Buffers start zeroed, see above */
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (atomic_get(&cpu_buffers[i].head) !=
+		    atomic_get(&cpu_buffers[i].tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return BUF_SIZE - sizeof(struct event_hdr);
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+	struct cpu_buffer *buf = current_buffer();
+
+	return BUF_SIZE - (uint32_t)(atomic_get(&buf->head) -
+				     atomic_get(&buf->tail));
+}
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/printk.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+#include <tracing/tracing_format.h>
+
+/* Events go to the current CPU's buffer without taking TRACING_LOCK(),
+ * which on SMP would serialize every traced event across all CPUs.
+ */
+static void event_put(uint8_t *data, uint32_t length)
+{
+	bool before_put_is_empty = tracing_buffer_is_empty();
+	uint8_t *buf = tracing_buffer_event_claim(length);
+
+	if (buf == NULL) {
+		tracing_packet_drop_handle();
+		return;
+	}
+
+	memcpy(buf, data, length);
+	tracing_buffer_event_commit(buf, length);
+	tracing_trigger_output(before_put_is_empty);
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	char buf[CONFIG_TRACING_PACKET_MAX_SIZE];
+	va_list args;
+	int length;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+	length = vsnprintk(buf, sizeof(buf), str, args);
+	va_end(args);
+
+	/* The string is sent without its terminating NUL */
+	event_put((uint8_t *)buf, MIN(length, (int)sizeof(buf) - 1));
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	event_put(data, length);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	bool before_put_is_empty;
+	uint32_t length = 0U;
+	uint8_t *buf;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	before_put_is_empty = tracing_buffer_is_empty();
+	buf = tracing_buffer_event_claim(length);
+	if (buf == NULL) {
+		tracing_packet_drop_handle();
+		return;
+	}
+
+	for (uint32_t i = 0, off = 0; i < count; i++) {
+		memcpy(buf + off, tracing_data_array[i].data,
+		       tracing_data_array[i].length);
+		off += tracing_data_array[i].length;
+	}
+
+	tracing_buffer_event_commit(buf, length);
+	tracing_trigger_output(before_put_is_empty);
+}
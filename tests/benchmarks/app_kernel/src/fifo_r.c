@@ -29,6 +29,11 @@ void dequtask(void)
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
 		k_msgq_get(&DEMOQX4, &x, K_FOREVER);
 	}
+
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH_SIZE) {
+		k_msgq_get_many(&DEMOQX4, data_recv, FIFO_BATCH_SIZE,
+				FIFO_BATCH_SIZE, K_FOREVER);
+	}
 }
 
 
@@ -13,11 +13,76 @@
  *  1. From __start to main()
  *  2. From __start to task
  *  3. From __start to idle
+ *
+ * With CONFIG_DEVICE_INIT_TIMING, also report how long each init function
+ * took and the chain of init functions that determined when main() ran.
  */
 
 #include <zephyr.h>
 #include <tc_util.h>
 #include <kernel_internal.h>
+#include <init.h>
+#include <device.h>
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+static uint32_t cyc_to_us(uint32_t cyc)
+{
+	return (uint32_t)ceiling_fraction(USEC_PER_SEC * (uint64_t)cyc,
+					  sys_clock_hw_cycles_per_sec());
+}
+
+static void print_init_entry(const struct init_entry *entry)
+{
+	const struct init_timing *t = entry->timing;
+
+	if (entry->dev != NULL) {
+		TC_PRINT("  %-20s", entry->dev->name);
+	} else {
+		TC_PRINT("  %-20p", entry->init);
+	}
+	TC_PRINT(" %10u -> %10u: %u us\n", t->start, t->end,
+		 cyc_to_us(t->end - t->start));
+}
+
+/*
+ * The critical path is found walking back from the entry that finished
+ * last: an entry was held up by whichever one started before it and
+ * finished last before it began. Entries start in link order, so only
+ * earlier entries are candidates.
+ */
+static void print_init_report(void)
+{
+	const struct init_entry *entries, *cur = NULL;
+	size_t num = z_init_get_all_static(&entries);
+	uint32_t path = 0;
+
+	TC_PRINT("Init functions (start -> end cycles):\n");
+	for (size_t i = 0; i < num; i++) {
+		print_init_entry(&entries[i]);
+		if ((cur == NULL) || (entries[i].timing->end >= cur->timing->end)) {
+			cur = &entries[i];
+		}
+	}
+
+	TC_PRINT("Critical path, last first:\n");
+	while (cur != NULL) {
+		const struct init_entry *prev = NULL;
+
+		print_init_entry(cur);
+		path += cur->timing->end - cur->timing->start;
+
+		for (const struct init_entry *e = entries; e < cur; e++) {
+			if ((e->timing->end <= cur->timing->start) &&
+			    ((prev == NULL) ||
+			     (e->timing->end >= prev->timing->end))) {
+				prev = e;
+			}
+		}
+		cur = prev;
+	}
+	TC_PRINT("Critical path: %u cycles, %u us\n", path, cyc_to_us(path));
+}
+#endif
 
 void main(void)
 {
@@ -52,6 +117,9 @@ void main(void)
 						       task_us);
 	TC_PRINT("_start->idle  : %u cycles, %u us\n", z_timestamp_idle,
 						       idle_us);
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	print_init_report();
+#endif
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	TC_END_RESULT(TC_PASS);
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/crc.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+/* Measures crc32_ieee_update() with the implementation selected by
+ * CONFIG_CRC32_IMPLEMENTATION, against a bitwise reference. Each figure
+ * is an average in timing API cycles per call for the given length.
+ *
+ * The result is first checked against the reference for every length
+ * and alignment up to 64 bytes, and when computed in pieces.
+ */
+
+#define N_RUNS 32
+#define BUF_LEN 4096
+
+static uint8_t buf[BUF_LEN + 8] __aligned(8);
+
+static uint32_t crc32_ref(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+		}
+	}
+
+	return ~crc;
+}
+
+static bool check(void)
+{
+	uint32_t crc;
+	bool ok = true;
+
+	if (crc32_ieee((const uint8_t *)"123456789", 9) != 0xCBF43926U) {
+		printk("check value mismatch\n");
+		ok = false;
+	}
+
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len <= 64; len++) {
+			if (crc32_ieee(&buf[off], len) !=
+			    crc32_ref(0, &buf[off], len)) {
+				printk("mismatch off %u len %u\n",
+				       (unsigned int)off, (unsigned int)len);
+				ok = false;
+			}
+		}
+	}
+
+	crc = crc32_ieee_update(0, buf, 13);
+	crc = crc32_ieee_update(crc, &buf[13], 100);
+	crc = crc32_ieee_update(crc, &buf[113], BUF_LEN - 113);
+	if (crc != crc32_ref(0, buf, BUF_LEN)) {
+		printk("incremental mismatch\n");
+		ok = false;
+	}
+
+	return ok;
+}
+
+static void bench(size_t len)
+{
+	timing_t start, end;
+	volatile uint32_t crc = 0;
+	uint32_t cyc, ref;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_RUNS; i++) {
+		crc = crc32_ieee_update(crc, buf, len);
+	}
+	end = timing_counter_get();
+	cyc = (uint32_t)(timing_cycles_get(&start, &end) / N_RUNS);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_RUNS; i++) {
+		crc = crc32_ref(crc, buf, len);
+	}
+	end = timing_counter_get();
+	ref = (uint32_t)(timing_cycles_get(&start, &end) / N_RUNS);
+
+	printk("len %5u %8u cycles, bitwise %8u\n",
+	       (unsigned int)len, cyc, ref);
+}
+
+void main(void)
+{
+	uint32_t x = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		/* xorshift32 */
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		buf[i] = (uint8_t)x;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("crc32_ieee_update(), %s implementation\n",
+	       IS_ENABLED(CONFIG_CRC32_ARCH) ? "arch" :
+	       IS_ENABLED(CONFIG_CRC32_SW_SLICE8) ? "slicing-by-8" :
+	       IS_ENABLED(CONFIG_CRC32_SW_BYTE) ? "byte table" :
+	       IS_ENABLED(CONFIG_CRC32_SW_NIBBLE) ? "nibble table" :
+	       "bitwise");
+
+	if (!check()) {
+		printk("FAILED\n");
+		return;
+	}
+
+	bench(16);
+	bench(256);
+	bench(BUF_LEN);
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+/* Measures device_get_binding() with a few hundred devices defined.
+ * Each figure is an average in timing API cycles per lookup:
+ *
+ * rom: the name passed is the pointer the device was defined with
+ * ram: the name passed is a copy, so it has to be compared as a string
+ *
+ * for the first and last device defined, and for a name no device has.
+ */
+
+#define N_LOOKUPS 1000
+
+static int bench_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+#define BENCH_DEV(g, i)							\
+	DEVICE_DEFINE(bench_dev_##g##_##i, "bench_dev_" #g "_" #i,	\
+		      bench_dev_init, device_pm_control_nop, NULL, NULL,	\
+		      APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY, NULL);
+
+#define BENCH_DEV_GROUP(g)						\
+	BENCH_DEV(g, 0) BENCH_DEV(g, 1) BENCH_DEV(g, 2) BENCH_DEV(g, 3)	\
+	BENCH_DEV(g, 4) BENCH_DEV(g, 5) BENCH_DEV(g, 6) BENCH_DEV(g, 7)	\
+	BENCH_DEV(g, 8) BENCH_DEV(g, 9) BENCH_DEV(g, a) BENCH_DEV(g, b)	\
+	BENCH_DEV(g, c) BENCH_DEV(g, d) BENCH_DEV(g, e) BENCH_DEV(g, f)
+
+/* 256 devices */
+BENCH_DEV_GROUP(0) BENCH_DEV_GROUP(1) BENCH_DEV_GROUP(2) BENCH_DEV_GROUP(3)
+BENCH_DEV_GROUP(4) BENCH_DEV_GROUP(5) BENCH_DEV_GROUP(6) BENCH_DEV_GROUP(7)
+BENCH_DEV_GROUP(8) BENCH_DEV_GROUP(9) BENCH_DEV_GROUP(a) BENCH_DEV_GROUP(b)
+BENCH_DEV_GROUP(c) BENCH_DEV_GROUP(d) BENCH_DEV_GROUP(e) BENCH_DEV_GROUP(f)
+
+static char name_copy[Z_DEVICE_MAX_NAME_LEN];
+
+static uint32_t lookup_cycles(const char *name, bool expect_found)
+{
+	timing_t start, end;
+	const struct device *dev = NULL;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		dev = device_get_binding(name);
+	}
+	end = timing_counter_get();
+
+	if ((dev != NULL) != expect_found) {
+		printk("lookup of %s gave %p\n", name, dev);
+	}
+
+	return (uint32_t)(timing_cycles_get(&start, &end) / N_LOOKUPS);
+}
+
+static void bench_lookup(const char *label, const char *name,
+			 bool expect_found)
+{
+	uint32_t rom, ram;
+
+	rom = lookup_cycles(name, expect_found);
+
+	strncpy(name_copy, name, sizeof(name_copy) - 1);
+	ram = lookup_cycles(name_copy, expect_found);
+
+	printk("%-10s rom %6u ram %6u\n", label, rom, ram);
+}
+
+void main(void)
+{
+	const struct device *devs;
+	size_t num = z_device_get_all_static(&devs);
+
+	timing_init();
+	timing_start();
+
+	printk("device_get_binding() with %u devices, hash table %s\n",
+	       (unsigned int)num,
+	       IS_ENABLED(CONFIG_DEVICE_NAME_HASH) ? "on" : "off");
+
+	bench_lookup("first", DEVICE_GET(bench_dev_0_0)->name, true);
+	bench_lookup("last", DEVICE_GET(bench_dev_f_f)->name, true);
+	bench_lookup("missing", "no_such_device", false);
+
+	timing_stop();
+
+	printk("fin\n");
+}
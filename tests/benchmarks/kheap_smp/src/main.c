@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* SMP heap throughput benchmark: for each thread count N, N equal
+ * priority threads share one k_heap and loop replacing blocks in a
+ * small private working set with new blocks of pseudo-random small
+ * sizes for MEASURE_MS.  The total number of alloc/free pairs per
+ * second is reported, showing how the heap lock scales as more CPUs
+ * allocate at once.
+ */
+
+#define MEASURE_MS 1000
+#define NUM_WORKERS CONFIG_MP_NUM_CPUS
+#define WORKING_SET 16
+#define MIN_BLOCK 8
+#define MAX_BLOCK 128
+#define HEAP_BYTES (NUM_WORKERS * WORKING_SET * MAX_BLOCK * 4)
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+K_HEAP_DEFINE(bench_heap, HEAP_BYTES);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS];
+
+static uint32_t op_counts[NUM_WORKERS];
+static volatile bool stop;
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+	uint32_t rand_state = (uint32_t)(uintptr_t)p1;
+	void *blocks[WORKING_SET] = { NULL };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; !stop; i = (i + 1) % WORKING_SET) {
+		size_t bytes;
+
+		rand_state = rand_state * 1103515245U + 12345U;
+		bytes = MIN_BLOCK + (rand_state >> 8) % (MAX_BLOCK - MIN_BLOCK);
+
+		k_heap_free(&bench_heap, blocks[i]);
+		blocks[i] = k_heap_alloc(&bench_heap, bytes, K_NO_WAIT);
+		__ASSERT(blocks[i] != NULL, "heap exhausted");
+		*(volatile uint8_t *)blocks[i] = 0U;
+
+		(*count)++;
+	}
+
+	for (int i = 0; i < WORKING_SET; i++) {
+		k_heap_free(&bench_heap, blocks[i]);
+	}
+}
+
+static uint64_t run(int nthreads)
+{
+	uint64_t total = 0U;
+
+	stop = false;
+
+	for (int i = 0; i < nthreads; i++) {
+		op_counts[i] = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker_fn,
+				&op_counts[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(MEASURE_MS);
+	stop = true;
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		total += op_counts[i];
+	}
+
+	return total * MSEC_PER_SEC / MEASURE_MS;
+}
+
+void main(void)
+{
+	/* Stay above the workers so we get the CPU back promptly */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("%s, %d CPUs\n",
+	       IS_ENABLED(CONFIG_HEAP_CPU_CACHE) ? "per-CPU caches" : "no caches",
+	       CONFIG_MP_NUM_CPUS);
+
+	for (int n = 1; n <= NUM_WORKERS; n++) {
+		printk("threads %d ops/sec %u\n", n, (uint32_t)run(n));
+	}
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	struct k_heap_cache_stats stats;
+
+	k_heap_cache_stats_get(&bench_heap, &stats);
+	printk("cache hits %u misses %u frees %u drains %u flushes %u\n",
+	       stats.hits, stats.misses, stats.frees, stats.drains,
+	       stats.flushes);
+#endif
+
+	printk("fin\n");
+}
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+
+/* Measures the cost of deferred logging. Messages are logged in batches
+ * which fit in the log buffer, each batch is then processed. Figures are
+ * averages in timing API cycles per message:
+ *
+ * log:  at the call site
+ * proc: in log_process(), with a backend which discards messages so that
+ *       formatting is not included
+ *
+ * followed by the resulting number of messages per second.
+ */
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define BATCH 32
+#define N_BATCHES 32
+
+enum scenario {
+	BENCH_INTS,
+	BENCH_STRING,
+	BENCH_HEXDUMP,
+};
+
+static uint32_t processed;
+static uint32_t drops;
+static char str_buf[] = "transient";
+static const uint8_t data[16] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+static void put(const struct log_backend *const backend, struct log_msg *msg)
+{
+	processed++;
+}
+
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	processed++;
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	drops += cnt;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.put = put,
+	.put_msg2 = IS_ENABLED(CONFIG_LOG2) ? put_msg2 : NULL,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, false);
+
+static void log_one(enum scenario scenario, int i)
+{
+	switch (scenario) {
+	case BENCH_INTS:
+		LOG_INF("bench %d %d", i, 2 * i);
+		break;
+	case BENCH_STRING:
+		LOG_INF("bench %s %d", log_strdup(str_buf), i);
+		break;
+	case BENCH_HEXDUMP:
+		LOG_HEXDUMP_INF(data, sizeof(data), "bench");
+		break;
+	}
+}
+
+static void bench_log(const char *label, enum scenario scenario)
+{
+	timing_t start, end;
+	uint64_t log_cyc = 0, proc_cyc = 0, ns;
+	uint32_t total = BATCH * N_BATCHES;
+
+	processed = 0;
+	drops = 0;
+
+	for (int b = 0; b < N_BATCHES; b++) {
+		start = timing_counter_get();
+		for (int i = 0; i < BATCH; i++) {
+			log_one(scenario, i);
+		}
+		end = timing_counter_get();
+		log_cyc += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		while (log_process(false)) {
+		}
+		end = timing_counter_get();
+		proc_cyc += timing_cycles_get(&start, &end);
+	}
+
+	ns = timing_cycles_to_ns(log_cyc + proc_cyc);
+
+	printk("%-8s log %6u proc %6u cycles/msg, %u msgs/s",
+	       label, (uint32_t)(log_cyc / total), (uint32_t)(proc_cyc / total),
+	       ns ? (uint32_t)(total * 1000000000ULL / ns) : 0U);
+	if (processed != total) {
+		printk(", %u processed %u dropped", processed, drops);
+	}
+	printk("\n");
+}
+
+void main(void)
+{
+	log_init();
+	log_backend_enable(&bench_backend, NULL, LOG_LEVEL_INF);
+
+	timing_init();
+	timing_start();
+
+	printk("deferred logging, %s messages\n",
+	       IS_ENABLED(CONFIG_LOG2) ? "packaged" : "legacy");
+
+	bench_log("ints", BENCH_INTS);
+	bench_log("string", BENCH_STRING);
+	bench_log("hexdump", BENCH_HEXDUMP);
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <irq_offload.h>
+#include <timing/timing.h>
+
+/* Compares the handoff cost of k_fifo against k_mpsc_queue.  Each
+ * figure is an average in timing API cycles per item:
+ *
+ * put:    putting an item while nobody waits on the queue
+ * get:    getting an item that is already queued, without waiting
+ * isr put: the same as put, but done in bursts from an ISR, which is
+ *         the UART/CAN receive pattern these queues are meant for
+ * wakeup: from the put to a higher priority consumer blocked on the
+ *         empty queue running with the item
+ */
+
+#define N_ITEMS 256
+#define N_WAKEUPS 100
+#define STACK_SIZE 1024
+
+struct item {
+	/* Large enough for either queue's node */
+	union {
+		void *fifo_reserved;
+		sys_mpsc_node_t mpsc_node;
+	};
+	timing_t put_stamp;
+};
+
+struct queue_ops {
+	const char *name;
+	void (*put)(struct item *it);
+	struct item *(*get)(k_timeout_t timeout);
+};
+
+static struct item items[N_ITEMS];
+
+static K_FIFO_DEFINE(fifo);
+static K_MPSC_QUEUE_DEFINE(mpsc);
+
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread consumer_thread;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static const struct queue_ops *cur_ops;
+static uint64_t wakeup_cycles;
+
+static void fifo_put(struct item *it)
+{
+	k_fifo_put(&fifo, it);
+}
+
+static struct item *fifo_get(k_timeout_t timeout)
+{
+	return k_fifo_get(&fifo, timeout);
+}
+
+static void mpsc_put(struct item *it)
+{
+	k_mpsc_queue_put(&mpsc, &it->mpsc_node);
+}
+
+static struct item *mpsc_get(k_timeout_t timeout)
+{
+	sys_mpsc_node_t *node = k_mpsc_queue_get(&mpsc, timeout);
+
+	return node == NULL ? NULL : CONTAINER_OF(node, struct item, mpsc_node);
+}
+
+static const struct queue_ops all_ops[] = {
+	{ "k_fifo", fifo_put, fifo_get },
+	{ "k_mpsc_queue", mpsc_put, mpsc_get },
+};
+
+static void isr_burst(const void *arg)
+{
+	const struct queue_ops *ops = arg;
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		ops->put(&items[i]);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		struct item *it = cur_ops->get(K_FOREVER);
+		timing_t now = timing_counter_get();
+
+		wakeup_cycles += timing_cycles_get(&it->put_stamp, &now);
+		k_sem_give(&done_sem);
+	}
+}
+
+static void measure(const struct queue_ops *ops)
+{
+	timing_t t0, t1, t2;
+	uint64_t isr_put;
+
+	t0 = timing_counter_get();
+	for (int i = 0; i < N_ITEMS; i++) {
+		ops->put(&items[i]);
+	}
+	t1 = timing_counter_get();
+	for (int i = 0; i < N_ITEMS; i++) {
+		(void)ops->get(K_NO_WAIT);
+	}
+	t2 = timing_counter_get();
+
+	uint64_t put = timing_cycles_get(&t0, &t1);
+	uint64_t get = timing_cycles_get(&t1, &t2);
+
+	t0 = timing_counter_get();
+	irq_offload(isr_burst, ops);
+	t1 = timing_counter_get();
+	isr_put = timing_cycles_get(&t0, &t1);
+	for (int i = 0; i < N_ITEMS; i++) {
+		(void)ops->get(K_NO_WAIT);
+	}
+
+	/* The consumer preempts us on every put */
+	cur_ops = ops;
+	wakeup_cycles = 0U;
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		items[0].put_stamp = timing_counter_get();
+		ops->put(&items[0]);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	printk("%-12s put %6u get %6u isr put %6u wakeup %6u\n", ops->name,
+	       (uint32_t)(put / N_ITEMS), (uint32_t)(get / N_ITEMS),
+	       (uint32_t)(isr_put / N_ITEMS),
+	       (uint32_t)(wakeup_cycles / N_WAKEUPS));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	printk("timing frequency %u MHz\n", timing_freq_get_mhz());
+
+	for (int i = 0; i < ARRAY_SIZE(all_ops); i++) {
+		measure(&all_ops[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+#include <net/udp.h>
+#include <timing/timing.h>
+
+#include "connection.h"
+
+/* Time taken by net_conn_input() to find the handler of a received UDP
+ * packet, in timing API cycles, versus the number of registered handlers.
+ * "bound" handlers each have their own local port, "connected" ones share
+ * a local port with a bound handler and differ by remote port, as
+ * accepted TCP connections do. Packets match the oldest handler, which is
+ * the last one a walk of all handlers visits.
+ */
+
+#define N_RUNS 64
+#define LOCAL_PORT 4000
+#define REMOTE_PORT 5000
+
+static const int counts[] = { 1, 16, 64, 256 };
+
+static struct net_conn_handle *handles[257];
+static struct net_conn_handle *expected;
+static int delivered;
+
+static struct net_ipv6_hdr ipv6;
+static struct net_udp_hdr udp;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	if ((struct net_conn_handle *)conn == expected) {
+		delivered++;
+	}
+
+	/* The packet is reused for the next run */
+	return NET_OK;
+}
+
+static uint32_t measure(struct net_pkt *pkt, uint16_t src_port,
+			uint16_t dst_port)
+{
+	union net_ip_header ip_hdr = { .ipv6 = &ipv6 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	timing_t start, end;
+	uint64_t cycles = 0;
+
+	udp.src_port = htons(src_port);
+	udp.dst_port = htons(dst_port);
+	delivered = 0;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		start = timing_counter_get();
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	if (delivered != N_RUNS) {
+		printk("packets delivered to the wrong handler\n");
+	}
+
+	return (uint32_t)(cycles / N_RUNS);
+}
+
+static int register_conn(struct sockaddr_in6 *remote, uint16_t remote_port,
+			 uint16_t local_port, struct net_conn_handle **handle)
+{
+	return net_conn_register(IPPROTO_UDP, AF_INET6,
+				 (struct sockaddr *)remote, NULL,
+				 remote_port, local_port, conn_cb, NULL,
+				 handle);
+}
+
+void main(void)
+{
+	struct sockaddr_in6 remote = { .sin6_family = AF_INET6 };
+	uint32_t bound, connected;
+	struct net_pkt *pkt;
+
+	net_ipv6_addr_create(&ipv6.src, 0x2001, 0xdb8, 0, 0, 0, 0, 0, 2);
+	net_ipv6_addr_create(&ipv6.dst, 0x2001, 0xdb8, 0, 0, 0, 0, 0, 1);
+	net_ipaddr_copy(&remote.sin6_addr, &ipv6.src);
+
+	pkt = net_pkt_alloc_on_iface(net_if_get_default(), K_NO_WAIT);
+	if (!pkt) {
+		printk("cannot allocate packet\n");
+		return;
+	}
+
+	net_pkt_set_family(pkt, AF_INET6);
+
+	timing_init();
+	timing_start();
+
+	for (int n = 0; n < ARRAY_SIZE(counts); n++) {
+		int count = counts[n];
+
+		for (int i = 0; i < count; i++) {
+			if (register_conn(NULL, 0, LOCAL_PORT + i,
+					  &handles[i]) < 0) {
+				printk("cannot register handler %d\n", i);
+				return;
+			}
+		}
+
+		expected = handles[0];
+		bound = measure(pkt, REMOTE_PORT, LOCAL_PORT);
+
+		for (int i = 1; i < count; i++) {
+			(void)net_conn_unregister(handles[i]);
+		}
+
+		/* handles[0] is left as the listener of the connections */
+		for (int i = 1; i <= count; i++) {
+			if (register_conn(&remote, REMOTE_PORT + i, LOCAL_PORT,
+					  &handles[i]) < 0) {
+				printk("cannot register handler %d\n", i);
+				return;
+			}
+		}
+
+		expected = handles[1];
+		connected = measure(pkt, REMOTE_PORT + 1, LOCAL_PORT);
+
+		for (int i = 0; i <= count; i++) {
+			(void)net_conn_unregister(handles[i]);
+		}
+
+		printk("connections: %4d bound %8u connected %8u cycles/packet\n",
+		       count, bound, connected);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+}
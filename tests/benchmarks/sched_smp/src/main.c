@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <kernel_structs.h>
+#include <sys/printk.h>
+
+/* SMP scheduler benchmark.  For each CPU count N the workers may run
+ * on any of the first N CPUs and are placed by the scheduler alone.
+ * Every iteration a worker notes which CPU it is on, so besides the
+ * throughput the benchmark reports how often threads moved between
+ * CPUs, i.e. how much stealing the run queue layout leads to.
+ *
+ * Two loads are run:
+ *
+ * - "yield": every worker loops in k_yield(), so each iteration
+ *   requeues a thread and contends for the run queue(s).
+ * - "wake": workers are paired and pass a token back and forth
+ *   through semaphores, so each iteration readies a blocked thread
+ *   which then has to be placed on some CPU.
+ */
+
+#define MEASURE_MS 1000
+#define THREADS_PER_CPU 2
+#define NUM_WORKERS (THREADS_PER_CPU * CONFIG_MP_NUM_CPUS)
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct worker {
+	struct k_sem sem;
+	struct worker *peer;
+	int cpu;
+	uint32_t ops;
+	uint32_t migrations;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS];
+static struct worker workers[NUM_WORKERS];
+static volatile bool stop;
+
+static int curr_cpu(void)
+{
+	unsigned int key = arch_irq_lock();
+	int ret = arch_curr_cpu()->id;
+
+	arch_irq_unlock(key);
+	return ret;
+}
+
+static void note_iteration(struct worker *w)
+{
+	int cpu = curr_cpu();
+
+	if (cpu != w->cpu) {
+		if (w->cpu >= 0) {
+			w->migrations++;
+		}
+		w->cpu = cpu;
+	}
+	w->ops++;
+}
+
+static void yield_fn(void *p1, void *p2, void *p3)
+{
+	struct worker *w = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		note_iteration(w);
+		k_yield();
+	}
+}
+
+static void wake_fn(void *p1, void *p2, void *p3)
+{
+	struct worker *w = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&w->sem, K_FOREVER);
+		if (stop) {
+			break;
+		}
+		note_iteration(w);
+		k_sem_give(&w->peer->sem);
+	}
+}
+
+static void run(const char *name, k_thread_entry_t fn, int ncpus)
+{
+	int nthreads = THREADS_PER_CPU * ncpus;
+	uint64_t ops = 0U, migrations = 0U;
+
+	stop = false;
+
+	for (int i = 0; i < nthreads; i++) {
+		struct worker *w = &workers[i];
+
+		k_sem_init(&w->sem, 0, 1);
+		w->peer = &workers[i ^ 1];
+		w->cpu = -1;
+		w->ops = 0U;
+		w->migrations = 0U;
+
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, fn, w, NULL, NULL,
+				WORKER_PRIO, 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&worker_threads[i]);
+		for (int cpu = 0; cpu < ncpus; cpu++) {
+			k_thread_cpu_mask_enable(&worker_threads[i], cpu);
+		}
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_start(&worker_threads[i]);
+	}
+
+	/* One token per pair; ignored by the yield load */
+	for (int i = 0; i < nthreads; i += 2) {
+		k_sem_give(&workers[i].sem);
+	}
+
+	k_msleep(MEASURE_MS);
+	stop = true;
+
+	for (int i = 0; i < nthreads; i++) {
+		k_sem_give(&workers[i].sem);
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		ops += workers[i].ops;
+		migrations += workers[i].migrations;
+	}
+
+	printk("%-5s cpus %d ops/sec %u migrations/sec %u\n", name, ncpus,
+	       (uint32_t)(ops * MSEC_PER_SEC / MEASURE_MS),
+	       (uint32_t)(migrations * MSEC_PER_SEC / MEASURE_MS));
+}
+
+void main(void)
+{
+	printk("%s run queue(s), %d CPUs\n",
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per-CPU" : "shared",
+	       CONFIG_MP_NUM_CPUS);
+
+	for (int ncpus = 1; ncpus <= CONFIG_MP_NUM_CPUS; ncpus++) {
+		run("yield", yield_fn, ncpus);
+		run("wake", wake_fn, ncpus);
+	}
+
+	printk("fin\n");
+}
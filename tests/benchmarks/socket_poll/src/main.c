@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <timing/timing.h>
+
+/* Compares the cost of finding the one readable socket among many idle
+ * ones with zsock_poll(), which registers with every socket on each call,
+ * and with a persistent zsock_poll_set. Each figure is an average in
+ * timing API cycles per call, measured once the datagram was received.
+ */
+
+#define N_IDLE 256
+#define N_SOCKS (N_IDLE + 1)
+#define N_RUNS 32
+#define BASE_PORT 5000
+
+static int socks[N_SOCKS];
+static struct zsock_pollfd pollfds[N_SOCKS];
+static struct zsock_poll_set pset;
+static struct zsock_poll_set_entry entries[N_SOCKS];
+
+static int udp_socket(uint16_t port, struct sockaddr_in6 *addr)
+{
+	int sock;
+
+	sock = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -1;
+	}
+
+	memset(addr, 0, sizeof(*addr));
+	addr->sin6_family = AF_INET6;
+	addr->sin6_port = htons(port);
+	zsock_inet_pton(AF_INET6, CONFIG_NET_CONFIG_MY_IPV6_ADDR,
+			&addr->sin6_addr);
+
+	if (zsock_bind(sock, (struct sockaddr *)addr, sizeof(*addr)) < 0) {
+		zsock_close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+void main(void)
+{
+	struct zsock_poll_set_entry *ready[4];
+	struct sockaddr_in6 addr;
+	struct zsock_pollfd active;
+	timing_t start, end;
+	uint64_t poll_cyc = 0;
+	uint64_t set_cyc = 0;
+	int sender;
+	char c = 0;
+	int ret;
+
+	zsock_poll_set_init(&pset);
+
+	for (int i = 0; i < N_SOCKS; i++) {
+		socks[i] = udp_socket(BASE_PORT + i, &addr);
+		if (socks[i] < 0) {
+			printk("socket %d failed (%d)\n", i, errno);
+			return;
+		}
+
+		pollfds[i].fd = socks[i];
+		pollfds[i].events = ZSOCK_POLLIN;
+
+		if (zsock_poll_set_add(&pset, &entries[i], socks[i],
+				       ZSOCK_POLLIN, NULL) < 0) {
+			printk("zsock_poll_set_add() failed (%d)\n", errno);
+			return;
+		}
+	}
+
+	/* The last socket is the active one */
+	sender = udp_socket(BASE_PORT + N_SOCKS, &addr);
+	addr.sin6_port = htons(BASE_PORT + N_IDLE);
+	if (sender < 0 ||
+	    zsock_connect(sender, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("sender failed (%d)\n", errno);
+		return;
+	}
+
+	active.fd = socks[N_IDLE];
+	active.events = ZSOCK_POLLIN;
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		(void)zsock_send(sender, &c, 1, 0);
+		if (zsock_poll(&active, 1, 1000) != 1) {
+			printk("datagram not received\n");
+			return;
+		}
+
+		start = timing_counter_get();
+		ret = zsock_poll(pollfds, N_SOCKS, 0);
+		end = timing_counter_get();
+		poll_cyc += timing_cycles_get(&start, &end);
+		if (ret != 1 || pollfds[N_IDLE].revents != ZSOCK_POLLIN) {
+			printk("zsock_poll() returned %d\n", ret);
+			return;
+		}
+
+		start = timing_counter_get();
+		ret = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+		end = timing_counter_get();
+		set_cyc += timing_cycles_get(&start, &end);
+		if (ret != 1 || ready[0] != &entries[N_IDLE]) {
+			printk("zsock_poll_set_wait() returned %d\n", ret);
+			return;
+		}
+
+		(void)zsock_recv(socks[N_IDLE], &c, 1, 0);
+	}
+
+	timing_stop();
+
+	printk("zsock_poll()          %d sockets %8u cycles/call\n",
+	       N_SOCKS, (uint32_t)(poll_cyc / N_RUNS));
+	printk("zsock_poll_set_wait() %d sockets %8u cycles/call\n",
+	       N_SOCKS, (uint32_t)(set_cyc / N_RUNS));
+
+	printk("fin\n");
+}
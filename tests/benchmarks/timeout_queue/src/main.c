@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+#include <timing/timing.h>
+
+/* This is a timeout queue microbenchmark, designed to show how the
+ * cost of the low level z_add_timeout()/z_abort_timeout()/
+ * z_clock_announce() primitives scales with the number of timeouts
+ * already pending.  For each step the main thread arms a set of
+ * "background" timeouts spread pseudo-randomly far in the future (so
+ * they never fire during the run) and then measures:
+ *
+ * arm:    z_add_timeout() of one more timeout at a random deadline
+ * cancel: z_abort_timeout() of that same timeout
+ * expire: the time z_clock_announce() spends between the callbacks
+ *         of two timeouts due on the same tick, i.e. the cost of
+ *         popping one expired entry off the queue
+ *
+ * Each figure is an average in timing API cycles.  Build with
+ * CONFIG_TIMEOUT_QUEUE_DUMB or CONFIG_TIMEOUT_QUEUE_SCALABLE to
+ * compare the backends.
+ */
+
+#define N_RUNS 100
+#define N_EXPIRE_RUNS 10
+#define MAX_PENDING 3000
+#define FAR_TICKS 1000000
+
+static const int pending_counts[] = { 1, 10, 100, 1000, MAX_PENDING };
+
+static struct _timeout pending[MAX_PENDING];
+static struct _timeout probe;
+static struct _timeout expire_first, expire_second;
+
+static timing_t expire_stamps[2];
+static K_SEM_DEFINE(expired_sem, 0, 1);
+
+static uint32_t rand_state = 1U;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static k_timeout_t far_timeout(void)
+{
+	return K_TICKS(FAR_TICKS + (next_rand() % FAR_TICKS));
+}
+
+static void never_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void expire_first_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expire_stamps[0] = timing_counter_get();
+}
+
+static void expire_second_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expire_stamps[1] = timing_counter_get();
+	k_sem_give(&expired_sem);
+}
+
+static uint64_t measure_expire(void)
+{
+	/* Both timeouts land on the same absolute tick, so they are
+	 * expired back to back within one z_clock_announce() call
+	 */
+	k_timeout_t when = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 2);
+
+	z_add_timeout(&expire_first, expire_first_fn, when);
+	z_add_timeout(&expire_second, expire_second_fn, when);
+	k_sem_take(&expired_sem, K_FOREVER);
+
+	return timing_cycles_get(&expire_stamps[0], &expire_stamps[1]);
+}
+
+void main(void)
+{
+	int armed = 0;
+
+	timing_init();
+	timing_start();
+
+	printk("timing frequency %u MHz\n", timing_freq_get_mhz());
+
+	for (int c = 0; c < ARRAY_SIZE(pending_counts); c++) {
+		uint64_t arm = 0U, cancel = 0U, expire = 0U;
+
+		for (; armed < pending_counts[c]; armed++) {
+			z_add_timeout(&pending[armed], never_fn, far_timeout());
+		}
+
+		for (int i = 0; i < N_RUNS; i++) {
+			k_timeout_t to = far_timeout();
+			timing_t t0, t1, t2;
+
+			t0 = timing_counter_get();
+			z_add_timeout(&probe, never_fn, to);
+			t1 = timing_counter_get();
+			z_abort_timeout(&probe);
+			t2 = timing_counter_get();
+
+			arm += timing_cycles_get(&t0, &t1);
+			cancel += timing_cycles_get(&t1, &t2);
+		}
+
+		for (int i = 0; i < N_EXPIRE_RUNS; i++) {
+			expire += measure_expire();
+		}
+
+		printk("pending %5d arm %6u cancel %6u expire %6u\n",
+		       armed,
+		       (uint32_t)(arm / N_RUNS),
+		       (uint32_t)(cancel / N_RUNS),
+		       (uint32_t)(expire / N_EXPIRE_RUNS));
+	}
+
+	for (int i = 0; i < armed; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_WAITERS 3
+#define WAITER_PRIO(i) K_PRIO_PREEMPT(1 + (i))
+#define TIMEOUT_MS 50
+
+/**TESTPOINT: init via K_CONDVAR_DEFINE*/
+K_CONDVAR_DEFINE(kcondvar);
+K_MUTEX_DEFINE(kmutex);
+
+static struct k_condvar condvar;
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS, STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+
+static ZTEST_BMEM int woken;
+static ZTEST_BMEM int wake_order[NUM_WAITERS];
+static ZTEST_BMEM bool predicate;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	struct k_condvar *cv = p1;
+	int id = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&kmutex, K_FOREVER);
+	while (!predicate) {
+		zassert_equal(k_condvar_wait(cv, &kmutex, K_FOREVER), 0, NULL);
+		if (predicate) {
+			break;
+		}
+	}
+	wake_order[woken++] = id;
+	predicate = false;
+	k_mutex_unlock(&kmutex);
+}
+
+static void spawn_waiters(struct k_condvar *cv, uint32_t options)
+{
+	woken = 0;
+	predicate = false;
+
+	/* Lowest priority first, so that wake-up order can only come
+	 * from the wait queue and not from creation order
+	 */
+	for (int i = NUM_WAITERS - 1; i >= 0; i--) {
+		k_thread_create(&waiter_threads[i], waiter_stacks[i],
+				STACK_SIZE, waiter_entry,
+				cv, INT_TO_POINTER(i), NULL,
+				WAITER_PRIO(i), options, K_NO_WAIT);
+	}
+
+	/* Let all of them block on the condition variable */
+	k_msleep(10);
+	zassert_equal(woken, 0, NULL);
+}
+
+static void join_waiters(void)
+{
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+}
+
+static void signal_one(struct k_condvar *cv, int expected)
+{
+	k_mutex_lock(&kmutex, K_FOREVER);
+	predicate = true;
+	k_condvar_signal(cv);
+	k_mutex_unlock(&kmutex);
+	k_msleep(10);
+
+	zassert_equal(woken, expected, "woken %d, expected %d",
+		      woken, expected);
+}
+
+static void check_signal(struct k_condvar *cv, uint32_t options)
+{
+	spawn_waiters(cv, options);
+
+	/* Each signal wakes exactly one waiter, highest priority first */
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		signal_one(cv, i + 1);
+		zassert_equal(wake_order[i], i, NULL);
+	}
+
+	join_waiters();
+}
+
+/**
+ * @brief Test k_condvar_signal() wakes a single waiter
+ *
+ * @details Three threads of different priority wait on the condition
+ * variable.  Every k_condvar_signal() must wake exactly one of them,
+ * in priority order, leaving the others pended.
+ *
+ * @ingroup kernel_condvar_tests
+ */
+void test_condvar_signal(void)
+{
+	k_condvar_init(&condvar);
+	check_signal(&condvar, 0);
+}
+
+/**
+ * @brief Test k_condvar_signal() on a statically defined condvar from
+ * user mode
+ *
+ * @ingroup kernel_condvar_tests
+ */
+void test_condvar_signal_user(void)
+{
+	check_signal(&kcondvar, K_USER | K_INHERIT_PERMS);
+}
+
+/**
+ * @brief Test k_condvar_broadcast() wakes every waiter
+ *
+ * @ingroup kernel_condvar_tests
+ */
+void test_condvar_broadcast(void)
+{
+	k_condvar_init(&condvar);
+	spawn_waiters(&condvar, 0);
+
+	k_mutex_lock(&kmutex, K_FOREVER);
+	zassert_equal(k_condvar_broadcast(&condvar), NUM_WAITERS, NULL);
+	k_mutex_unlock(&kmutex);
+	k_msleep(10);
+
+	/* Only the first waiter to get the mutex sees the predicate
+	 * set; the others go back to waiting
+	 */
+	k_mutex_lock(&kmutex, K_FOREVER);
+	predicate = true;
+	k_mutex_unlock(&kmutex);
+	k_msleep(10);
+	zassert_equal(woken, 0, NULL);
+
+	zassert_equal(k_condvar_broadcast(&condvar), NUM_WAITERS, NULL);
+	k_msleep(10);
+	zassert_equal(woken, 1, NULL);
+
+	zassert_equal(k_condvar_broadcast(&condvar), NUM_WAITERS - 1, NULL);
+	for (int i = 1; i < NUM_WAITERS; i++) {
+		signal_one(&condvar, i + 1);
+	}
+
+	join_waiters();
+	zassert_equal(k_condvar_broadcast(&condvar), 0, NULL);
+}
+
+/**
+ * @brief Test k_condvar_wait() timeout
+ *
+ * @details The wait must time out with -EAGAIN and still return with
+ * the mutex held.
+ *
+ * @ingroup kernel_condvar_tests
+ */
+void test_condvar_wait_timeout(void)
+{
+	int64_t start;
+
+	k_condvar_init(&condvar);
+	k_mutex_lock(&kmutex, K_FOREVER);
+
+	start = k_uptime_get();
+	zassert_equal(k_condvar_wait(&condvar, &kmutex, K_MSEC(TIMEOUT_MS)),
+		      -EAGAIN, NULL);
+	zassert_true(k_uptime_get() - start >= TIMEOUT_MS, NULL);
+
+	zassert_equal(kmutex.owner, k_current_get(), NULL);
+	zassert_equal(kmutex.lock_count, 1, NULL);
+	k_mutex_unlock(&kmutex);
+
+	k_mutex_lock(&kmutex, K_FOREVER);
+	zassert_equal(k_condvar_wait(&condvar, &kmutex, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	k_mutex_unlock(&kmutex);
+}
+
+static void isr_signal(const void *arg)
+{
+	k_condvar_signal((struct k_condvar *)arg);
+}
+
+/**
+ * @brief Test k_condvar_signal() from an ISR
+ *
+ * @ingroup kernel_condvar_tests
+ */
+void test_condvar_signal_isr(void)
+{
+	k_condvar_init(&condvar);
+	spawn_waiters(&condvar, 0);
+
+	predicate = true;
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		irq_offload(isr_signal, &condvar);
+		k_msleep(10);
+		zassert_equal(woken, i + 1, NULL);
+		predicate = true;
+	}
+
+	join_waiters();
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &kcondvar, &kmutex);
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_access_grant(k_current_get(), &waiter_threads[i],
+				      waiter_stacks[i]);
+	}
+
+	ztest_test_suite(condvar_api,
+			 ztest_1cpu_unit_test(test_condvar_signal),
+			 ztest_1cpu_unit_test(test_condvar_signal_user),
+			 ztest_1cpu_unit_test(test_condvar_broadcast),
+			 ztest_unit_test(test_condvar_wait_timeout),
+			 ztest_1cpu_unit_test(test_condvar_signal_isr)
+			 );
+	ztest_run_test_suite(condvar_api);
+}
@@ -23,6 +23,7 @@ extern void test_mmio_multiple(void);
 extern void test_mmio_toplevel(void);
 extern void test_mmio_single(void);
 extern void test_mmio_device_map(void);
+extern void test_parallel_init(void);
 
 /**
  * @brief Test cases to verify device objects
@@ -453,6 +454,7 @@ void test_main(void)
 			 ztest_unit_test(test_mmio_single),
 			 ztest_unit_test(test_mmio_multiple),
 			 ztest_unit_test(test_mmio_toplevel),
-			 ztest_unit_test(test_mmio_device_map));
+			 ztest_unit_test(test_mmio_device_map),
+			 ztest_unit_test(test_parallel_init));
 	ztest_run_test_suite(device);
 }
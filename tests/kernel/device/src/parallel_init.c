@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <device.h>
+
+#define PARINIT_BUS	DT_PATH(parinit_bus)
+#define PARINIT_CHILD	DT_PATH(parinit_bus, parinit_child)
+#define PARINIT_LEAF	DT_PATH(parinit_leaf)
+#define PARINIT_FLASH	DT_PATH(parinit_flash)
+#define PARINIT_USER	DT_PATH(parinit_user)
+
+struct parinit_data {
+	uint32_t start;
+	uint32_t end;
+};
+
+static struct parinit_data bus_data, child_data, leaf_data;
+static struct parinit_data flash_data, user_data;
+
+/* How long each init function takes, in milliseconds */
+static const int32_t parinit_ms = 10;
+static const int32_t parinit_flash_ms = 30;
+
+/* Each init function blocks for a while, as probing slow hardware would */
+static int parinit_init(const struct device *dev)
+{
+	struct parinit_data *data = dev->data;
+	const int32_t *ms = dev->config;
+
+	data->start = k_uptime_get_32();
+	k_msleep(*ms);
+	data->end = k_uptime_get_32();
+
+	return 0;
+}
+
+DEVICE_DT_DEFINE(PARINIT_BUS, parinit_init, device_pm_control_nop,
+		 &bus_data, &parinit_ms, POST_KERNEL,
+		 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+DEVICE_DT_DEFINE(PARINIT_LEAF, parinit_init, device_pm_control_nop,
+		 &leaf_data, &parinit_ms, POST_KERNEL,
+		 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+DEVICE_DT_DEFINE(PARINIT_CHILD, parinit_init, device_pm_control_nop,
+		 &child_data, &parinit_ms, POST_KERNEL,
+		 CONFIG_APPLICATION_INIT_PRIORITY, NULL);
+DEVICE_DT_DEFINE(PARINIT_FLASH, parinit_init, device_pm_control_nop,
+		 &flash_data, &parinit_flash_ms, POST_KERNEL,
+		 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+DEVICE_DT_DEFINE(PARINIT_USER, parinit_init, device_pm_control_nop,
+		 &user_data, &parinit_ms, POST_KERNEL,
+		 CONFIG_APPLICATION_INIT_PRIORITY, NULL);
+
+/**
+ * @brief Test that only dependent devices are initialized one after another
+ *
+ * The bus and the leaf node are unrelated, so with
+ * CONFIG_DEVICE_INIT_PARALLEL their init functions overlap. The child
+ * node depends on the bus and must not start before the bus is done.
+ * The user node depends on the flash through partition nodes which have
+ * no device, it must still wait for the flash, which takes longer than
+ * the others.
+ *
+ * @ingroup kernel_device_tests
+ */
+void test_parallel_init(void)
+{
+	if (!IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL)) {
+		ztest_test_skip();
+	}
+
+	zassert_true(device_get_binding("PARINIT_CHILD") != NULL, NULL);
+	zassert_true(leaf_data.start < bus_data.end &&
+		     bus_data.start < leaf_data.end,
+		     "independent devices initialized serially");
+	zassert_true(child_data.start >= bus_data.end,
+		     "child initialized before its bus");
+	zassert_true(user_data.start >= flash_data.end,
+		     "device initialized before the flash it uses");
+}
@@ -0,0 +1,233 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_WAITERS 2
+#define TIMEOUT_MS 50
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+#define EV_C BIT(2)
+
+/**TESTPOINT: init via K_EVENT_DEFINE*/
+K_EVENT_DEFINE(kevent);
+
+static struct k_event event;
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS, STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+
+struct waiter_args {
+	struct k_event *event;
+	uint32_t events;
+	uint32_t options;
+	uint32_t result;
+	bool done;
+};
+
+static ZTEST_BMEM struct waiter_args args[NUM_WAITERS];
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	struct waiter_args *a = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	a->result = k_event_wait(a->event, a->events, a->options, K_FOREVER);
+	a->done = true;
+}
+
+static void spawn_waiter(int i, struct k_event *ev, uint32_t events,
+			 uint32_t options, uint32_t thread_options)
+{
+	args[i] = (struct waiter_args) {
+		.event = ev,
+		.events = events,
+		.options = options,
+	};
+
+	k_thread_create(&waiter_threads[i], waiter_stacks[i], STACK_SIZE,
+			waiter_entry, &args[i], NULL, NULL,
+			K_PRIO_PREEMPT(1 + i), thread_options, K_NO_WAIT);
+	k_msleep(10);
+	zassert_false(args[i].done, "waiter %d did not block", i);
+}
+
+/**
+ * @brief Test setting, clearing and polling events without blocking
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_set_clear(void)
+{
+	k_event_init(&event);
+
+	zassert_equal(k_event_wait(&event, EV_A, 0, K_NO_WAIT), 0, NULL);
+
+	zassert_equal(k_event_set(&event, EV_A | EV_B), 0, NULL);
+	zassert_equal(k_event_set(&event, EV_C), EV_A | EV_B, NULL);
+
+	zassert_equal(k_event_wait(&event, EV_A | BIT(5), 0, K_NO_WAIT),
+		      EV_A, NULL);
+	zassert_equal(k_event_wait(&event, EV_A | BIT(5), K_EVENT_WAIT_ALL,
+				   K_NO_WAIT), 0, NULL);
+	zassert_equal(k_event_wait(&event, EV_A | EV_C, K_EVENT_WAIT_ALL,
+				   K_NO_WAIT), EV_A | EV_C, NULL);
+
+	zassert_equal(k_event_clear(&event, EV_B), EV_A | EV_B | EV_C, NULL);
+	zassert_equal(k_event_wait(&event, EV_B, 0, K_NO_WAIT), 0, NULL);
+
+	/* Auto-clear consumes only the matched events */
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, K_EVENT_WAIT_CLEAR,
+				   K_NO_WAIT), EV_A, NULL);
+	zassert_equal(k_event_clear(&event, 0), EV_C, NULL);
+}
+
+/**
+ * @brief Test waiting for any event
+ *
+ * @details Two threads wait for different events; setting one of them
+ * must wake only the thread interested in it.
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_wait_any(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(0, &event, EV_A, 0, 0);
+	spawn_waiter(1, &event, EV_B | EV_C, 0, 0);
+
+	k_event_set(&event, EV_C);
+	k_msleep(10);
+	zassert_false(args[0].done, NULL);
+	zassert_true(args[1].done, NULL);
+	zassert_equal(args[1].result, EV_C, NULL);
+
+	k_event_set(&event, EV_A);
+	k_msleep(10);
+	zassert_true(args[0].done, NULL);
+	zassert_equal(args[0].result, EV_A, NULL);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test waiting for all events, from user mode
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_wait_all(void)
+{
+	k_event_clear(&kevent, ~0U);
+
+	spawn_waiter(0, &kevent, EV_A | EV_B, K_EVENT_WAIT_ALL,
+		     K_USER | K_INHERIT_PERMS);
+
+	k_event_set(&kevent, EV_A);
+	k_msleep(10);
+	zassert_false(args[0].done, NULL);
+
+	k_event_set(&kevent, EV_B | EV_C);
+	k_msleep(10);
+	zassert_true(args[0].done, NULL);
+	zassert_equal(args[0].result, EV_A | EV_B, NULL);
+
+	k_thread_join(&waiter_threads[0], K_FOREVER);
+}
+
+/**
+ * @brief Test auto-clear hands each posting to a single waiter
+ *
+ * @details Two threads wait for the same event with
+ * K_EVENT_WAIT_CLEAR.  Each k_event_set() must wake only one of them,
+ * the higher priority one first, and leave the event cleared.
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_wait_clear(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(1, &event, EV_A, K_EVENT_WAIT_CLEAR, 0);
+	spawn_waiter(0, &event, EV_A, K_EVENT_WAIT_CLEAR, 0);
+
+	k_event_set(&event, EV_A | EV_B);
+	k_msleep(10);
+	zassert_true(args[0].done, NULL);
+	zassert_false(args[1].done, NULL);
+	zassert_equal(args[0].result, EV_A, NULL);
+	zassert_equal(k_event_clear(&event, 0), EV_B, NULL);
+
+	k_event_set(&event, EV_A);
+	k_msleep(10);
+	zassert_true(args[1].done, NULL);
+	zassert_equal(k_event_clear(&event, 0), EV_B, NULL);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test k_event_wait() timeout
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_wait_timeout(void)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_equal(k_event_wait(&kevent, BIT(31), 0, K_MSEC(TIMEOUT_MS)),
+		      0, NULL);
+	zassert_true(k_uptime_get() - start >= TIMEOUT_MS, NULL);
+}
+
+static void isr_set(const void *arg)
+{
+	k_event_set((struct k_event *)arg, EV_B);
+}
+
+/**
+ * @brief Test k_event_set() from an ISR
+ *
+ * @ingroup kernel_event_tests
+ */
+void test_event_set_isr(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(0, &event, EV_B, 0, 0);
+	irq_offload(isr_set, &event);
+	k_msleep(10);
+	zassert_true(args[0].done, NULL);
+	zassert_equal(args[0].result, EV_B, NULL);
+
+	k_thread_join(&waiter_threads[0], K_FOREVER);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &kevent);
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_access_grant(k_current_get(), &waiter_threads[i],
+				      waiter_stacks[i]);
+	}
+
+	ztest_test_suite(event_api,
+			 ztest_unit_test(test_event_set_clear),
+			 ztest_1cpu_unit_test(test_event_wait_any),
+			 ztest_1cpu_unit_test(test_event_wait_all),
+			 ztest_1cpu_unit_test(test_event_wait_clear),
+			 ztest_user_unit_test(test_event_wait_timeout),
+			 ztest_1cpu_unit_test(test_event_set_isr)
+			 );
+	ztest_run_test_suite(event_api);
+}
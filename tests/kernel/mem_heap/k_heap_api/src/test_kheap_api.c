@@ -91,3 +91,63 @@ void test_k_heap_free(void)
 	}
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Test k_heap per-CPU caches
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details The test fills the heap with small blocks and frees them,
+ * which parks some of them in the current CPU's cache, then checks
+ * that the cache served a repeated allocation and that a large
+ * allocation needing the cached memory still succeeds.  A zero-size
+ * request must still fail rather than get a cached block.
+ *
+ * @see k_heap_alloc(), k_heap_free(), k_heap_cache_stats_get()
+ */
+void test_k_heap_cache(void)
+{
+#ifdef CONFIG_HEAP_CPU_CACHE
+	struct k_heap_cache_stats before, after;
+	void *blocks[HEAP_SIZE / 16];
+	int n = 0;
+	char *p;
+
+	k_heap_cache_stats_get(&k_heap_test, &before);
+
+	zassert_is_null(k_heap_alloc(&k_heap_test, 0, K_NO_WAIT),
+			"zero-size allocation served from the cache");
+
+	p = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_test, p);
+	zassert_equal(k_heap_alloc(&k_heap_test, 16, K_NO_WAIT), p,
+		      "freed block not reused from the cache");
+	k_heap_free(&k_heap_test, p);
+
+	k_heap_cache_stats_get(&k_heap_test, &after);
+	zassert_true(after.hits > before.hits, "no cache hit recorded");
+
+	while (n < ARRAY_SIZE(blocks)) {
+		blocks[n] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (blocks[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+	zassert_true(n > 0, "no small block allocated");
+
+	while (n > 0) {
+		k_heap_free(&k_heap_test, blocks[--n]);
+	}
+
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_1, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks not returned to the heap");
+	k_heap_free(&k_heap_test, p);
+
+	k_heap_cache_stats_get(&k_heap_test, &after);
+	zassert_true(after.flushes > before.flushes, "no flush recorded");
+#else
+	ztest_test_skip();
+#endif
+}
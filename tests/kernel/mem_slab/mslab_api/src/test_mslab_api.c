@@ -12,6 +12,10 @@ K_MEM_SLAB_DEFINE(kmslab, BLK_SIZE, BLK_NUM, BLK_ALIGN);
 static char __aligned(BLK_ALIGN) tslab[BLK_SIZE * BLK_NUM];
 static struct k_mem_slab mslab;
 
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
 void tmslab_alloc_free(void *data)
 {
 	struct k_mem_slab *pslab = (struct k_mem_slab *)data;
@@ -224,3 +228,112 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+static void tmslab_free_later(void *p1, void *p2, void *p3)
+{
+	struct k_mem_slab *pslab = p1;
+	void **block = p2;
+
+	ARG_UNUSED(p3);
+
+	k_msleep(TIMEOUT / 10);
+	/* One block at a time: the waiter must not wake for a partial set */
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(pslab, &block[i]);
+	}
+}
+
+/**
+ * @brief Verify bulk allocation and free of memory blocks
+ *
+ * @details Allocate all blocks of the slab with one call to
+ * k_mem_slab_alloc_bulk() and check they are distinct and accounted
+ * for, check that a request for more blocks than are free takes
+ * nothing, and that one larger than the slab is rejected.  Then
+ * release them all with k_mem_slab_free_bulk().
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_alloc_bulk(void)
+{
+	void *block[BLK_NUM], *extra;
+
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, BLK_NUM + 1,
+					    K_NO_WAIT), -EINVAL, NULL);
+
+	zassert_equal(k_mem_slab_alloc(&mslab, &extra, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, BLK_NUM,
+					    K_NO_WAIT), -ENOMEM, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 1, NULL);
+	k_mem_slab_free(&mslab, &extra);
+
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, BLK_NUM,
+					    K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), 0, NULL);
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_not_null(block[i], NULL);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(block[i], block[j], NULL);
+		}
+	}
+
+	k_mem_slab_free_bulk(&mslab, block, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+}
+
+/**
+ * @brief Verify blocking bulk allocation
+ *
+ * @details Allocate every block, let a helper thread free them one
+ * by one after a delay, and check that a blocking bulk allocation of
+ * all blocks waits for the last one and then succeeds.  A bulk
+ * allocation that can't be satisfied in time returns -EAGAIN.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_alloc_bulk_wait(void)
+{
+	void *held[BLK_NUM], *block[BLK_NUM];
+
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, held, BLK_NUM,
+					    K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, 1,
+					    K_MSEC(TIMEOUT / 10)), -EAGAIN,
+		      NULL);
+
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE,
+			tmslab_free_later, &mslab, held, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_mem_slab_alloc_bulk(&mslab, block, BLK_NUM,
+					    K_FOREVER), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), 0, NULL);
+
+	k_thread_join(&helper_thread, K_FOREVER);
+	k_mem_slab_free_bulk(&mslab, block, BLK_NUM);
+}
+
+/**
+ * @brief Verify high-water mark and failure counters
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_stats(void)
+{
+	void *block[BLK_NUM], *block_fail;
+	uint32_t failures = k_mem_slab_failures_get(&kmslab);
+
+	zassert_equal(k_mem_slab_alloc_bulk(&kmslab, block, BLK_NUM,
+					    K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc(&kmslab, &block_fail, K_NO_WAIT),
+		      -ENOMEM, NULL);
+	k_mem_slab_free_bulk(&kmslab, block, BLK_NUM);
+
+	if (IS_ENABLED(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)) {
+		zassert_equal(k_mem_slab_max_used_get(&kmslab), BLK_NUM, NULL);
+	}
+	if (IS_ENABLED(CONFIG_MEM_SLAB_TRACE_FAILURES)) {
+		zassert_equal(k_mem_slab_failures_get(&kmslab), failures + 1,
+			      NULL);
+	}
+}
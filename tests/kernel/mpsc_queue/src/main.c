@@ -0,0 +1,209 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_ITEMS 16
+#define NUM_PRODUCERS 3
+#define ITEMS_PER_PRODUCER 500
+#define TIMEOUT_MS 50
+
+struct item {
+	sys_mpsc_node_t node;
+	int producer;
+	int seq;
+};
+
+static struct item items[NUM_ITEMS];
+static struct item producer_items[NUM_PRODUCERS][ITEMS_PER_PRODUCER];
+
+static sys_mpsc_t mpsc = SYS_MPSC_STATIC_INIT(&mpsc);
+K_MPSC_QUEUE_DEFINE(kqueue);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS];
+
+static struct item *pop_item(void)
+{
+	sys_mpsc_node_t *node = sys_mpsc_pop(&mpsc);
+
+	return node == NULL ? NULL : CONTAINER_OF(node, struct item, node);
+}
+
+static struct item *get_item(k_timeout_t timeout)
+{
+	sys_mpsc_node_t *node = k_mpsc_queue_get(&kqueue, timeout);
+
+	return node == NULL ? NULL : CONTAINER_OF(node, struct item, node);
+}
+
+/**
+ * @brief Test sys_mpsc push/pop ordering
+ *
+ * @details Items come out in the order they were pushed, including
+ * when the queue is drained down to its last node (which requires
+ * recycling the stub node) and refilled repeatedly.
+ */
+void test_sys_mpsc_fifo(void)
+{
+	zassert_true(sys_mpsc_is_empty(&mpsc), NULL);
+	zassert_is_null(pop_item(), NULL);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		items[i].seq = i;
+		sys_mpsc_push(&mpsc, &items[i].node);
+	}
+	zassert_false(sys_mpsc_is_empty(&mpsc), NULL);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal_ptr(pop_item(), &items[i], NULL);
+	}
+	zassert_true(sys_mpsc_is_empty(&mpsc), NULL);
+	zassert_is_null(pop_item(), NULL);
+
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			sys_mpsc_push(&mpsc, &items[i].node);
+			zassert_equal_ptr(pop_item(), &items[i], NULL);
+			zassert_is_null(pop_item(), NULL);
+		}
+	}
+
+	sys_mpsc_push(&mpsc, &items[0].node);
+	sys_mpsc_push(&mpsc, &items[1].node);
+	zassert_equal_ptr(pop_item(), &items[0], NULL);
+	sys_mpsc_push(&mpsc, &items[2].node);
+	zassert_equal_ptr(pop_item(), &items[1], NULL);
+	zassert_equal_ptr(pop_item(), &items[2], NULL);
+	zassert_is_null(pop_item(), NULL);
+
+	sys_mpsc_init(&mpsc);
+	zassert_true(sys_mpsc_is_empty(&mpsc), NULL);
+}
+
+static void isr_put(const void *arg)
+{
+	k_mpsc_queue_put(&kqueue, (sys_mpsc_node_t *)arg);
+}
+
+/**
+ * @brief Test k_mpsc_queue_put() from an ISR and non-blocking get
+ */
+void test_mpsc_queue_isr_put(void)
+{
+	zassert_is_null(get_item(K_NO_WAIT), NULL);
+
+	irq_offload(isr_put, &items[0].node);
+	irq_offload(isr_put, &items[1].node);
+
+	zassert_equal_ptr(get_item(K_NO_WAIT), &items[0], NULL);
+	zassert_equal_ptr(get_item(K_NO_WAIT), &items[1], NULL);
+	zassert_is_null(get_item(K_NO_WAIT), NULL);
+}
+
+static void delayed_put(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	k_mpsc_queue_put(&kqueue, p1);
+}
+
+/**
+ * @brief Test a blocked consumer is woken by a put from a thread
+ */
+void test_mpsc_queue_get_wait(void)
+{
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, delayed_put,
+			&items[3].node, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal_ptr(get_item(K_FOREVER), &items[3], NULL);
+	zassert_equal(kqueue.waiting, 0, NULL);
+	k_thread_join(&threads[0], K_FOREVER);
+
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, delayed_put,
+			&items[4].node, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal_ptr(get_item(K_MSEC(TIMEOUT_MS * 10)), &items[4], NULL);
+	k_thread_join(&threads[0], K_FOREVER);
+}
+
+/**
+ * @brief Test k_mpsc_queue_get() timeout
+ */
+void test_mpsc_queue_get_timeout(void)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_is_null(get_item(K_MSEC(TIMEOUT_MS)), NULL);
+	zassert_true(k_uptime_get() - start >= TIMEOUT_MS, NULL);
+	zassert_equal(kqueue.waiting, 0, NULL);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+		producer_items[id][i].producer = id;
+		producer_items[id][i].seq = i;
+		k_mpsc_queue_put(&kqueue, &producer_items[id][i].node);
+		if ((i % 64) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test several producers racing against a blocking consumer
+ *
+ * @details Every item is received exactly once and the items of each
+ * producer arrive in the order that producer put them.
+ */
+void test_mpsc_queue_producers(void)
+{
+	int next_seq[NUM_PRODUCERS] = { 0 };
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	/* Drop below the producers so they interleave with us */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	for (int n = 0; n < NUM_PRODUCERS * ITEMS_PER_PRODUCER; n++) {
+		struct item *it = get_item(K_MSEC(1000));
+
+		zassert_not_null(it, "item %d never arrived", n);
+		zassert_equal(it->seq, next_seq[it->producer], NULL);
+		next_seq[it->producer]++;
+	}
+
+	zassert_is_null(get_item(K_NO_WAIT), NULL);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mpsc_queue,
+			 ztest_unit_test(test_sys_mpsc_fifo),
+			 ztest_unit_test(test_mpsc_queue_isr_put),
+			 ztest_unit_test(test_mpsc_queue_get_wait),
+			 ztest_unit_test(test_mpsc_queue_get_timeout),
+			 ztest_unit_test(test_mpsc_queue_producers)
+			 );
+	ztest_run_test_suite(mpsc_queue);
+}
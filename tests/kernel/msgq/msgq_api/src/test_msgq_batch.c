@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_QLEN 4
+#define BATCH_NUM 10
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_QLEN];
+static ZTEST_BMEM uint32_t tx[BATCH_NUM];
+static ZTEST_BMEM uint32_t rx[BATCH_NUM];
+static ZTEST_BMEM int peer_ret;
+
+static void batch_init(void)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_QLEN);
+
+	for (int i = 0; i < BATCH_NUM; i++) {
+		tx[i] = MSG0 + i;
+		rx[i] = 0;
+	}
+}
+
+static void batch_reader(void *p1, void *p2, void *p3)
+{
+	peer_ret = k_msgq_get_many(&msgq, rx, BATCH_NUM, POINTER_TO_UINT(p1),
+				   K_FOREVER);
+}
+
+static void batch_writer(void *p1, void *p2, void *p3)
+{
+	peer_ret = k_msgq_put_many(&msgq, tx, BATCH_NUM, K_FOREVER);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched put and get without waiting, across the buffer end
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_put_get_many(void)
+{
+	uint32_t one;
+
+	batch_init();
+
+	/* Offset the ring buffer pointers so the batches wrap */
+	zassert_equal(k_msgq_put(&msgq, &tx[0], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get(&msgq, &one, K_NO_WAIT), 0, NULL);
+
+	/* Only as many as fit are put */
+	zassert_equal(k_msgq_put_many(&msgq, tx, BATCH_NUM, K_NO_WAIT),
+		      BATCH_QLEN, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_QLEN, NULL);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_many(&msgq, tx, BATCH_NUM, TIMEOUT), 0,
+		      NULL);
+
+	zassert_equal(k_msgq_get_many(&msgq, rx, 3, 1, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_get_many(&msgq, &rx[3], BATCH_NUM - 3, 0,
+				      K_NO_WAIT), 1, NULL);
+	zassert_mem_equal(rx, tx, BATCH_QLEN * MSG_SIZE, NULL);
+
+	zassert_equal(k_msgq_get_many(&msgq, rx, BATCH_NUM, 0, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(k_msgq_get_many(&msgq, rx, 1, 1, TIMEOUT), 0, NULL);
+	zassert_equal(k_msgq_get_many(&msgq, rx, 1, 2, K_NO_WAIT), -EINVAL,
+		      NULL);
+}
+
+/**
+ * @brief Test that a batch reader is woken once its minimum has arrived
+ * @see k_msgq_put(), k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_get_many_min(void)
+{
+	batch_init();
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      batch_reader, UINT_TO_POINTER(6),
+				      NULL, NULL, K_PRIO_PREEMPT(0),
+				      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(10);
+
+	/* Messages go straight to the reader, which stays pended */
+	zassert_equal(k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_put(&msgq, &tx[3], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+	zassert_true((tdata.base.thread_state & _THREAD_PENDING) != 0U,
+		     "reader woken before its minimum");
+
+	/* Minimum met: the reader takes up to its maximum, the rest queue */
+	zassert_equal(k_msgq_put_many(&msgq, &tx[4], 6, K_NO_WAIT), 6, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_ret, BATCH_NUM, NULL);
+	zassert_mem_equal(rx, tx, sizeof(tx), NULL);
+}
+
+/**
+ * @brief Test batched transfers larger than the queue with a pended writer
+ * @see k_msgq_put_many(), k_msgq_get_many(), k_msgq_get()
+ */
+void test_msgq_put_many_pend(void)
+{
+	batch_init();
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      batch_writer, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0),
+				      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(10);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_QLEN, NULL);
+
+	/* A single get refills the queue from the writer */
+	zassert_equal(k_msgq_get(&msgq, &rx[0], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_QLEN, NULL);
+
+	/* A batch get drains the writer through the ring buffer */
+	zassert_equal(k_msgq_get_many(&msgq, &rx[1], BATCH_NUM - 1,
+				      BATCH_NUM - 1, K_NO_WAIT),
+		      BATCH_NUM - 1, NULL);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_ret, BATCH_NUM, NULL);
+	zassert_mem_equal(rx, tx, sizeof(tx), NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
+
+/**
+ * @brief Test that a purge keeps messages already transferred by a batch
+ * @see k_msgq_put_many(), k_msgq_get_many(), k_msgq_purge()
+ */
+void test_msgq_many_purge(void)
+{
+	k_tid_t tid;
+
+	batch_init();
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, batch_writer,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+			      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(10);
+	zassert_equal(k_msgq_get_many(&msgq, rx, 2, 2, K_NO_WAIT), 2, NULL);
+	k_msgq_purge(&msgq);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_ret, BATCH_QLEN + 2, NULL);
+
+	batch_init();
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, batch_reader,
+			      UINT_TO_POINTER(6), NULL, NULL,
+			      K_PRIO_PREEMPT(0),
+			      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(10);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT), 3, NULL);
+	k_msgq_purge(&msgq);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_ret, 3, NULL);
+	zassert_mem_equal(rx, tx, 3 * MSG_SIZE, NULL);
+
+	/* Nothing transferred yet: the purge still fails the call */
+	batch_init();
+	zassert_equal(k_msgq_put_many(&msgq, tx, BATCH_QLEN, K_NO_WAIT),
+		      BATCH_QLEN, NULL);
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, batch_writer,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+			      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(10);
+	k_msgq_purge(&msgq);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_ret, -ENOMSG, NULL);
+}
+
+/**
+ * @}
+ */
@@ -38,6 +38,12 @@ extern void test_pipe_avail_r_eq_w_full(void);
 extern void test_pipe_avail_r_eq_w_empty(void);
 extern void test_pipe_avail_no_buffer(void);
 
+extern void test_pipe_claim_put_get(void);
+extern void test_pipe_claim_exclusive(void);
+extern void test_pipe_claim_wake_reader(void);
+extern void test_pipe_claim_feed_writer(void);
+extern void test_pipe_iov(void);
+
 /* k objects */
 extern struct k_pipe pipe, kpipe, khalfpipe, put_get_pipe;
 extern struct k_sem end_sema;
@@ -88,6 +94,11 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_avail_w_lt_r),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_full),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_empty),
-			 ztest_unit_test(test_pipe_avail_no_buffer));
+			 ztest_unit_test(test_pipe_avail_no_buffer),
+			 ztest_unit_test(test_pipe_claim_put_get),
+			 ztest_unit_test(test_pipe_claim_exclusive),
+			 ztest_1cpu_unit_test(test_pipe_claim_wake_reader),
+			 ztest_1cpu_unit_test(test_pipe_claim_feed_writer),
+			 ztest_unit_test(test_pipe_iov));
 	ztest_run_test_suite(pipe_api);
 }
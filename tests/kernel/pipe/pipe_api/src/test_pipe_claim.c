@@ -0,0 +1,271 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe claim/finish and iovec APIs
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define CLAIM_BUF_SIZE 8
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_BUF_SIZE, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_tdata;
+
+static uint8_t peer_buf[CLAIM_BUF_SIZE];
+static size_t peer_xferred;
+static int peer_rc;
+
+static void pipe_drain(void)
+{
+	uint8_t tmp[CLAIM_BUF_SIZE];
+	size_t rd;
+
+	(void)k_pipe_get(&claim_pipe, tmp, sizeof(tmp), &rd, 0, K_NO_WAIT);
+}
+
+static void claim_put(const char *str, size_t len)
+{
+	uint8_t *data;
+	size_t done = 0;
+
+	while (done < len) {
+		size_t n = k_pipe_put_claim(&claim_pipe, &data, len - done);
+
+		zassert_true(n > 0, "no space claimed");
+		memcpy(data, str + done, n);
+		zassert_equal(k_pipe_put_finish(&claim_pipe, n), 0, NULL);
+		done += n;
+	}
+}
+
+/**
+ * @brief Test in place writes and reads, including across the buffer end
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_put_get(void)
+{
+	uint8_t *data;
+	uint8_t rx[CLAIM_BUF_SIZE];
+	size_t n, rd;
+
+	pipe_drain();
+
+	/* Move the indices to the middle of the buffer */
+	claim_put("abcde", 5);
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 5, &rd, 5, K_NO_WAIT), 0,
+		      NULL);
+	zassert_mem_equal(rx, "abcde", 5, NULL);
+
+	/* Only the run up to the end of the buffer can be claimed */
+	n = k_pipe_put_claim(&claim_pipe, &data, CLAIM_BUF_SIZE);
+	zassert_equal(n, CLAIM_BUF_SIZE - 5, NULL);
+	memcpy(data, "123", n);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, n), 0, NULL);
+
+	n = k_pipe_put_claim(&claim_pipe, &data, CLAIM_BUF_SIZE);
+	zassert_equal(n, 5, NULL);
+	memcpy(data, "45", 2);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 2), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5, NULL);
+
+	n = k_pipe_get_claim(&claim_pipe, &data, CLAIM_BUF_SIZE);
+	zassert_equal(n, 3, NULL);
+	zassert_mem_equal(data, "123", 3, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, n), 0, NULL);
+
+	n = k_pipe_get_claim(&claim_pipe, &data, CLAIM_BUF_SIZE);
+	zassert_equal(n, 2, NULL);
+	zassert_mem_equal(data, "45", 2, NULL);
+
+	/* Releasing part of a claim leaves the rest in the pipe */
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 1), 0, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 1, &rd, 1, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(rx[0], '5', NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+}
+
+/**
+ * @brief Test that only one claim per direction can be outstanding
+ *
+ * @details While a claim is outstanding, k_pipe_put() or k_pipe_get()
+ * in the same direction fails with -EBUSY.
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_exclusive(void)
+{
+	uint8_t rx[2];
+	uint8_t *data;
+	size_t xferred;
+	size_t n;
+
+	pipe_drain();
+
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL, NULL);
+
+	/* Nothing to read: no claim is taken */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 1), 0, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL, NULL);
+
+	n = k_pipe_put_claim(&claim_pipe, &data, 2);
+	zassert_equal(n, 2, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 2), 0, NULL);
+	zassert_equal(k_pipe_put(&claim_pipe, "ab", 2, &xferred, 0,
+				 K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(xferred, 0, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, CLAIM_BUF_SIZE + 1),
+		      -EINVAL, NULL);
+	memcpy(data, "xy", 2);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 2), 0, NULL);
+
+	n = k_pipe_get_claim(&claim_pipe, &data, CLAIM_BUF_SIZE);
+	zassert_equal(n, 2, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 1), 0, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 1, &xferred, 0, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(xferred, 0, NULL);
+
+	/* Abandoning a claim keeps the data */
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+
+	pipe_drain();
+}
+
+static void tpipe_reader(void *p1, void *p2, void *p3)
+{
+	peer_rc = k_pipe_get(&claim_pipe, peer_buf, 4, &peer_xferred, 4,
+			     K_FOREVER);
+}
+
+static void tpipe_writer(void *p1, void *p2, void *p3)
+{
+	peer_rc = k_pipe_put(&claim_pipe, (void *)"WXYZ", 4, &peer_xferred, 4,
+			     K_FOREVER);
+}
+
+/**
+ * @brief Test that finishing a put claim wakes a pended reader
+ *
+ * @see k_pipe_put_finish()
+ */
+void test_pipe_claim_wake_reader(void)
+{
+	pipe_drain();
+
+	k_tid_t tid = k_thread_create(&claim_tdata, claim_stack, STACK_SIZE,
+				      tpipe_reader, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader pend on the empty pipe */
+	k_msleep(10);
+
+	claim_put("ab", 2);
+	zassert_equal(claim_tdata.base.thread_state & _THREAD_PENDING,
+		      _THREAD_PENDING, "short write woke reader");
+	claim_put("cdef", 4);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_rc, 0, NULL);
+	zassert_equal(peer_xferred, 4, NULL);
+	zassert_mem_equal(peer_buf, "abcd", 4, NULL);
+
+	/* What the reader did not ask for stays buffered */
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+	pipe_drain();
+}
+
+/**
+ * @brief Test that finishing a get claim takes data from a pended writer
+ *
+ * @see k_pipe_get_finish()
+ */
+void test_pipe_claim_feed_writer(void)
+{
+	uint8_t *data;
+	uint8_t rx[CLAIM_BUF_SIZE];
+	size_t n, rd;
+
+	pipe_drain();
+	claim_put("01234567", CLAIM_BUF_SIZE);
+
+	k_tid_t tid = k_thread_create(&claim_tdata, claim_stack, STACK_SIZE,
+				      tpipe_writer, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the writer pend on the full pipe */
+	k_msleep(10);
+
+	n = k_pipe_get_claim(&claim_pipe, &data, 4);
+	zassert_equal(n, 4, NULL);
+	zassert_mem_equal(data, "0123", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, n), 0, NULL);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(peer_rc, 0, NULL);
+	zassert_equal(peer_xferred, 4, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx, sizeof(rx), &rd,
+				 sizeof(rx), K_NO_WAIT), 0, NULL);
+	zassert_mem_equal(rx, "4567WXYZ", sizeof(rx), NULL);
+}
+
+/**
+ * @brief Test scatter-gather writes and reads
+ *
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+void test_pipe_iov(void)
+{
+	char hdr[] = "hd", body[] = "body", tail[] = "tail";
+	char a[3] = { 0 }, b[5] = { 0 };
+	const struct k_pipe_iovec tx[] = {
+		{ hdr, 2 }, { body, 4 }, { tail, 4 },
+	};
+	const struct k_pipe_iovec rx[] = {
+		{ a, 3 }, { b, 5 },
+	};
+	size_t n;
+
+	pipe_drain();
+
+	zassert_equal(k_pipe_put_iov(&claim_pipe, tx, ARRAY_SIZE(tx), NULL,
+				     0, K_NO_WAIT), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_iov(&claim_pipe, tx, ARRAY_SIZE(tx), &n,
+				     11, K_NO_WAIT), -EINVAL, NULL);
+
+	/* Only 8 of the 10 bytes fit */
+	zassert_equal(k_pipe_put_iov(&claim_pipe, tx, ARRAY_SIZE(tx), &n,
+				     6, K_NO_WAIT), 0, NULL);
+	zassert_equal(n, CLAIM_BUF_SIZE, NULL);
+	zassert_equal(k_pipe_put_iov(&claim_pipe, tx, ARRAY_SIZE(tx), &n,
+				     1, K_NO_WAIT), -EIO, NULL);
+	zassert_equal(n, 0, NULL);
+
+	zassert_equal(k_pipe_get_iov(&claim_pipe, rx, ARRAY_SIZE(rx), &n,
+				     CLAIM_BUF_SIZE, K_NO_WAIT), 0, NULL);
+	zassert_equal(n, CLAIM_BUF_SIZE, NULL);
+	zassert_mem_equal(a, "hdb", 3, NULL);
+	zassert_mem_equal(b, "odyta", 5, NULL);
+
+	zassert_equal(k_pipe_get_iov(&claim_pipe, rx, ARRAY_SIZE(rx), &n,
+				     1, K_MSEC(10)), -EAGAIN, NULL);
+	zassert_equal(n, 0, NULL);
+}
+
+/**
+ * @}
+ */
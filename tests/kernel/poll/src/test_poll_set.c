@@ -0,0 +1,333 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define NUM_SEMS 64
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_poll_set set;
+static struct k_sem sems[NUM_SEMS];
+static struct k_poll_event sem_events[NUM_SEMS];
+static struct k_poll_event *ready[NUM_SEMS];
+
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_thread set_thread;
+
+static void set_setup(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		zassert_equal(k_poll_set_add(&set, &sem_events[i]), 0, NULL);
+	}
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &sem_events[i]), 0,
+			      NULL);
+	}
+}
+
+/**
+ * @brief Test level triggered readiness of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_level(void)
+{
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	/* Reported for as long as the semaphore is available */
+	k_sem_give(&sems[5]);
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS,
+					      K_NO_WAIT), 1, NULL);
+		zassert_equal_ptr(ready[0], &sem_events[5], NULL);
+		zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE,
+			      NULL);
+	}
+
+	zassert_equal(k_sem_take(&sems[5], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	zassert_equal(sem_events[5].state, K_POLL_STATE_NOT_READY, NULL);
+
+	/* Registered again after becoming unavailable */
+	k_sem_give(&sems[5]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 1,
+		      NULL);
+	k_sem_reset(&sems[5]);
+
+	/* Already available when added */
+	zassert_equal(k_poll_set_remove(&set, &sem_events[7]), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &sem_events[7]), -EINVAL, NULL);
+	k_sem_give(&sems[7]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	zassert_equal(k_poll_set_add(&set, &sem_events[7]), 0, NULL);
+	zassert_equal(k_poll_set_add(&set, &sem_events[7]), -EBUSY, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal_ptr(ready[0], &sem_events[7], NULL);
+	k_sem_reset(&sems[7]);
+
+	set_teardown();
+}
+
+/**
+ * @brief Test that ready events are returned in turn
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_round_robin(void)
+{
+	int seen[NUM_SEMS] = { 0 };
+
+	set_setup();
+
+	for (int i = 0; i < NUM_SEMS; i += 2) {
+		k_sem_give(&sems[i]);
+	}
+
+	/* Two waits of half the ready events return each one once */
+	for (int n = 0; n < 2; n++) {
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS / 4,
+					      K_NO_WAIT), NUM_SEMS / 4, NULL);
+		for (int i = 0; i < NUM_SEMS / 4; i++) {
+			seen[ready[i] - sem_events]++;
+		}
+	}
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_equal(seen[i], (i % 2) == 0 ? 1 : 0, "event %d", i);
+		k_sem_reset(&sems[i]);
+	}
+
+	set_teardown();
+}
+
+static void give_entry(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+	k_sem_give(p1);
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_wait(void)
+{
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_MSEC(10)),
+		      -EAGAIN, NULL);
+
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, give_entry,
+			&sems[NUM_SEMS - 1], NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_FOREVER), 1,
+		      NULL);
+	zassert_equal_ptr(ready[0], &sem_events[NUM_SEMS - 1], NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	/* A thread calling k_sem_take() has precedence */
+	zassert_equal(k_sem_take(&sems[NUM_SEMS - 1], K_NO_WAIT), 0, NULL);
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, give_entry,
+			&sems[NUM_SEMS - 1], NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&sems[NUM_SEMS - 1], K_MSEC(100)), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	set_teardown();
+}
+
+/**
+ * @brief Test cancellation of a queue in a poll set
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_cancel(void)
+{
+	static struct k_fifo fifo;
+	struct k_poll_event event;
+
+	k_poll_set_init(&set);
+	k_fifo_init(&fifo);
+	k_poll_event_init(&event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &fifo);
+	zassert_equal(k_poll_set_add(&set, &event), 0, NULL);
+
+	k_fifo_cancel_wait(&fifo);
+
+	/* Reported once */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_CANCELLED, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN,
+		      NULL);
+
+	zassert_equal(k_poll_set_remove(&set, &event), 0, NULL);
+}
+
+#define STRESS_THREADS 2
+#define STRESS_GIVES 2000
+#define STRESS_TIMER_GIVES 200
+#define STRESS_CHURN 1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(stress_stacks, STRESS_THREADS + 1,
+				   STACK_SIZE);
+static struct k_thread stress_threads[STRESS_THREADS + 1];
+static struct k_timer stress_timer;
+static int timer_gives;
+
+static void stress_give_entry(void *p1, void *p2, void *p3)
+{
+	int first = POINTER_TO_INT(p1);
+
+	for (int i = 0; i < STRESS_GIVES; i++) {
+		k_sem_give(&sems[first + i % (NUM_SEMS / 2)]);
+		if ((i % 16) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void stress_churn_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < STRESS_CHURN; i++) {
+		struct k_poll_event *event = &sem_events[i % NUM_SEMS];
+
+		zassert_equal(k_poll_set_remove(&set, event), 0, NULL);
+		k_yield();
+		zassert_equal(k_poll_set_add(&set, event), 0, NULL);
+	}
+}
+
+static void stress_timer_expiry(struct k_timer *timer)
+{
+	k_sem_give(&sems[timer_gives % NUM_SEMS]);
+
+	if (++timer_gives == STRESS_TIMER_GIVES) {
+		k_timer_stop(timer);
+	}
+}
+
+/**
+ * @brief Stress a poll set with concurrent signals and changes
+ *
+ * @details Semaphores in the set are given from threads, which run on
+ * other CPUs on SMP targets, and from a timer, while another thread keeps
+ * removing and adding events. Every give must be seen by the waiter.
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_stress(void)
+{
+	int total = STRESS_THREADS * STRESS_GIVES + STRESS_TIMER_GIVES;
+	int taken = 0;
+	int n;
+
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&sems[i], 0, UINT_MAX);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		zassert_equal(k_poll_set_add(&set, &sem_events[i]), 0, NULL);
+	}
+
+	timer_gives = 0;
+	k_timer_init(&stress_timer, stress_timer_expiry, NULL);
+	k_timer_start(&stress_timer, K_MSEC(1), K_MSEC(1));
+
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		k_thread_create(&stress_threads[i], stress_stacks[i],
+				STACK_SIZE, stress_give_entry,
+				INT_TO_POINTER(i * NUM_SEMS / 2), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&stress_threads[STRESS_THREADS],
+			stress_stacks[STRESS_THREADS], STACK_SIZE,
+			stress_churn_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	while (taken < total) {
+		n = k_poll_set_wait(&set, ready, NUM_SEMS, K_MSEC(1000));
+		zassert_true(n > 0, "wakeup lost, %d of %d taken", taken,
+			     total);
+
+		for (int i = 0; i < n; i++) {
+			while (k_sem_take(ready[i]->sem, K_NO_WAIT) == 0) {
+				taken++;
+			}
+		}
+	}
+
+	zassert_equal(taken, total, NULL);
+
+	for (int i = 0; i <= STRESS_THREADS; i++) {
+		k_thread_join(&stress_threads[i], K_FOREVER);
+	}
+
+	set_teardown();
+}
+
+#define RACE_LOOPS 10000
+
+static void race_give_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < RACE_LOOPS; i++) {
+		k_sem_give(&sems[0]);
+		(void)k_sem_take(&sems[0], K_NO_WAIT);
+	}
+}
+
+static void race_remove_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < RACE_LOOPS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &sem_events[0]), 0,
+			      NULL);
+		zassert_equal(k_poll_set_add(&set, &sem_events[0]), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test removing an event while its object signals it
+ *
+ * @details On SMP targets the two threads run on different CPUs, so
+ * the semaphore signals the set while the event is being removed from
+ * it and its poller cleared.
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_set_remove_race(void)
+{
+	set_setup();
+
+	k_thread_create(&stress_threads[0], stress_stacks[0], STACK_SIZE,
+			race_give_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_create(&stress_threads[1], stress_stacks[1], STACK_SIZE,
+			race_remove_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	k_thread_join(&stress_threads[0], K_FOREVER);
+	k_thread_join(&stress_threads[1], K_FOREVER);
+
+	set_teardown();
+}
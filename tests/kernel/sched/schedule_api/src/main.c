@@ -50,6 +50,7 @@ void test_main(void)
 			 ztest_unit_test(test_priority_cooperative),
 			 ztest_unit_test(test_priority_preemptible),
 			 ztest_1cpu_unit_test(test_priority_preemptible_wait_prio),
+			 ztest_1cpu_unit_test(test_priority_set_pended_thread),
 			 ztest_unit_test(test_yield_cooperative),
 			 ztest_unit_test(test_sleep_cooperative),
 			 ztest_unit_test(test_sleep_wakeup_preemptible),
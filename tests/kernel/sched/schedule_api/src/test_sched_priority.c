@@ -171,6 +171,64 @@ void test_priority_preemptible_wait_prio(void)
 	k_thread_priority_set(k_current_get(), old_prio);
 }
 
+static int wake_order[2];
+static int wake_count;
+
+static void thread_entry_pend(void *p1, void *p2, void *p3)
+{
+	k_sem_take(&sync_sema, K_FOREVER);
+
+	wake_order[wake_count++] = POINTER_TO_INT(p1);
+}
+
+/**
+ * @brief Validate the priority change of a pended thread
+ *
+ * @details Pend two threads on a semaphore, then raise the priority
+ * of the lower priority one above the other. Make sure that the
+ * semaphore wakes the threads in the order of their new priorities.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_priority_set_pended_thread(void)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	k_tid_t tid[2];
+
+	k_sem_init(&sync_sema, 0, 2);
+	wake_count = 0;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(3));
+
+	tid[0] = k_thread_create(&tdata_prio[0], tstacks[0], STACK_SIZE,
+			thread_entry_pend, INT_TO_POINTER(0), NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	tid[1] = k_thread_create(&tdata_prio[1], tstacks[1], STACK_SIZE,
+			thread_entry_pend, INT_TO_POINTER(1), NULL, NULL,
+			K_PRIO_PREEMPT(2), 0, K_NO_WAIT);
+
+	/* both threads run and pend on the semaphore */
+	k_sleep(K_MSEC(10));
+
+	k_thread_priority_set(tid[1], K_PRIO_PREEMPT(0));
+
+	k_sem_give(&sync_sema);
+	zassert_equal(wake_count, 1, "no thread woken");
+	zassert_equal(wake_order[0], 1, "thread woken at its old priority");
+
+	k_sem_give(&sync_sema);
+	zassert_equal(wake_count, 2, "second thread not woken");
+	zassert_equal(wake_order[1], 0, "wrong thread woken");
+
+	/* test case tear down */
+	for (int i = 0; i < 2; i++) {
+		k_thread_abort(tid[i]);
+	}
+
+	/* restore environment */
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+
 extern void idle(void *p1, void *p2, void *p3);
 
 /**
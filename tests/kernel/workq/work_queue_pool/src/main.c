@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Workqueues with several worker threads
+ *
+ * Work handlers in these tests block on a gate semaphore, so a work item
+ * only makes progress if it has a worker thread to itself.
+ */
+
+#include <ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(extra_stacks, NUM_WORKERS - 1, STACK_SIZE);
+static struct k_thread extra_threads[NUM_WORKERS - 1];
+static struct k_work_q pool;
+
+static struct k_work work[NUM_WORKERS];
+static struct k_delayed_work delayed;
+
+static K_SEM_DEFINE(gate, 0, NUM_WORKERS);
+static K_SEM_DEFINE(done, 0, NUM_WORKERS + 1);
+static atomic_t entered;
+static k_tid_t entered_by[NUM_WORKERS];
+
+static void blocking_handler(struct k_work *item)
+{
+	entered_by[atomic_inc(&entered)] = k_current_get();
+	k_sem_take(&gate, K_FOREVER);
+	k_sem_give(&done);
+}
+
+static void quick_handler(struct k_work *item)
+{
+	k_sem_give(&done);
+}
+
+static void block_workers(struct k_work_q *work_q, int num)
+{
+	atomic_clear(&entered);
+
+	for (int i = 0; i < num; i++) {
+		k_work_init(&work[i], blocking_handler);
+		k_work_submit_to_queue(work_q, &work[i]);
+	}
+
+	k_msleep(10);
+}
+
+static void release_workers(int num)
+{
+	for (int i = 0; i < num; i++) {
+		k_sem_give(&gate);
+	}
+
+	for (int i = 0; i < num; i++) {
+		zassert_equal(k_sem_take(&done, K_MSEC(100)), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test that blocked handlers don't hold up other workers
+ *
+ * @see k_work_q_add_worker(), k_work_q_stats_get()
+ */
+static void test_workq_pool_parallel(void)
+{
+	struct k_work_q_stats stats;
+
+	block_workers(&pool, NUM_WORKERS);
+	zassert_equal(atomic_get(&entered), NUM_WORKERS,
+		      "handlers not running in parallel");
+
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.workers, NUM_WORKERS, NULL);
+	zassert_equal(stats.busy, NUM_WORKERS, NULL);
+	zassert_equal(stats.queued, 0, NULL);
+
+	release_workers(NUM_WORKERS);
+	k_msleep(1);
+
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.submitted, NUM_WORKERS, NULL);
+	zassert_equal(stats.completed, NUM_WORKERS, NULL);
+	zassert_equal(stats.busy, 0, NULL);
+	zassert_equal(stats.busy_max, NUM_WORKERS, NULL);
+}
+
+/**
+ * @brief Test queue occupancy and latency statistics
+ *
+ * @see k_work_q_stats_get(), k_work_q_stats_reset()
+ */
+static void test_workq_pool_stats(void)
+{
+	struct k_work_q_stats stats;
+	struct k_work quick;
+
+	k_work_q_stats_reset(&pool);
+	block_workers(&pool, NUM_WORKERS);
+
+	/* With every worker busy the next item waits in the queue */
+	k_work_init(&quick, quick_handler);
+	k_work_submit_to_queue(&pool, &quick);
+	k_msleep(20);
+
+	/* The blocking items were all queued before any worker ran */
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.queued, 1, NULL);
+	zassert_equal(stats.queued_max, NUM_WORKERS, NULL);
+
+	release_workers(NUM_WORKERS);
+	zassert_equal(k_sem_take(&done, K_MSEC(100)), 0, NULL);
+	k_msleep(1);
+
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.submitted, NUM_WORKERS + 1, NULL);
+	zassert_equal(stats.completed, NUM_WORKERS + 1, NULL);
+	zassert_equal(stats.queued, 0, NULL);
+	zassert_true(stats.latency_max >= k_ms_to_cyc_floor32(10),
+		     "latency %u too short", stats.latency_max);
+	zassert_true(stats.latency_total >= stats.latency_max, NULL);
+
+	k_work_q_stats_reset(&pool);
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.submitted, 0, NULL);
+	zassert_equal(stats.latency_max, 0, NULL);
+	zassert_equal(stats.workers, NUM_WORKERS, NULL);
+}
+
+/**
+ * @brief Test cancelling delayed work queued behind busy workers
+ *
+ * @see k_delayed_work_submit_to_queue(), k_delayed_work_cancel()
+ */
+static void test_workq_pool_delayed_cancel(void)
+{
+	struct k_work_q_stats stats;
+
+	k_delayed_work_init(&delayed, quick_handler);
+	block_workers(&pool, NUM_WORKERS);
+
+	zassert_equal(k_delayed_work_submit_to_queue(&pool, &delayed,
+						     K_NO_WAIT), 0, NULL);
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.queued, 1, NULL);
+
+	zassert_equal(k_delayed_work_cancel(&delayed), 0, NULL);
+	k_work_q_stats_get(&pool, &stats);
+	zassert_equal(stats.queued, 0, NULL);
+
+	release_workers(NUM_WORKERS);
+	zassert_equal(k_sem_take(&done, K_MSEC(20)), -EAGAIN,
+		      "cancelled work ran");
+
+	/* Delayed work still runs normally */
+	zassert_equal(k_delayed_work_submit_to_queue(&pool, &delayed,
+						     K_MSEC(10)), 0, NULL);
+	zassert_equal(k_sem_take(&done, K_MSEC(100)), 0, NULL);
+}
+
+/**
+ * @brief Test the system workqueue with several threads
+ *
+ * @see CONFIG_SYSTEM_WORKQUEUE_THREADS
+ */
+static void test_sys_workq_threads(void)
+{
+	if (CONFIG_SYSTEM_WORKQUEUE_THREADS < 2) {
+		ztest_test_skip();
+	}
+
+	block_workers(&k_sys_work_q, 2);
+	zassert_equal(atomic_get(&entered), 2,
+		      "system workqueue handlers not running in parallel");
+
+	if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+		zassert_true(strcmp(k_thread_name_get(entered_by[0]),
+				    k_thread_name_get(entered_by[1])) != 0,
+			     "workers share the name %s",
+			     k_thread_name_get(entered_by[0]));
+	}
+
+	release_workers(2);
+}
+
+void test_main(void)
+{
+	k_work_q_start(&pool, pool_stack, K_THREAD_STACK_SIZEOF(pool_stack),
+		       WORKER_PRIO);
+	for (int i = 0; i < NUM_WORKERS - 1; i++) {
+		k_work_q_add_worker(&pool, &extra_threads[i], extra_stacks[i],
+				    K_THREAD_STACK_SIZEOF(extra_stacks[i]),
+				    WORKER_PRIO);
+	}
+
+	ztest_test_suite(workqueue_pool,
+			 ztest_unit_test(test_workq_pool_parallel),
+			 ztest_unit_test(test_workq_pool_stats),
+			 ztest_unit_test(test_workq_pool_delayed_cancel),
+			 ztest_unit_test(test_sys_workq_threads));
+	ztest_run_test_suite(workqueue_pool);
+}
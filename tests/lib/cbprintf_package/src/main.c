@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/cbprintf.h>
+
+#include "package_cxx.h"
+
+static char out[128];
+static size_t out_len;
+
+static int out_func(int c, void *ctx)
+{
+	if (out_len < sizeof(out) - 1) {
+		out[out_len++] = (char)c;
+		out[out_len] = '\0';
+	}
+
+	return c;
+}
+
+static void check_output(const void *pkg, const char *exp)
+{
+	int rc;
+
+	out_len = 0;
+	out[0] = '\0';
+
+	rc = cbpprintf(out_func, NULL, pkg);
+	/* The nano implementation only counts with the libc substitutes */
+	if (!IS_ENABLED(CONFIG_CBPRINTF_NANO)) {
+		zassert_equal(rc, strlen(exp), "Unexpected length %d", rc);
+	}
+	zassert_equal(strcmp(out, exp), 0, "Got \"%s\", expected \"%s\"",
+		      out, exp);
+}
+
+/**
+ * @brief Test packaging integer and pointer arguments
+ */
+static void test_cbprintf_package_integers(void)
+{
+	uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%d %u %ld %lld %x %c %hd %p",
+						 -1, 2U, -3L, 4LL, 0xabU, 'z',
+						 (short)-5, (void *)0x1234)]
+		__aligned(sizeof(uint32_t));
+	char c = 'z';
+	short s = -5;
+
+	CBPRINTF_STATIC_PACKAGE(pkg, "%d %u %ld %lld %x %c %hd %p",
+				-1, 2U, -3L, 4LL, 0xabU, c, s, (void *)0x1234);
+	check_output(pkg, "-1 2 -3 4 ab z -5 0x1234");
+
+	/* No strings, copying does not change the package */
+	zassert_equal(cbprintf_package_copy(pkg, NULL, 0), sizeof(pkg), NULL);
+}
+
+/**
+ * @brief Test 64-bit values are not truncated
+ */
+static void test_cbprintf_package_64bit(void)
+{
+	uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%llx %d", 0ULL, 0)]
+		__aligned(sizeof(uint32_t));
+
+	CBPRINTF_STATIC_PACKAGE(pkg, "%llx %d", 0x123456789abcdef0ULL, 7);
+	check_output(pkg, "123456789abcdef0 7");
+}
+
+/**
+ * @brief Test packaging floating point arguments
+ */
+static void test_cbprintf_package_fp(void)
+{
+	if (!IS_ENABLED(CONFIG_CBPRINTF_FP_SUPPORT)) {
+		ztest_test_skip();
+	}
+
+	uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%.1f %.2f %d",
+						 1.0f, 1.0, 1)]
+		__aligned(sizeof(uint32_t));
+	float f = 1.5f;
+
+	CBPRINTF_STATIC_PACKAGE(pkg, "%.1f %.2f %d", f, -0.25, 3);
+	check_output(pkg, "1.5 -0.25 3");
+}
+
+/**
+ * @brief Test transient strings are appended by the copy
+ */
+static void test_cbprintf_package_strings(void)
+{
+	char buf[8] = "abc";
+	uint8_t pkg[CBPRINTF_STATIC_PACKAGE_SIZE("%s %d %s", buf, 1, "")]
+		__aligned(sizeof(uint32_t));
+	uint8_t copy[64] __aligned(sizeof(uint32_t));
+	uint8_t moved[64] __aligned(sizeof(uint32_t));
+	int len;
+
+	CBPRINTF_STATIC_PACKAGE(pkg, "%s %d %s", buf, 1, "def");
+	check_output(pkg, "abc 1 def");
+
+	len = cbprintf_package_copy(pkg, NULL, 0);
+	zassert_true(len > (int)sizeof(pkg), "Strings not copied");
+	zassert_equal(cbprintf_package_copy(pkg, copy, len - 1), -ENOSPC,
+		      NULL);
+	zassert_equal(cbprintf_package_copy(pkg, copy, sizeof(copy)), len,
+		      NULL);
+
+	/* The copy is independent of the source string ... */
+	strcpy(buf, "xyz");
+	check_output(pkg, "xyz 1 def");
+	check_output(copy, "abc 1 def");
+
+	/* ... and can be relocated, or copied again unchanged */
+	memcpy(moved, copy, len);
+	memset(copy, 0, sizeof(copy));
+	check_output(moved, "abc 1 def");
+	zassert_equal(cbprintf_package_copy(moved, copy, sizeof(copy)), len,
+		      NULL);
+	check_output(copy, "abc 1 def");
+}
+
+/**
+ * @brief Test a package built at runtime matches the static one
+ */
+static void test_cbprintf_package_runtime(void)
+{
+	uint8_t spkg[CBPRINTF_STATIC_PACKAGE_SIZE(
+		"%d %u %lld %x %ld %zu %c %p %%",
+		-1, 2U, 4LL, 0xabU, -3L, (size_t)5, 'z', (void *)0x1234)]
+		__aligned(sizeof(uint32_t));
+	uint8_t pkg[64] __aligned(sizeof(uint32_t));
+	int len;
+
+	CBPRINTF_STATIC_PACKAGE(spkg, "%d %u %lld %x %ld %zu %c %p %%",
+				-1, 2U, 4LL, 0xabU, -3L, (size_t)5, 'z',
+				(void *)0x1234);
+
+	len = cbprintf_package(NULL, 0, "%d %u %lld %x %ld %zu %c %p %%",
+			       -1, 2U, 4LL, 0xabU, -3L, (size_t)5, 'z',
+			       (void *)0x1234);
+	zassert_equal(len, sizeof(spkg), "Unexpected length %d", len);
+
+	zassert_equal(cbprintf_package(pkg, len - 1,
+				       "%d %u %lld %x %ld %zu %c %p %%",
+				       -1, 2U, 4LL, 0xabU, -3L, (size_t)5, 'z',
+				       (void *)0x1234),
+		      -ENOSPC, NULL);
+	zassert_equal(cbprintf_package(pkg, len,
+				       "%d %u %lld %x %ld %zu %c %p %%",
+				       -1, 2U, 4LL, 0xabU, -3L, (size_t)5, 'z',
+				       (void *)0x1234),
+		      len, NULL);
+	zassert_mem_equal(pkg, spkg, len, "Packages differ");
+	check_output(pkg, "-1 2 4 ab -3 5 z 0x1234 %");
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_FP_SUPPORT)) {
+		zassert_true(cbprintf_package(pkg, sizeof(pkg), "%.2f %d",
+					      -0.25, 3) > 0, NULL);
+		check_output(pkg, "-0.25 3");
+	}
+
+	/* Width and precision arguments are packaged too */
+	if (!IS_ENABLED(CONFIG_CBPRINTF_NANO)) {
+		zassert_true(cbprintf_package(pkg, sizeof(pkg), "%*d|%-*.*s|",
+					      4, 7, 5, 2, "abc") > 0, NULL);
+		check_output(pkg, "   7|ab   |");
+	}
+}
+
+/**
+ * @brief Test transient strings in a package built at runtime
+ */
+static void test_cbprintf_package_runtime_strings(void)
+{
+	char buf[8] = "abc";
+	uint8_t pkg[64] __aligned(sizeof(uint32_t));
+	uint8_t copy[64] __aligned(sizeof(uint32_t));
+
+	zassert_true(cbprintf_package(pkg, sizeof(pkg), "%s %d %s",
+				      buf, 1, "def") > 0, NULL);
+	zassert_true(cbprintf_package_copy(pkg, copy, sizeof(copy)) > 0,
+		     NULL);
+
+	strcpy(buf, "xyz");
+	check_output(pkg, "xyz 1 def");
+	check_output(copy, "abc 1 def");
+
+	/* Transient strings are tracked on the stack, up to a limit */
+	zassert_equal(cbprintf_package(NULL, 0,
+				       "%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+				       buf, buf, buf, buf, buf, buf, buf, buf,
+				       buf, buf, buf, buf, buf, buf, buf, buf,
+				       buf),
+		      -EINVAL, NULL);
+}
+
+/**
+ * @brief Test a package built from C++
+ */
+static void test_cbprintf_package_cxx(void)
+{
+	uint8_t pkg[64] __aligned(sizeof(uint32_t));
+	uint8_t copy[64] __aligned(sizeof(uint32_t));
+	char buf[8] = "cxx";
+
+	if (!IS_ENABLED(CONFIG_CPLUSPLUS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	zassert_true(package_cxx(pkg, sizeof(pkg), buf) > 0, NULL);
+	zassert_true(cbprintf_package_copy(pkg, copy, sizeof(copy)) > 0, NULL);
+	strcpy(buf, "---");
+	check_output(copy, "-1 cxx 4294967296 c");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_cbprintf_package,
+			 ztest_unit_test(test_cbprintf_package_integers),
+			 ztest_unit_test(test_cbprintf_package_64bit),
+			 ztest_unit_test(test_cbprintf_package_fp),
+			 ztest_unit_test(test_cbprintf_package_strings),
+			 ztest_unit_test(test_cbprintf_package_runtime),
+			 ztest_unit_test(test_cbprintf_package_runtime_strings),
+			 ztest_unit_test(test_cbprintf_package_cxx));
+	ztest_run_test_suite(test_cbprintf_package);
+}
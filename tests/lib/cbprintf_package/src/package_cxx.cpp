@@ -0,0 +1,21 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/cbprintf.h>
+#include "package_cxx.h"
+
+int package_cxx(uint8_t *pkg, size_t len, char *str)
+{
+	char c = 'c';
+	size_t size = CBPRINTF_STATIC_PACKAGE_SIZE("%d %s %lld %c",
+						   -1, str, 1LL, c);
+
+	if (len < size) {
+		return -1;
+	}
+
+	CBPRINTF_STATIC_PACKAGE(pkg, "%d %s %lld %c", -1, str, 1LL << 32, c);
+
+	return (int)size;
+}
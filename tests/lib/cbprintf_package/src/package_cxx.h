@@ -0,0 +1,21 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PACKAGE_CXX_H_
+#define PACKAGE_CXX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int package_cxx(uint8_t *pkg, size_t len, char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PACKAGE_CXX_H_ */
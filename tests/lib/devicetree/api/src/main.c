@@ -1623,6 +1623,10 @@ static void test_dep_ord(void)
 		test_ord = DT_DEP_ORD(DT_PATH(test)),
 		root_requires[] = { DT_REQUIRES_DEP_ORDS(DT_ROOT) },
 		test_requires[] = { DT_REQUIRES_DEP_ORDS(DT_PATH(test)) },
+		children_requires[] = { DT_REQUIRES_DEP_ORDS(TEST_CHILDREN) },
+		children_requires_all[] = {
+			DT_REQUIRES_ALL_DEP_ORDS(TEST_CHILDREN)
+		},
 		root_supports[] = { DT_SUPPORTS_DEP_ORDS(DT_ROOT) },
 		test_supports[] = { DT_SUPPORTS_DEP_ORDS(DT_PATH(test)) },
 		children_ords[] = {
@@ -1653,6 +1657,14 @@ static void test_dep_ord(void)
 	zassert_true(ORD_IN_ARRAY(root_ord, test_requires),
 		     "/test depends on the root node");
 
+	/* DT_REQUIRES_ALL_DEP_ORDS */
+	zassert_false(ORD_IN_ARRAY(root_ord, children_requires),
+		      "/test/test-children depends on the root indirectly");
+	zassert_true(ORD_IN_ARRAY(root_ord, children_requires_all),
+		     "indirect dependencies are included");
+	zassert_true(ORD_IN_ARRAY(test_ord, children_requires_all),
+		     "direct dependencies are included");
+
 	/* DT_SUPPORTS_DEP_ORDS */
 	zassert_true(ORD_IN_ARRAY(test_ord, root_supports),
 		     "the root node supports /test");
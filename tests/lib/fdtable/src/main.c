@@ -172,6 +172,46 @@ void test_z_fd_multiple_access(void)
 	zassert_equal(errno, EBADF, "fd was found");
 }
 
+static int fds[CONFIG_POSIX_MAX_FDS +
+	       IF_ENABLED(CONFIG_POSIX_FDTABLE_GROW,
+			  (CONFIG_POSIX_FDTABLE_GROW_MAX)) + 1];
+
+void test_z_fd_exhaust(void)
+{
+	int fd_max = COND_CODE_1(CONFIG_POSIX_FDTABLE_GROW,
+				 (CONFIG_POSIX_FDTABLE_GROW_MAX),
+				 (CONFIG_POSIX_MAX_FDS));
+	int cnt = 0;
+	int fd;
+
+	while ((fd = z_reserve_fd()) >= 0) {
+		zassert_true(cnt < ARRAY_SIZE(fds), "too many fds");
+		zassert_true(fd < fd_max, "fd %d beyond the table limit", fd);
+		for (int i = 0; i < cnt; i++) {
+			zassert_not_equal(fds[i], fd, "fd allocated twice");
+		}
+		fds[cnt++] = fd;
+	}
+	zassert_equal(errno, ENFILE, "unexpected errno");
+
+	if (IS_ENABLED(CONFIG_POSIX_FDTABLE_GROW)) {
+		zassert_true(cnt > CONFIG_POSIX_MAX_FDS, "table did not grow");
+	}
+
+	/* A freed fd is reused */
+	z_free_fd(fds[cnt / 2]);
+	fd = z_reserve_fd();
+	zassert_equal(fd, fds[cnt / 2], "freed fd not reused");
+
+	for (int i = 0; i < cnt; i++) {
+		z_free_fd(fds[i]);
+	}
+
+	fd = z_reserve_fd();
+	zassert_true(fd >= 0, "fd < 0");
+	z_free_fd(fd);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_fdtable,
@@ -181,7 +221,8 @@ void test_main(void)
 			 ztest_unit_test(test_z_finalize_fd),
 			 ztest_unit_test(test_z_alloc_fd),
 			 ztest_unit_test(test_z_free_fd),
-			 ztest_unit_test(test_z_fd_multiple_access)
+			 ztest_unit_test(test_z_fd_multiple_access),
+			 ztest_unit_test(test_z_fd_exhaust)
 		);
 	ztest_run_test_suite(test_fdtable);
 }
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/mpsc_pbuf.h>
+
+#define BUF_WLEN 16
+
+struct test_packet {
+	union mpsc_pbuf_generic hdr;
+	uint32_t data[];
+};
+
+static uint32_t storage[BUF_WLEN];
+static struct mpsc_pbuf_buffer buffer;
+static uint32_t drops;
+static uint32_t dropped_data;
+
+static void drop_cb(const struct mpsc_pbuf_buffer *buf,
+		    const union mpsc_pbuf_generic *item)
+{
+	const struct test_packet *packet = (const struct test_packet *)item;
+
+	drops++;
+	dropped_data = packet->data[0];
+}
+
+static void init(uint32_t flags)
+{
+	struct mpsc_pbuf_buffer_config config = {
+		.buf = storage,
+		.size = BUF_WLEN,
+		.notify_drop = drop_cb,
+		.flags = flags
+	};
+
+	drops = 0;
+	mpsc_pbuf_init(&buffer, &config);
+}
+
+static struct test_packet *put(uint32_t wlen, uint32_t data)
+{
+	struct test_packet *packet;
+
+	packet = (struct test_packet *)mpsc_pbuf_alloc(&buffer, wlen);
+	if (packet != NULL) {
+		packet->data[0] = data;
+		mpsc_pbuf_commit(&buffer, &packet->hdr);
+	}
+
+	return packet;
+}
+
+static void get(uint32_t exp_wlen, uint32_t exp_data)
+{
+	const struct test_packet *packet;
+
+	packet = (const struct test_packet *)mpsc_pbuf_claim(&buffer);
+	zassert_not_null(packet, "Expected packet %u", exp_data);
+	zassert_equal(packet->hdr.hdr.len, exp_wlen, NULL);
+	zassert_equal(packet->data[0], exp_data, NULL);
+	mpsc_pbuf_free(&buffer, &packet->hdr);
+}
+
+/**
+ * @brief Test packets are returned in order
+ */
+static void test_mpsc_pbuf_alloc_claim(void)
+{
+	uint32_t size, now, max;
+
+	init(0);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), NULL);
+	zassert_is_null(mpsc_pbuf_claim(&buffer), NULL);
+	zassert_is_null(mpsc_pbuf_alloc(&buffer, 0), NULL);
+	zassert_is_null(mpsc_pbuf_alloc(&buffer, BUF_WLEN), NULL);
+
+	zassert_not_null(put(2, 1), NULL);
+	zassert_not_null(put(3, 2), NULL);
+	zassert_true(mpsc_pbuf_is_pending(&buffer), NULL);
+
+	mpsc_pbuf_get_utilization(&buffer, &size, &now, &max);
+	zassert_equal(size, (BUF_WLEN - 1) * sizeof(uint32_t), NULL);
+	zassert_equal(now, 5 * sizeof(uint32_t), NULL);
+
+	get(2, 1);
+	get(3, 2);
+	zassert_false(mpsc_pbuf_is_pending(&buffer), NULL);
+
+	mpsc_pbuf_get_utilization(&buffer, &size, &now, &max);
+	zassert_equal(now, 0, NULL);
+	zassert_equal(max, 5 * sizeof(uint32_t), NULL);
+}
+
+/**
+ * @brief Test a packet which does not fit before the end is padded
+ */
+static void test_mpsc_pbuf_wrap(void)
+{
+	init(0);
+
+	/* Leave one packet in so that indexes are not reset */
+	zassert_not_null(put(6, 1), NULL);
+	zassert_not_null(put(6, 2), NULL);
+	get(6, 1);
+
+	/* 4 words left before the end, packet goes to the beginning */
+	zassert_not_null(put(5, 3), NULL);
+	zassert_is_null(put(2, 4), "Buffer should be full");
+
+	get(6, 2);
+	get(5, 3);
+	zassert_is_null(mpsc_pbuf_claim(&buffer), NULL);
+	zassert_false(mpsc_pbuf_is_pending(&buffer), NULL);
+}
+
+/**
+ * @brief Test an uncommitted packet holds back later ones
+ */
+static void test_mpsc_pbuf_uncommitted(void)
+{
+	union mpsc_pbuf_generic *item;
+
+	init(0);
+
+	item = mpsc_pbuf_alloc(&buffer, 2);
+	zassert_not_null(item, NULL);
+	zassert_not_null(put(2, 2), NULL);
+
+	zassert_is_null(mpsc_pbuf_claim(&buffer), NULL);
+	zassert_true(mpsc_pbuf_is_pending(&buffer), NULL);
+
+	((struct test_packet *)item)->data[0] = 1;
+	mpsc_pbuf_commit(&buffer, item);
+	get(2, 1);
+	get(2, 2);
+}
+
+/**
+ * @brief Test oldest packets are dropped in overwrite mode
+ */
+static void test_mpsc_pbuf_overwrite(void)
+{
+	const struct test_packet *packet;
+
+	init(MPSC_PBUF_MODE_OVERWRITE);
+
+	for (uint32_t i = 0; i < 5; i++) {
+		zassert_not_null(put(3, i), NULL);
+	}
+	zassert_equal(drops, 0, NULL);
+
+	/* One word left before the end, which is padding, so two go */
+	zassert_not_null(put(3, 5), NULL);
+	zassert_equal(drops, 2, NULL);
+	zassert_equal(dropped_data, 1, NULL);
+
+	/* A claimed packet is never dropped */
+	packet = (const struct test_packet *)mpsc_pbuf_claim(&buffer);
+	zassert_equal(packet->data[0], 2, NULL);
+	zassert_is_null(put(BUF_WLEN - 1, 6), NULL);
+	mpsc_pbuf_free(&buffer, &packet->hdr);
+
+	zassert_not_null(put(BUF_WLEN - 1, 7), NULL);
+	zassert_equal(drops, 5, NULL);
+	get(BUF_WLEN - 1, 7);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_mpsc_pbuf,
+			 ztest_unit_test(test_mpsc_pbuf_alloc_claim),
+			 ztest_unit_test(test_mpsc_pbuf_wrap),
+			 ztest_unit_test(test_mpsc_pbuf_uncommitted),
+			 ztest_unit_test(test_mpsc_pbuf_overwrite));
+	ztest_run_test_suite(test_mpsc_pbuf);
+}
@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/ring_buffer.h>
+
+#define BUF_SIZE 256
+#define STRESS_BYTES (1024 * 1024)
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+SPSC_RING_BUF_DECLARE(spsc, BUF_SIZE);
+
+static K_THREAD_STACK_DEFINE(prod_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(cons_stack, STACK_SIZE);
+static struct k_thread prod_thread;
+static struct k_thread cons_thread;
+static volatile bool cons_error;
+
+static uint8_t pattern(uint32_t i)
+{
+	return (uint8_t)(i ^ (i >> 8) ^ (i >> 16));
+}
+
+static void reset(uint32_t idx)
+{
+	spsc_ring_buf_init(&spsc, BUF_SIZE, spsc.data);
+	spsc.prod.wr_idx = idx;
+	spsc.prod.tmp_wr_idx = idx;
+	spsc.prod.rd_idx = idx;
+	spsc.cons.rd_idx = idx;
+	spsc.cons.tmp_rd_idx = idx;
+	spsc.cons.wr_idx = idx;
+}
+
+void test_spsc_put_get(void)
+{
+	uint8_t in[BUF_SIZE + 1];
+	uint8_t out[BUF_SIZE + 1];
+	uint32_t len;
+
+	for (int i = 0; i < sizeof(in); i++) {
+		in[i] = pattern(i);
+	}
+
+	reset(0);
+	zassert_equal(spsc_ring_buf_capacity_get(&spsc), BUF_SIZE, NULL);
+	zassert_equal(spsc_ring_buf_space_get(&spsc), BUF_SIZE, NULL);
+	zassert_equal(spsc_ring_buf_size_get(&spsc), 0, NULL);
+
+	len = spsc_ring_buf_put(&spsc, in, sizeof(in));
+	zassert_equal(len, BUF_SIZE, "buffer overfilled");
+	zassert_equal(spsc_ring_buf_space_get(&spsc), 0, NULL);
+	zassert_equal(spsc_ring_buf_size_get(&spsc), BUF_SIZE, NULL);
+
+	len = spsc_ring_buf_get(&spsc, out, sizeof(out));
+	zassert_equal(len, BUF_SIZE, NULL);
+	zassert_mem_equal(in, out, BUF_SIZE, NULL);
+	zassert_equal(spsc_ring_buf_get(&spsc, out, 1), 0, NULL);
+}
+
+void test_spsc_claim_finish(void)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	reset(0);
+
+	/* Two claims, only the first one published */
+	len = spsc_ring_buf_put_claim(&spsc, &data, 10);
+	zassert_equal(len, 10, NULL);
+	memset(data, 0xaa, len);
+	len = spsc_ring_buf_put_claim(&spsc, &data, 10);
+	zassert_equal(len, 10, NULL);
+	zassert_equal(spsc_ring_buf_put_finish(&spsc, 21), -EINVAL, NULL);
+	zassert_equal(spsc_ring_buf_put_finish(&spsc, 10), 0, NULL);
+	zassert_equal(spsc_ring_buf_size_get(&spsc), 10, NULL);
+
+	/* The unpublished claim was released */
+	len = spsc_ring_buf_put_claim(&spsc, &data, BUF_SIZE);
+	zassert_equal(len, BUF_SIZE - 10, NULL);
+	zassert_equal(spsc_ring_buf_put_finish(&spsc, 0), 0, NULL);
+
+	len = spsc_ring_buf_get_claim(&spsc, &data, BUF_SIZE);
+	zassert_equal(len, 10, NULL);
+	zassert_equal(data[9], 0xaa, NULL);
+	zassert_equal(spsc_ring_buf_get_finish(&spsc, 11), -EINVAL, NULL);
+	zassert_equal(spsc_ring_buf_get_finish(&spsc, 4), 0, NULL);
+	zassert_equal(spsc_ring_buf_size_get(&spsc), 6, NULL);
+	zassert_equal(spsc_ring_buf_space_get(&spsc), BUF_SIZE - 6, NULL);
+}
+
+void test_spsc_wrap(void)
+{
+	uint8_t in[BUF_SIZE];
+	uint8_t out[BUF_SIZE];
+	uint8_t *data;
+	uint32_t len;
+
+	for (int i = 0; i < sizeof(in); i++) {
+		in[i] = pattern(i);
+	}
+
+	/* Index wrapping at 2^32 as well as the end of the buffer */
+	reset(UINT32_MAX - 100);
+
+	len = spsc_ring_buf_put_claim(&spsc, &data, BUF_SIZE);
+	zassert_equal(len, 101, "claim crosses the end of the buffer");
+	zassert_equal(spsc_ring_buf_put_finish(&spsc, 0), 0, NULL);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(spsc_ring_buf_put(&spsc, in, 200), 200, NULL);
+		zassert_equal(spsc_ring_buf_get(&spsc, out, 200), 200, NULL);
+		zassert_mem_equal(in, out, 200, NULL);
+	}
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t i = 0;
+	uint32_t chunk = 1;
+	uint8_t *data;
+	uint32_t len;
+
+	while (i < STRESS_BYTES && !cons_error) {
+		len = spsc_ring_buf_put_claim(&spsc, &data,
+					      MIN(chunk, STRESS_BYTES - i));
+		if (len == 0) {
+			k_yield();
+			continue;
+		}
+
+		for (uint32_t j = 0; j < len; j++) {
+			data[j] = pattern(i + j);
+		}
+
+		(void)spsc_ring_buf_put_finish(&spsc, len);
+		i += len;
+		chunk = 1 + (chunk * 5 + 3) % (BUF_SIZE / 2);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t i = 0;
+	uint32_t chunk = 7;
+	uint8_t *data;
+	uint32_t len;
+
+	while (i < STRESS_BYTES) {
+		len = spsc_ring_buf_get_claim(&spsc, &data, chunk);
+		if (len == 0) {
+			k_yield();
+			continue;
+		}
+
+		for (uint32_t j = 0; j < len; j++) {
+			if (data[j] != pattern(i + j)) {
+				cons_error = true;
+				return;
+			}
+		}
+
+		(void)spsc_ring_buf_get_finish(&spsc, len);
+		i += len;
+		chunk = 1 + (chunk * 3 + 1) % (BUF_SIZE / 2);
+	}
+}
+
+/* Producer and consumer run concurrently, on different CPUs with SMP */
+void test_spsc_stress(void)
+{
+	reset(UINT32_MAX - BUF_SIZE * 4);
+	cons_error = false;
+
+	k_thread_create(&cons_thread, cons_stack, STACK_SIZE, consumer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_create(&prod_thread, prod_stack, STACK_SIZE, producer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	k_thread_join(&prod_thread, K_FOREVER);
+	k_thread_join(&cons_thread, K_FOREVER);
+
+	zassert_false(cons_error, "consumer read corrupted data");
+	zassert_equal(spsc_ring_buf_size_get(&spsc), 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_ringbuffer_spsc,
+			 ztest_unit_test(test_spsc_put_get),
+			 ztest_unit_test(test_spsc_claim_finish),
+			 ztest_unit_test(test_spsc_wrap),
+			 ztest_unit_test(test_spsc_stress)
+			 );
+	ztest_run_test_suite(test_ringbuffer_spsc);
+}
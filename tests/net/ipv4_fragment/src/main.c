@@ -0,0 +1,447 @@
+/* main.c - Application main entry point */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <sys/printk.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/socket.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "icmpv4.h"
+#include "net_stats.h"
+
+/* Test interface addresses, the peer does not exist */
+static struct in_addr my_addr = { { { 198, 51, 100, 1 } } };
+static struct in_addr peer_addr = { { { 198, 51, 100, 2 } } };
+
+/* Loopback interface addresses, the loopback driver swaps them */
+static struct in_addr lo_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr lo_peer_addr = { { { 192, 0, 2, 2 } } };
+
+#define PORT 4242
+
+/* Sent as three fragments over an interface of NET_IPV4_MTU */
+#define DATA_LEN 1400
+#define FRAG_COUNT 3
+
+/* Sent as six fragments over the loopback */
+#define LOOP_DATA_LEN 3000
+
+#define WAIT_TIME K_SECONDS(1)
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+static struct net_if *test_iface;
+static struct net_if *lo_iface;
+
+/* Packets sent by the test interface */
+static K_FIFO_DEFINE(sent_fifo);
+
+static struct net_pkt *frags[FRAG_COUNT];
+static uint8_t data[LOOP_DATA_LEN];
+static uint8_t recv_buf[LOOP_DATA_LEN];
+static int sock = -1;
+
+struct net_if_test {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	struct net_if_test *dev_data = net_if_get_device(iface)->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	memcpy(dev_data->mac_addr, "\x00\x00\x5e\x00\x53\x01",
+	       sizeof(dev_data->mac_addr));
+
+	net_if_set_link_addr(iface, dev_data->mac_addr,
+			     sizeof(dev_data->mac_addr), NET_LINK_ETHERNET);
+	net_if_set_mtu(iface, NET_IPV4_MTU);
+
+	test_iface = iface;
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	if (!pkt->buffer) {
+		NET_DBG("No data to send!");
+		return -ENODATA;
+	}
+
+	/* Checked by the test cases, the L2 releases its own reference */
+	k_fifo_put(&sent_fifo, net_pkt_ref(pkt));
+
+	return 0;
+}
+
+struct net_if_test net_iface_data;
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT(net_ipv4_frag_test, "net_ipv4_frag_test",
+		net_iface_dev_init, device_pm_control_nop,
+		&net_iface_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, _ETH_L2_LAYER, _ETH_L2_CTX_TYPE,
+		NET_IPV4_MTU);
+
+static void pending_cb(struct net_ipv4_reassembly *reass, void *user_data)
+{
+	int *count = user_data;
+
+	(*count)++;
+}
+
+static int pending_reassemblies(void)
+{
+	int count = 0;
+
+	net_ipv4_frag_foreach(pending_cb, &count);
+
+	return count;
+}
+
+static void flush_sent(void)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = k_fifo_get(&sent_fifo, K_NO_WAIT))) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static int udp_socket(struct in_addr *addr)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	int fd;
+
+	net_ipaddr_copy(&local.sin_addr, addr);
+
+	fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(fd >= 0, "socket failed (%d)", errno);
+
+	zassert_equal(zsock_bind(fd, (struct sockaddr *)&local,
+				 sizeof(local)), 0,
+		      "bind failed (%d)", errno);
+
+	return fd;
+}
+
+static void send_to(int fd, struct in_addr *addr, size_t len)
+{
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	ssize_t ret;
+
+	net_ipaddr_copy(&remote.sin_addr, addr);
+
+	ret = zsock_sendto(fd, data, len, 0, (struct sockaddr *)&remote,
+			   sizeof(remote));
+	zassert_equal(ret, len, "sendto failed (%d)", errno);
+}
+
+static void recv_from(int fd, struct in_addr *addr, size_t len)
+{
+	struct zsock_pollfd pfd = { .fd = fd, .events = ZSOCK_POLLIN };
+	struct sockaddr_in remote;
+	socklen_t addrlen = sizeof(remote);
+	ssize_t ret;
+
+	zassert_equal(zsock_poll(&pfd, 1, MSEC_PER_SEC), 1,
+		      "datagram not received");
+
+	memset(recv_buf, 0, sizeof(recv_buf));
+
+	ret = zsock_recvfrom(fd, recv_buf, sizeof(recv_buf), 0,
+			     (struct sockaddr *)&remote, &addrlen);
+	zassert_equal(ret, len, "recvfrom returned %d (%d)", ret, errno);
+	zassert_mem_equal(recv_buf, data, len, "Invalid data");
+	zassert_true(net_ipv4_addr_cmp(&remote.sin_addr, addr),
+		     "Invalid sender");
+}
+
+static struct net_pkt *frag_create(uint16_t id, uint16_t offset, bool more,
+				   uint16_t len)
+{
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, len, AF_INET, 0,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	zassert_equal(net_ipv4_create(pkt, &peer_addr, &my_addr), 0,
+		      "IPv4 header create failed");
+	zassert_equal(net_pkt_memset(pkt, 0, len), 0, "payload failed");
+
+	hdr = NET_IPV4_HDR(pkt);
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->proto = IPPROTO_UDP;
+	sys_put_be16(id, hdr->id);
+	sys_put_be16((offset / 8U) | (more ? NET_IPV4_MORE_FRAG_MASK : 0),
+		     hdr->offset);
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	return pkt;
+}
+
+static void frag_recv(struct net_pkt *pkt)
+{
+	zassert_equal(net_recv_data(test_iface, pkt), 0, "recv failed");
+
+	/* Let the RX thread process it */
+	k_sleep(K_MSEC(50));
+}
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	zassert_not_null(test_iface, "Test interface");
+
+	for (i = 1; net_if_get_by_index(i); i++) {
+		if (net_if_get_by_index(i) != test_iface) {
+			lo_iface = net_if_get_by_index(i);
+		}
+	}
+
+	zassert_not_null(lo_iface, "Loopback interface");
+
+	ifaddr = net_if_ipv4_addr_add(test_iface, &my_addr, NET_ADDR_MANUAL,
+				      0);
+	zassert_not_null(ifaddr, "my_addr");
+
+	ifaddr = net_if_ipv4_addr_add(lo_iface, &lo_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "lo_addr");
+
+	net_if_set_mtu(lo_iface, NET_IPV4_MTU);
+
+	net_if_up(test_iface);
+	net_if_up(lo_iface);
+
+	flush_sent();
+}
+
+static void test_send_fragments(void)
+{
+	uint32_t sent = net_stats.ipv4_frag.sent;
+	struct net_ipv4_hdr *hdr;
+	uint16_t offset = 0U;
+	uint16_t flag;
+	size_t len;
+	int i;
+
+	sock = udp_socket(&my_addr);
+
+	send_to(sock, &peer_addr, DATA_LEN);
+
+	for (i = 0; i < FRAG_COUNT; i++) {
+		frags[i] = k_fifo_get(&sent_fifo, WAIT_TIME);
+		zassert_not_null(frags[i], "fragment %d not sent", i);
+
+		hdr = NET_IPV4_HDR(frags[i]);
+		len = net_pkt_get_len(frags[i]);
+		flag = sys_get_be16(hdr->offset);
+
+		zassert_true(len <= NET_IPV4_MTU, "fragment %d too big", i);
+		zassert_equal(ntohs(hdr->len), len, "fragment %d length", i);
+		zassert_equal(net_calc_chksum_ipv4(frags[i]), 0,
+			      "fragment %d checksum", i);
+		zassert_equal(sys_get_be16(hdr->id),
+			      sys_get_be16(NET_IPV4_HDR(frags[0])->id),
+			      "fragment %d id", i);
+		zassert_equal((flag & NET_IPV4_FRAG_OFFSET_MASK) * 8U, offset,
+			      "fragment %d offset", i);
+		zassert_equal(!!(flag & NET_IPV4_MORE_FRAG_MASK),
+			      i < FRAG_COUNT - 1, "fragment %d MF flag", i);
+
+		offset += len - sizeof(struct net_ipv4_hdr);
+	}
+
+	zassert_equal(offset, DATA_LEN + sizeof(struct net_udp_hdr),
+		      "Invalid datagram length");
+	zassert_is_null(k_fifo_get(&sent_fifo, K_MSEC(100)),
+			"Too many fragments");
+	zassert_equal(net_stats.ipv4_frag.sent - sent, FRAG_COUNT,
+		      "Invalid fragment statistics");
+}
+
+static void test_recv_reassembly(void)
+{
+	uint32_t reassembled = net_stats.ipv4_frag.reassembled;
+	struct net_ipv4_hdr *hdr;
+	struct in_addr addr;
+	int i;
+
+	/* Receive the fragments sent in the previous test in reverse
+	 * order, from the peer.
+	 */
+	for (i = FRAG_COUNT - 1; i >= 0; i--) {
+		hdr = NET_IPV4_HDR(frags[i]);
+
+		net_ipaddr_copy(&addr, &hdr->src);
+		net_ipaddr_copy(&hdr->src, &hdr->dst);
+		net_ipaddr_copy(&hdr->dst, &addr);
+
+		zassert_equal(net_recv_data(test_iface, frags[i]), 0,
+			      "recv failed");
+		frags[i] = NULL;
+	}
+
+	recv_from(sock, &peer_addr, DATA_LEN);
+
+	zassert_equal(net_stats.ipv4_frag.reassembled - reassembled, 1,
+		      "Invalid reassembly statistics");
+	zassert_equal(pending_reassemblies(), 0, "Reassembly pending");
+
+	zsock_close(sock);
+}
+
+static void test_dont_fragment(void)
+{
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, DATA_LEN, AF_INET,
+					IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	zassert_equal(net_ipv4_create(pkt, &my_addr, &peer_addr), 0,
+		      "IPv4 header create failed");
+	zassert_equal(net_pkt_memset(pkt, 0, DATA_LEN), 0, "payload failed");
+
+	hdr = NET_IPV4_HDR(pkt);
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->proto = IPPROTO_UDP;
+	sys_put_be16(NET_IPV4_DO_NOT_FRAG_MASK, hdr->offset);
+
+	zassert_true(net_send_data(pkt) < 0, "Datagram with DF sent");
+	net_pkt_unref(pkt);
+
+	zassert_is_null(k_fifo_get(&sent_fifo, K_MSEC(100)),
+			"Datagram with DF fragmented");
+}
+
+static void test_recv_overlap(void)
+{
+	uint32_t drop = net_stats.ipv4_frag.drop;
+
+	frag_recv(frag_create(0x100, 0, true, 16));
+	zassert_equal(pending_reassemblies(), 1, "Reassembly not pending");
+
+	/* Overlapping fragments drop the whole datagram */
+	frag_recv(frag_create(0x100, 8, true, 16));
+	zassert_equal(pending_reassemblies(), 0, "Reassembly pending");
+	zassert_equal(net_stats.ipv4_frag.drop - drop, 2,
+		      "Invalid drop statistics");
+}
+
+static void test_recv_timeout(void)
+{
+	uint32_t drop = net_stats.ipv4_frag.drop;
+	struct net_icmp_hdr *icmp;
+	struct net_pkt *pkt;
+
+	frag_recv(frag_create(0x200, 0, true, 16));
+
+	/* A duplicate is dropped alone */
+	frag_recv(frag_create(0x200, 0, true, 16));
+	zassert_equal(pending_reassemblies(), 1, "Reassembly not pending");
+	zassert_equal(net_stats.ipv4_frag.drop - drop, 1,
+		      "Invalid drop statistics");
+
+	k_sleep(K_MSEC(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT * MSEC_PER_SEC + 200));
+
+	zassert_equal(pending_reassemblies(), 0, "Reassembly pending");
+	zassert_equal(net_stats.ipv4_frag.drop - drop, 2,
+		      "Invalid drop statistics");
+
+	/* The first fragment was received, so the peer is told */
+	pkt = k_fifo_get(&sent_fifo, WAIT_TIME);
+	zassert_not_null(pkt, "ICMP error not sent");
+	zassert_equal(NET_IPV4_HDR(pkt)->proto, IPPROTO_ICMP, "Not ICMP");
+
+	icmp = (struct net_icmp_hdr *)(pkt->buffer->data +
+				       sizeof(struct net_ipv4_hdr));
+	zassert_equal(icmp->type, NET_ICMPV4_TIME_EXCEEDED, "ICMP type");
+	zassert_equal(icmp->code, NET_ICMPV4_TIME_EXCEEDED_REASM,
+		      "ICMP code");
+
+	net_pkt_unref(pkt);
+}
+
+static void test_loopback(void)
+{
+	uint32_t reassembled = net_stats.ipv4_frag.reassembled;
+	uint32_t sent = net_stats.ipv4_frag.sent;
+	int fd;
+
+	fd = udp_socket(&lo_addr);
+
+	/* The loopback driver turns the fragments around */
+	send_to(fd, &lo_peer_addr, LOOP_DATA_LEN);
+	recv_from(fd, &lo_peer_addr, LOOP_DATA_LEN);
+
+	zassert_equal(net_stats.ipv4_frag.sent - sent, 6,
+		      "Invalid fragment statistics");
+	zassert_equal(net_stats.ipv4_frag.reassembled - reassembled, 1,
+		      "Invalid reassembly statistics");
+
+	zsock_close(fd);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_send_fragments),
+			 ztest_unit_test(test_recv_reassembly),
+			 ztest_unit_test(test_dont_fragment),
+			 ztest_unit_test(test_recv_overlap),
+			 ztest_unit_test(test_recv_timeout),
+			 ztest_unit_test(test_loopback)
+			 );
+
+	ztest_run_test_suite(net_ipv4_fragment_test);
+}
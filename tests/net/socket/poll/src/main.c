@@ -175,10 +175,92 @@ void test_poll(void)
 	zassert_equal(res, 0, "close failed");
 }
 
+void test_poll_set(void)
+{
+	int res;
+	int c_sock;
+	int s_sock;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct zsock_poll_set pset;
+	struct zsock_poll_set_entry entries[3];
+	struct zsock_poll_set_entry *ready[3];
+	uint32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	zsock_poll_set_init(&pset);
+	res = zsock_poll_set_add(&pset, &entries[0], c_sock, POLLIN, NULL);
+	zassert_equal(res, 0, "");
+	res = zsock_poll_set_add(&pset, &entries[1], s_sock, POLLIN, &s_sock);
+	zassert_equal(res, 0, "");
+	res = zsock_poll_set_add(&pset, &entries[2], -1, POLLIN, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EBADF, "");
+
+	/* Wait on non-ready sockets */
+	res = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+	zassert_equal(res, 0, "");
+
+	tstamp = k_uptime_get_32();
+	res = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	/* Send pkt for s_sock, reported until received */
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	for (int i = 0; i < 2; i++) {
+		res = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 30);
+		zassert_equal(res, 1, "");
+		zassert_equal_ptr(ready[0], &entries[1], "");
+		zassert_equal_ptr(ready[0]->user_data, &s_sock, "");
+		zassert_equal(ready[0]->revents, POLLIN, "");
+	}
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 0);
+	zassert_equal(res, 0, "");
+
+	/* Sockets polled for POLLOUT are always ready */
+	res = zsock_poll_set_add(&pset, &entries[2], c_sock, POLLOUT, NULL);
+	zassert_equal(res, 0, "");
+	res = zsock_poll_set_wait(&pset, ready, ARRAY_SIZE(ready), 200);
+	zassert_equal(res, 1, "");
+	zassert_equal_ptr(ready[0], &entries[2], "");
+	zassert_equal(ready[0]->revents, POLLOUT, "");
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		zsock_poll_set_remove(&pset, &entries[i]);
+	}
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_poll,
-			 ztest_unit_test(test_poll));
+			 ztest_unit_test(test_poll),
+			 ztest_unit_test(test_poll_set));
 
 	ztest_run_test_suite(socket_poll);
 }
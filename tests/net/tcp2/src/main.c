@@ -95,6 +95,7 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th);
 static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
+static void handle_recovery_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -181,6 +182,19 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+#define TEST_MSS 100
+
+static uint8_t tcp_mss_option[4] = {
+	0x02, 0x04, 0x00, TEST_MSS /* Max segment */ };
+
+static uint8_t tcp_mss_sack_options[8] = {
+	0x02, 0x04, 0x00, TEST_MSS, /* Max segment */
+	0x01, 0x01, 0x04, 0x02 /* SACK permitted */ };
+
+/* SACK option sent in the segments of test case 10 */
+static uint8_t tcp_sack_option[20];
+static size_t tcp_sack_option_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port, uint16_t dst_port,
 					      uint8_t flags, uint8_t *data,
@@ -189,11 +203,23 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if ((test_case_no == 9U || test_case_no == 11U) &&
+		   (flags & SYN)) {
+		opts = tcp_mss_option;
+		opts_len = sizeof(tcp_mss_option);
+	} else if ((test_case_no == 10U) && (flags & SYN)) {
+		opts = tcp_mss_sack_options;
+		opts_len = sizeof(tcp_mss_sack_options);
+	} else if ((test_case_no == 10U) && tcp_sack_option_len) {
+		opts = tcp_sack_option;
+		opts_len = tcp_sack_option_len;
 	}
 
 	/* Allocate buffer */
@@ -228,14 +254,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
+	th->th_off = 5U + opts_len / 4U;
+	th->th_flags = flags;
+
+	/* Congestion control tests need a window of several segments */
+	if (test_case_no >= 9U && test_case_no <= 11U) {
+		th->th_win = htons(NET_IPV6_MTU);
 	} else {
-		th->th_off = 5U;
+		th->th_win = NET_IPV6_MTU;
 	}
 
-	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -247,9 +275,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -382,6 +410,11 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 8:
 		handle_client_closing_test(net_pkt_family(pkt), &th);
 		break;
+	case 9:
+	case 10:
+	case 11:
+		handle_recovery_test(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1172,6 +1205,568 @@ static void test_client_closing_ipv6(void)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+static uint16_t fr_port;
+static uint32_t fr_seqs[16];
+static int fr_count;
+static uint32_t fr_ack;
+static int fr_psh;
+static uint8_t fr_ack_opts[40];
+static size_t fr_ack_opts_len;
+static size_t fr_data_opts_len;
+
+static void handle_recovery_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	sa_family_t af = net_pkt_family(pkt);
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		fr_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		seq++;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		/* Segments are acked by the test itself */
+		if (th->th_flags == ACK &&
+		    net_pkt_get_len(pkt) == net_pkt_ip_hdr_len(pkt) +
+		    net_pkt_ip_opts_len(pkt) + th->th_off * 4U) {
+			fr_ack = ntohl(th->th_ack);
+			fr_ack_opts_len = (th->th_off - 5U) * 4U;
+			net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+				     net_pkt_ip_opts_len(pkt) +
+				     sizeof(struct tcphdr));
+			net_pkt_read(pkt, fr_ack_opts, fr_ack_opts_len);
+			return;
+		}
+
+		/* Segments of a super-segment but the last have no PSH */
+		zassert_true(th->th_flags == ACK || th->th_flags == (PSH | ACK),
+			     "Unexpected flags 0x%02x", th->th_flags);
+		fr_psh += th->th_flags & PSH ? 1 : 0;
+		fr_data_opts_len = (th->th_off - 5U) * 4U;
+		if (fr_count < ARRAY_SIZE(fr_seqs)) {
+			fr_seqs[fr_count++] = ntohl(th->th_seq);
+		}
+		return;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+static void send_ack(uint32_t ack_value)
+{
+	int ret;
+
+	ack = ack_value;
+	ret = net_recv_data(iface, prepare_ack_packet(AF_INET, htons(MY_PORT),
+						      fr_port));
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(10);
+}
+
+static int fr_seq_count(uint32_t seq_value)
+{
+	int n = 0;
+
+	for (int i = 0; i < fr_count; i++) {
+		if (fr_seqs[i] == seq_value) {
+			n++;
+		}
+	}
+
+	return n;
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK with a small MSS,
+ *   send 5 segments of data,
+ *   expect the initial congestion window of 4 segments,
+ *   ACK the first one and expect the last one (slow start),
+ *   send 3 duplicate ACKs,
+ *   expect the second segment to be retransmitted,
+ *   send an ACK of the recovery point and expect recovery to end,
+ *   any failures cause test case to fail.
+ */
+static void test_client_fast_retransmit_ipv4(void)
+{
+	static uint8_t data[5 * TEST_MSS];
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 9;
+	seq = ack = 0;
+	fr_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	base = ack;
+
+	zassert_equal(conn->cwnd, 4 * TEST_MSS, "Unexpected initial window %u",
+		      conn->cwnd);
+
+	ret = net_context_send(ctx, data, sizeof(data), NULL, K_NO_WAIT, NULL);
+	if (ret != sizeof(data)) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	k_msleep(10);
+	zassert_equal(fr_count, 4, "Sent %d segments, expected 4", fr_count);
+
+	send_ack(base + TEST_MSS);
+	zassert_equal(fr_count, 5, "Sent %d segments, expected 5", fr_count);
+	zassert_equal(conn->cwnd, 5 * TEST_MSS, "cwnd %u", conn->cwnd);
+
+	send_ack(base + TEST_MSS);
+	send_ack(base + TEST_MSS);
+	zassert_false(conn->in_recovery, "Recovery entered too early");
+	zassert_equal(fr_seq_count(base + TEST_MSS), 1, "Early retransmit");
+
+	send_ack(base + TEST_MSS);
+	zassert_true(conn->in_recovery, "Recovery not entered");
+	zassert_equal(fr_seq_count(base + TEST_MSS), 2, "No fast retransmit");
+	zassert_equal(conn->cwnd, conn->ssthresh + 3 * TEST_MSS, "cwnd %u",
+		      conn->cwnd);
+
+	send_ack(base + sizeof(data));
+	zassert_false(conn->in_recovery, "Recovery not exited");
+	zassert_true(conn->cwnd <= conn->ssthresh, "cwnd %u", conn->cwnd);
+	zassert_equal(conn->send_data_total, 0, "Data left unacked");
+
+	t_state = T_FIN;
+	net_tcp_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK with a small MSS,
+ *   send 4 segments of data,
+ *   send 3 duplicate ACKs of the handshake, i.e. lose the first segment,
+ *   expect the first segment to be retransmitted,
+ *   send an ACK of the recovery point and expect recovery to end,
+ *   any failures cause test case to fail.
+ */
+static void test_client_first_segment_loss_ipv4(void)
+{
+	static uint8_t data[4 * TEST_MSS];
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 9;
+	seq = ack = 0;
+	fr_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	base = ack;
+
+	ret = net_context_send(ctx, data, sizeof(data), NULL, K_NO_WAIT, NULL);
+	if (ret != sizeof(data)) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	k_msleep(10);
+	zassert_equal(fr_count, 4, "Sent %d segments, expected 4", fr_count);
+
+	send_ack(base);
+	send_ack(base);
+	zassert_false(conn->in_recovery, "Recovery entered too early");
+	zassert_equal(fr_seq_count(base), 1, "Early retransmit");
+
+	send_ack(base);
+	zassert_true(conn->in_recovery, "Recovery not entered");
+	zassert_equal(fr_seq_count(base), 2, "No fast retransmit");
+
+	send_ack(base + sizeof(data));
+	zassert_false(conn->in_recovery, "Recovery not exited");
+	zassert_equal(conn->send_data_total, 0, "Data left unacked");
+
+	t_state = T_FIN;
+	net_tcp_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+static uint8_t ooo_recv_buf[40];
+static size_t ooo_recv_len;
+static int ooo_recv_count;
+
+static void ooo_recv_cb(struct net_context *context, struct net_pkt *pkt,
+			union net_ip_header *ip_hdr,
+			union net_proto_header *proto_hdr,
+			int status, void *user_data)
+{
+	size_t len;
+
+	if (!pkt) {
+		return;
+	}
+
+	len = MIN(net_pkt_remaining_data(pkt),
+		  sizeof(ooo_recv_buf) - ooo_recv_len);
+	net_pkt_read(pkt, ooo_recv_buf + ooo_recv_len, len);
+	ooo_recv_len += len;
+	ooo_recv_count++;
+
+	net_pkt_unref(pkt);
+}
+
+static void set_sack_option(int n, uint32_t *blocks)
+{
+	tcp_sack_option[0] = 0x01; /* NOP */
+	tcp_sack_option[1] = 0x01; /* NOP */
+	tcp_sack_option[2] = 0x05; /* SACK */
+	tcp_sack_option[3] = 2 + 8 * n;
+
+	for (int i = 0; i < 2 * n; i++) {
+		sys_put_be32(blocks[i], &tcp_sack_option[4 + 4 * i]);
+	}
+
+	tcp_sack_option_len = n ? 4 + 8 * n : 0;
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK with SACK permitted,
+ *   receive the second data segment before the first one,
+ *   expect a duplicate ACK reporting the second one with SACK,
+ *   send a full segment of data, expect it without SACK,
+ *   receive the first segment, expect both to be acked and delivered,
+ *   send 4 segments of data,
+ *   send duplicate ACKs reporting the second and last one with SACK,
+ *   expect the first and the third segment to be retransmitted,
+ *   any failures cause test case to fail.
+ */
+static void test_client_sack_ipv4(void)
+{
+	static uint8_t data[4 * TEST_MSS];
+	uint32_t blocks[4];
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	struct tcp *conn;
+	uint32_t base;
+	int rexmit;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 10;
+	seq = ack = 0;
+	fr_count = 0;
+	tcp_sack_option_len = 0;
+	ooo_recv_len = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	base = ack;
+
+	zassert_true(tcp_sack_ok(conn), "SACK not negotiated");
+
+	ret = net_context_recv(ctx, ooo_recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Failed to set recv callback");
+
+	/* The second segment arrives first */
+	seq += 10U;
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), fr_port,
+				  "0123456789", 10U);
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+	k_msleep(10);
+
+	zassert_equal(fr_ack, seq - 10U, "Unexpected ack %u", fr_ack);
+	zassert_equal(fr_ack_opts_len, 12, "No SACK option");
+	zassert_equal(sys_get_be32(&fr_ack_opts[4]), seq, "SACK block start");
+	zassert_equal(sys_get_be32(&fr_ack_opts[8]), seq + 10U,
+		      "SACK block end");
+	zassert_equal(ooo_recv_len, 0, "Out of order data delivered");
+
+	/* SACK blocks would make a full segment exceed the MSS */
+	seq -= 10U;
+	ret = net_context_send(ctx, data, TEST_MSS, NULL, K_NO_WAIT, NULL);
+	if (ret != TEST_MSS) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	k_msleep(10);
+	zassert_equal(fr_count, 1, "Sent %d segments, expected 1", fr_count);
+	zassert_equal(fr_data_opts_len, 0, "SACK option in a data segment");
+
+	send_ack(base + TEST_MSS);
+	base += TEST_MSS;
+	fr_count = 0;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), fr_port,
+				  "abcdefghij", 10U);
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+	k_msleep(10);
+
+	zassert_equal(fr_ack, seq + 20U, "Unexpected ack %u", fr_ack);
+	zassert_equal(fr_ack_opts_len, 0, "SACK option left");
+	zassert_equal(ooo_recv_len, 20, "Received %d bytes", ooo_recv_len);
+	zassert_mem_equal(ooo_recv_buf, "abcdefghij0123456789", 20,
+			  "Data received out of order");
+	seq += 20U;
+
+	/* The first and the third segment are lost */
+	ret = net_context_send(ctx, data, sizeof(data), NULL, K_NO_WAIT, NULL);
+	if (ret != sizeof(data)) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	k_msleep(10);
+	zassert_equal(fr_count, 4, "Sent %d segments, expected 4", fr_count);
+
+	rexmit = GET_STAT(iface, tcp.sackrexmit);
+
+	blocks[0] = base + TEST_MSS;
+	blocks[1] = base + 2 * TEST_MSS;
+	set_sack_option(1, blocks);
+	send_ack(base);
+
+	blocks[0] = base + 3 * TEST_MSS;
+	blocks[1] = base + 4 * TEST_MSS;
+	blocks[2] = base + TEST_MSS;
+	blocks[3] = base + 2 * TEST_MSS;
+	set_sack_option(2, blocks);
+	send_ack(base);
+	send_ack(base);
+
+	zassert_true(conn->in_recovery, "Recovery not entered");
+	zassert_equal(fr_seq_count(base), 2, "No fast retransmit");
+	zassert_equal(fr_seq_count(base + 2 * TEST_MSS), 1, "Early retransmit");
+
+	send_ack(base);
+	zassert_equal(fr_seq_count(base + 2 * TEST_MSS), 2,
+		      "Missing segment not retransmitted");
+	zassert_equal(GET_STAT(iface, tcp.sackrexmit), rexmit + 1,
+		      "SACK retransmission not counted");
+
+	/* Nothing else is missing */
+	send_ack(base);
+	zassert_equal(fr_count, 6, "Sent %d segments, expected 6", fr_count);
+
+	set_sack_option(0, NULL);
+	send_ack(base + sizeof(data));
+	zassert_false(conn->in_recovery, "Recovery not exited");
+	zassert_equal(conn->sacked_num, 0, "Scoreboard not cleared");
+
+	t_state = T_FIN;
+	net_tcp_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+#if defined(CONFIG_NET_TCP_GSO) && defined(CONFIG_NET_TCP_GRO)
+static void recv_segment(uint8_t flags, uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT), fr_port, flags,
+				     data, len);
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+	k_msleep(10);
+
+	seq += len;
+	zassert_equal(fr_ack, seq, "Unexpected ack %u", fr_ack);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK with a small MSS,
+ *   receive three data segments, only the last one with PSH,
+ *   expect them to be delivered as one packet,
+ *   receive a segment without PSH, expect it after the GRO timeout,
+ *   send 3 segments of data,
+ *   expect one super-segment split into 3 segments, the last with PSH,
+ *   any failures cause test case to fail.
+ */
+static void test_client_offload_ipv4(void)
+{
+	static uint8_t data[3 * TEST_MSS];
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 11;
+	seq = ack = 0;
+	fr_count = 0;
+	fr_psh = 0;
+	ooo_recv_len = 0;
+	ooo_recv_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	base = ack;
+
+	ret = net_context_recv(ctx, ooo_recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Failed to set recv callback");
+
+	recv_segment(ACK, "0123456789", 10U);
+	recv_segment(ACK, "abcdefghij", 10U);
+	zassert_equal(ooo_recv_count, 0, "Data delivered before PSH");
+
+	recv_segment(PSH | ACK, "ABCDEFGHIJ", 10U);
+	zassert_equal(ooo_recv_count, 1, "Received %d packets", ooo_recv_count);
+	zassert_equal(ooo_recv_len, 30, "Received %d bytes", ooo_recv_len);
+	zassert_mem_equal(ooo_recv_buf, "0123456789abcdefghijABCDEFGHIJ", 30,
+			  "Unexpected data");
+
+	recv_segment(ACK, "klmnopqrst", 10U);
+	zassert_equal(ooo_recv_count, 1, "Data delivered before timeout");
+	k_msleep(2 * CONFIG_NET_TCP_GRO_TIMEOUT);
+	zassert_equal(ooo_recv_count, 2, "Data not delivered after timeout");
+	zassert_mem_equal(ooo_recv_buf + 30, "klmnopqrst", 10,
+			  "Unexpected data");
+
+	ret = net_context_send(ctx, data, sizeof(data), NULL, K_NO_WAIT, NULL);
+	if (ret != sizeof(data)) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	k_msleep(10);
+	zassert_equal(fr_count, 3, "Sent %d segments, expected 3", fr_count);
+	zassert_equal(fr_psh, 1, "%d segments with PSH, expected 1", fr_psh);
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(fr_seqs[i], base + i * TEST_MSS,
+			      "Unexpected seq %u", fr_seqs[i]);
+	}
+
+	send_ack(base + sizeof(data));
+	zassert_equal(conn->send_data_total, 0, "Data left unacked");
+
+	t_state = T_FIN;
+	net_tcp_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#else
+static void test_client_offload_ipv4(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_GSO && CONFIG_NET_TCP_GRO */
+
 static struct net_context *create_server_socket(void)
 {
 	struct net_context *ctx;
@@ -1307,6 +1902,10 @@ void test_main(void)
 			 ztest_unit_test(test_client_syn_resend),
 			 ztest_unit_test(test_client_fin_wait_2_ipv4),
 			 ztest_unit_test(test_client_closing_ipv6),
+			 ztest_unit_test(test_client_fast_retransmit_ipv4),
+			 ztest_unit_test(test_client_first_segment_loss_ipv4),
+			 ztest_unit_test(test_client_sack_ipv4),
+			 ztest_unit_test(test_client_offload_ipv4),
 			 ztest_unit_test(test_client_invalid_rst)
 			 );
 
@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <debug/profiler.h>
+
+#define MIN_SAMPLES 20
+#define SPIN_CHUNK 100000
+#define MAX_CHUNKS 100000
+
+/* Upper bound on the size of busy_loop() */
+#define BUSY_LOOP_MAX_SIZE 256
+
+struct hist_ctx {
+	uint32_t entries;
+	uint32_t count;
+	uint32_t in_busy_loop;
+};
+
+static volatile uint32_t spin;
+
+static void __attribute__((noinline)) busy_loop(void)
+{
+	for (uint32_t i = 0; i < SPIN_CHUNK; i++) {
+		spin++;
+	}
+}
+
+static void hist_cb(const struct profiler_entry *entry, void *user_data)
+{
+	struct hist_ctx *ctx = user_data;
+	uintptr_t start = (uintptr_t)busy_loop;
+
+	ctx->entries++;
+	ctx->count += entry->count;
+
+	if ((entry->thread == k_current_get()) && (entry->pc >= start) &&
+	    (entry->pc < (start + BUSY_LOOP_MAX_SIZE))) {
+		ctx->in_busy_loop += entry->count;
+	}
+}
+
+/**
+ * @brief Test starting and stopping the profiler
+ */
+static void test_profiler_start_stop(void)
+{
+	zassert_equal(profiler_start(0), -EINVAL, NULL);
+	zassert_false(profiler_is_running(), NULL);
+
+	zassert_equal(profiler_start(1000), 0, NULL);
+	zassert_true(profiler_is_running(), NULL);
+	zassert_equal(profiler_start(1000), -EALREADY, NULL);
+
+	profiler_stop();
+	zassert_false(profiler_is_running(), NULL);
+	profiler_stop();
+}
+
+/**
+ * @brief Test samples land in the code which is running
+ */
+static void test_profiler_samples(void)
+{
+	struct profiler_stats stats;
+	struct hist_ctx ctx = { 0 };
+
+	profiler_reset();
+	zassert_equal(profiler_start(1000), 0, NULL);
+
+	for (int i = 0; i < MAX_CHUNKS; i++) {
+		busy_loop();
+		profiler_stats_get(&stats);
+		if (stats.samples >= MIN_SAMPLES) {
+			break;
+		}
+	}
+
+	profiler_stop();
+
+	profiler_foreach(hist_cb, &ctx);
+	profiler_stats_get(&stats);
+
+	zassert_true(stats.samples >= MIN_SAMPLES, "Only %u samples",
+		     stats.samples);
+	zassert_equal(ctx.count + stats.dropped + stats.overflow,
+		      stats.samples, NULL);
+	zassert_true(ctx.in_busy_loop > (ctx.count / 2),
+		     "%u of %u samples in busy loop", ctx.in_busy_loop,
+		     ctx.count);
+}
+
+/**
+ * @brief Test resetting the histogram
+ */
+static void test_profiler_reset(void)
+{
+	struct profiler_stats stats;
+	struct hist_ctx ctx = { 0 };
+
+	profiler_reset();
+	profiler_foreach(hist_cb, &ctx);
+	profiler_stats_get(&stats);
+
+	zassert_equal(ctx.entries, 0, NULL);
+	zassert_equal(stats.samples, 0, NULL);
+	zassert_equal(stats.dropped, 0, NULL);
+	zassert_equal(stats.overflow, 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(profiler,
+			 ztest_unit_test(test_profiler_start_stop),
+			 ztest_unit_test(test_profiler_samples),
+			 ztest_unit_test(test_profiler_reset));
+	ztest_run_test_suite(profiler);
+}
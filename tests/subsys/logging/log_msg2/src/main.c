@@ -0,0 +1,260 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test packaged log messages
+ */
+
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output.h>
+#include <ztest.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME, LOG_LEVEL_DBG);
+
+#define NUM_FLOOD_MSGS 20
+
+static char mock_buffer[1024];
+static uint32_t mock_len;
+static uint8_t log_output_buf[8];
+static uint32_t total_drops;
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	size = MIN(size, sizeof(mock_buffer) - 1 - mock_len);
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+static void put_msg2(const struct log_backend *const backend,
+		     const struct log_msg2 *msg)
+{
+	log_output_msg2_process(&log_output, msg, LOG_OUTPUT_FLAG_CRLF_LFONLY);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	total_drops += cnt;
+}
+
+static const struct log_backend_api log_backend_test_api = {
+	.put_msg2 = put_msg2,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+static void flush(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+static void setup(void)
+{
+	flush();
+	mock_len = 0U;
+	total_drops = 0U;
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+}
+
+static void teardown(void)
+{
+	flush();
+}
+
+static void validate_output(const char *exp)
+{
+	zassert_equal(strlen(exp), mock_len, "Unexpected output: \"%s\"",
+		      mock_buffer);
+	zassert_mem_equal(exp, mock_buffer, mock_len, "Unexpected output");
+}
+
+static void log_runtime(const char *fmt, ...)
+{
+	struct log_msg_ids src_level = {
+		.level = LOG_LEVEL_INF,
+		.domain_id = CONFIG_LOG_DOMAIN_ID,
+		.source_id = LOG_CURRENT_MODULE_ID()
+	};
+	va_list ap;
+
+	va_start(ap, fmt);
+	log_generic(src_level, fmt, ap, LOG_STRDUP_SKIP);
+	va_end(ap);
+}
+
+/**
+ * @brief Test integer arguments of all sizes
+ */
+static void test_log_msg2_integers(void)
+{
+	char c = 'x';
+	short s = -2;
+	long long ll = -5;
+	unsigned long long ull = 0x123456789abcULL;
+
+	LOG_INF("int %d %u %c %hd", -1, 2U, c, s);
+	LOG_INF("ll %lld %llx", ll, ull);
+	LOG_INF("no args");
+	flush();
+
+	validate_output("test: int -1 2 x -2\n"
+			"test: ll -5 123456789abc\n"
+			"test: no args\n");
+}
+
+/**
+ * @brief Test floating point arguments
+ */
+static void test_log_msg2_fp(void)
+{
+	if (!IS_ENABLED(CONFIG_CBPRINTF_FP_SUPPORT)) {
+		ztest_test_skip();
+	}
+
+	float f = 2.5f;
+
+	LOG_INF("fp %.1f %.2f %d", f, 0.25, 7);
+	flush();
+
+	validate_output("test: fp 2.5 0.25 7\n");
+}
+
+/**
+ * @brief Test that transient strings are copied into the message
+ */
+static void test_log_msg2_strings(void)
+{
+	char buf[16] = "first";
+	const char *cstr = "const";
+
+	LOG_INF("%s %d %s", buf, 1, cstr);
+	strcpy(buf, "second");
+	LOG_INF("%s", buf);
+	memset(buf, 0, sizeof(buf));
+	flush();
+
+	validate_output("test: first 1 const\n"
+			"test: second\n");
+}
+
+/**
+ * @brief Test hexdump data stored after the package
+ */
+static void test_log_msg2_hexdump(void)
+{
+	uint8_t data[] = { 0x01, 0x02, 0x41, 0x42 };
+
+	LOG_HEXDUMP_INF(data, sizeof(data), "data");
+	flush();
+
+	zassert_true(strncmp(mock_buffer, "test: data\n", 11) == 0,
+		     "Unexpected output: \"%s\"", mock_buffer);
+	zassert_not_null(strstr(mock_buffer, "01 02 41 42"), NULL);
+	zassert_not_null(strstr(mock_buffer, "|..AB"), NULL);
+}
+
+/**
+ * @brief Test messages formatted at runtime
+ */
+static void test_log_msg2_runtime(void)
+{
+	char buf[8] = "abc";
+
+	log_runtime("runtime %d %s", 3, buf);
+	buf[0] = '\0';
+	flush();
+
+	validate_output("test: runtime 3 abc\n");
+}
+
+/**
+ * @brief Test buffer full handling in both modes
+ */
+static void test_log_msg2_drop(void)
+{
+	uint32_t lines = 0;
+	char exp[16];
+
+	for (int i = 0; i < NUM_FLOOD_MSGS; i++) {
+		LOG_INF("%d", i);
+	}
+	flush();
+
+	for (int i = 0; i < mock_len; i++) {
+		lines += (mock_buffer[i] == '\n') ? 1 : 0;
+	}
+
+	zassert_true(lines > 0, NULL);
+	zassert_true(lines < NUM_FLOOD_MSGS, "No message dropped");
+	zassert_equal(total_drops, NUM_FLOOD_MSGS - lines, NULL);
+
+	/* Overflow mode keeps the newest messages, otherwise the oldest. */
+	snprintk(exp, sizeof(exp), "test: %d\n",
+		 IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
+		 NUM_FLOOD_MSGS - lines : 0);
+	zassert_true(strncmp(mock_buffer, exp, strlen(exp)) == 0,
+		     "Unexpected output: \"%s\"", mock_buffer);
+}
+
+/**
+ * @brief Test a message which is not committed yet holds back later ones
+ */
+static void test_log_msg2_uncommitted(void)
+{
+	struct log_msg_ids src_level = {
+		.level = LOG_LEVEL_INF,
+		.domain_id = CONFIG_LOG_DOMAIN_ID,
+		.source_id = LOG_CURRENT_MODULE_ID()
+	};
+	struct log_msg2 *msg;
+
+	msg = z_log_msg2_alloc(LOG_MSG2_WLEN(
+			CBPRINTF_STATIC_PACKAGE_SIZE("first"), 0));
+	zassert_not_null(msg, NULL);
+
+	LOG_INF("second");
+	zassert_false(log_process(false), "Uncommitted message claimed");
+	zassert_equal(mock_len, 0, NULL);
+
+	CBPRINTF_STATIC_PACKAGE(log_msg2_get_package(msg), "first");
+	msg->pkg_len = CBPRINTF_STATIC_PACKAGE_SIZE("first");
+	msg->data_len = 0;
+	z_log_msg2_commit(msg, src_level);
+	flush();
+
+	validate_output("test: first\ntest: second\n");
+}
+
+void test_main(void)
+{
+	log_init();
+	log_backend_enable(&backend, NULL, LOG_LEVEL_DBG);
+
+	ztest_test_suite(test_log_msg2,
+		ztest_unit_test_setup_teardown(test_log_msg2_integers,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_fp,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_strings,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_hexdump,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_runtime,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_drop,
+					       setup, teardown),
+		ztest_unit_test_setup_teardown(test_log_msg2_uncommitted,
+					       setup, teardown));
+	ztest_run_test_suite(test_log_msg2);
+}